@@ -1,6 +1,6 @@
 QT       += core gui
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 
 CONFIG += c++17
 
@@ -11,24 +11,70 @@ CONFIG += c++17
 SOURCES += \
     algorithmcanvas.cpp \
     avl.cpp \
+    batchqueries.cpp \
+    benchmark.cpp \
+    btree.cpp \
+    contractionhierarchy.cpp \
+    csrgraph.cpp \
+    dynamicrepair.cpp \
+    ellermaze.cpp \
+    forcelayout.cpp \
     graph.cpp \
+    graphanalytics.cpp \
+    graphgenerators.cpp \
+    graphkernels.cpp \
+    graphloader.cpp \
+    graphrecorder.cpp \
     main.cpp \
     mainwindow.cpp \
+    maxflow.cpp \
     maze.cpp \
+    rbtree.cpp \
+    search.cpp \
     sorting.cpp \
+    spatialindex.cpp \
+    splay.cpp \
+    threadpool.cpp \
     tree.cpp \
-    visualizercontroller.cpp
+    treap.cpp \
+    visualizercontroller.cpp \
+    workload.cpp
 
 HEADERS += \
     algorithmcanvas.h \
     avl.h \
+    batchqueries.h \
+    benchmark.h \
+    btree.h \
+    contractionhierarchy.h \
+    csrgraph.h \
+    daryheap.h \
     datastructures.h \
+    dynamicrepair.h \
+    ellermaze.h \
+    fastrng.h \
+    forcelayout.h \
     graph.h \
+    graphanalytics.h \
+    graphgenerators.h \
+    graphkernels.h \
+    graphloader.h \
+    graphrecorder.h \
     mainwindow.h \
+    maxflow.h \
     maze.h \
+    rbtree.h \
+    search.h \
     sorting.h \
+    spatialindex.h \
+    splay.h \
+    threadpool.h \
     tree.h \
-    visualizercontroller.h
+    treap.h \
+    treeview.h \
+    unionfind.h \
+    visualizercontroller.h \
+    workload.h
 
 FORMS += \
     mainwindow.ui
@@ -1,9 +1,42 @@
 #include "algorithmcanvas.h"
+#include <QHash>
+#include <QMouseEvent>
 #include <QPaintEvent>
 #include <QPainter>
-#include <QMap>
+#include <QWheelEvent>
 #include <algorithm>
-
+#include <cmath>
+
+const double NODE_RADIUS = 20.0;
+const int LAYOUT_INDEX_FRAMES = 10; // Force layout frames between rebuilds of the canvas index
+const double EDGE_WIDTH = 2.0;
+const double LABEL_MIN_RADIUS = 8.0; // On-screen node radius below which labels and weights are dropped
+const double POINT_MAX_RADIUS = 2.0; // On-screen node radius below which nodes are drawn as points
+const int ANTIALIAS_LIMIT = 20000;   // Visible nodes plus edges beyond which antialiasing is off
+const double MIN_ZOOM = 0.01;
+const double MAX_ZOOM = 50.0;
+const double WHEEL_ZOOM_BASE = 1.0015; // Zoom factor per eighth of a degree of wheel rotation
+
+// Maze image palette, indexed by CellType
+const QVector<QRgb> MAZE_COLORS = {
+    qRgb(0, 0, 0),       // WALL
+    qRgb(255, 255, 255), // PATH
+    qRgb(255, 0, 0),     // VISITED
+    qRgb(0, 200, 0),     // START_POINT
+    qRgb(0, 0, 255)      // END_POINT
+};
+
+// Color batches, the most common first: rarer colors mark what a step
+// highlights (paths, trees, frontiers) and should end up on top
+template <typename T>
+QList<QRgb> colorsByFrequency(const QHash<QRgb, QVector<T>>& batches)
+{
+    QList<QRgb> colors = batches.keys();
+    std::sort(colors.begin(), colors.end(), [&](QRgb a, QRgb b) {
+        return batches[a].size() > batches[b].size() || (batches[a].size() == batches[b].size() && a < b);
+    });
+    return colors;
+}
 
 AlgorithmCanvas::AlgorithmCanvas(QWidget *parent)
     : QWidget(parent)
@@ -19,6 +52,7 @@ void AlgorithmCanvas::drawStep(const QVariant& step)
 {
     // Store the step data
     m_currentStep = step;
+    m_treeIndexed = false;
     update();
 }
 
@@ -37,6 +71,9 @@ void AlgorithmCanvas::paintEvent(QPaintEvent* event)
     else if (m_currentStep.canConvert<MazeStep>()) {
         drawMazeStep(painter, m_currentStep.value<MazeStep>());
     }
+    else if (m_currentStep.canConvert<MatrixStep>()) {
+        drawMatrixStep(painter, m_currentStep.value<MatrixStep>());
+    }
 }
 
 void AlgorithmCanvas::drawSortingStep(QPainter& painter, const SortingStep& step)
@@ -86,60 +123,325 @@ void AlgorithmCanvas::drawGraphStep(QPainter& painter, const GraphStep& step)
     painter.setPen(Qt::white);
     painter.drawText(10, height() - 10, step.statusMessage);
 
-    QMap<int, QPointF> nodePositions;
-    for (const NodeState& ns : step.nodes) {
-        nodePositions[ns.id] = ns.position;
+    if (step.topology) applyGraphChanges(step);
+    else indexTreeStep(step);
+    drawGraphElements(painter, m_graphRun.nodes, m_graphRun.edges);
+}
+
+// Brings the cached colors and edge shapes to the given step. Scrubbing
+// forwards replays the new changes and backwards undoes them, so each frame
+// costs only the changes between it and the previous frame. The run shown
+// before stays parked, so steps alternating between two runs (the views of a
+// dynamic update) do not start over from the topology each time.
+void AlgorithmCanvas::applyGraphChanges(const GraphStep& step)
+{
+    bool moved = step.positions != m_graphPositions;
+    if (step.topology != m_graphTopology || step.changes != m_graphRun.changes) {
+        if (step.topology != m_graphTopology) {
+            m_graphIndex.build(*step.topology);
+            m_graphReach = 0.0;
+            m_indexedPositions.reset();
+            m_indexSlack = 0.0;
+            m_framesSinceIndex = 0;
+            m_graphRun = GraphRun();
+            m_parkedRun = GraphRun();
+        }
+        m_graphTopology = step.topology;
+        m_graphPositions.reset();
+
+        // Back to the parked run, or park this one and start the step's from the topology
+        std::swap(m_graphRun, m_parkedRun);
+        if (m_graphRun.changes != step.changes) {
+            m_graphRun = GraphRun();
+            m_graphRun.changes = step.changes;
+            m_graphRun.nodes = step.topology->nodes;
+            m_graphRun.edges = step.topology->edges;
+        }
+        moved = step.positions || m_indexedPositions; // The nodes are back where the topology has them
+    }
+    if (moved) moveGraphNodes(step.positions);
+    if (step.edits) m_graphRun.edits = step.edits;
+
+    GraphRun& run = m_graphRun;
+    const QVector<GraphChange>& changes = *run.changes;
+    while (run.applied < step.changeCount) {
+        const GraphChange& change = changes[run.applied++];
+        if (change.edit >= 0) applyEdgeEdit(change, true);
+        if (change.isEdge) run.edges[change.index].color = change.color;
+        else run.nodes[change.index].color = change.color;
+    }
+    while (run.applied > step.changeCount) {
+        const GraphChange& change = changes[--run.applied];
+        if (change.edit >= 0) applyEdgeEdit(change, false);
+        if (change.isEdge) run.edges[change.index].color = change.previous;
+        else run.nodes[change.index].color = change.previous;
+    }
+}
+
+// Ids past the topology's are added as the edits reach them and kept when
+// stepping back, with no endpoints
+void AlgorithmCanvas::applyEdgeEdit(const GraphChange& change, bool forward)
+{
+    const EdgeEdit& edit = m_graphRun.edits->at(change.edit);
+    while (m_graphRun.edges.size() <= change.index) m_graphRun.edges.append(EdgeState());
+    EdgeState& es = m_graphRun.edges[change.index];
+    es.fromId = forward ? edit.fromId : edit.previousFrom;
+    es.toId = forward ? edit.toId : edit.previousTo;
+    es.weightLabel = forward ? edit.weightLabel : edit.previousLabel;
+    m_graphRun.editedEdges.insert(change.index);
+}
+
+// Force layout frames move the nodes of one topology. The index is rebuilt
+// only every LAYOUT_INDEX_FRAMES frames; in between, queries are grown by
+// m_indexSlack, the farthest any node has moved since, which still finds
+// every node and edge in view. Null positions restore the topology's.
+void AlgorithmCanvas::moveGraphNodes(const QSharedPointer<const QVector<QPointF>>& positions)
+{
+    m_graphPositions = positions;
+    const QList<NodeState>& base = m_graphTopology->nodes;
+    QList<NodeState>& nodes = m_graphRun.nodes;
+    for (int u = 0; u < nodes.size(); ++u) nodes[u].position = positions ? positions->at(u) : base[u].position;
+
+    if (++m_framesSinceIndex >= LAYOUT_INDEX_FRAMES) {
+        m_graphIndex.build(GraphTopology{nodes, m_graphRun.edges});
+        m_indexedPositions = positions;
+        m_indexSlack = 0.0;
+        m_framesSinceIndex = 0;
+        return;
+    }
+    m_indexSlack = 0.0;
+    for (int u = 0; u < nodes.size(); ++u) {
+        QPointF indexed = m_indexedPositions ? m_indexedPositions->at(u) : base[u].position;
+        QPointF moved = nodes[u].position - indexed;
+        m_indexSlack = std::max({m_indexSlack, std::abs(moved.x()), std::abs(moved.y())});
     }
+}
 
-    painter.setFont(QFont("Arial", 10));
-    for (const EdgeState& es : step.edges)
-    {
-        if (nodePositions.contains(es.fromId) && nodePositions.contains(es.toId))
-        {
-            QPointF p1 = nodePositions[es.fromId];
-            QPointF p2 = nodePositions[es.toId];
-
-            painter.setPen(QPen(es.color, 2));
-            painter.drawLine(p1, p2);
-
-            // Draw Weight (if exists)
-            if (!es.weightLabel.isEmpty()) {
-                // Calculate midpoint
-                QPointF mid = (p1 + p2) / 2.0;
-
-                // Draw a small black box behind text for readability
-                QRectF textRect(mid.x() - 10, mid.y() - 10, 20, 20);
-                painter.setBrush(Qt::black);
-                painter.setPen(Qt::NoPen);
-                painter.drawRect(textRect);
-
-                // Draw text
-                painter.setPen(Qt::cyan); // Cyan color for weights
-                painter.drawText(textRect, es.weightLabel, QTextOption(Qt::AlignCenter));
+// Tree steps carry their own nodes, identified by key, and edges between keys.
+// The first paint of each step renumbers the nodes by position, as topology
+// steps are, and indexes them; zooming and panning then only touch what is in
+// view. Edges to a key with no node get endpoint -1 and are not drawn.
+void AlgorithmCanvas::indexTreeStep(const GraphStep& step)
+{
+    if (m_treeIndexed) return;
+    m_treeIndexed = true;
+    m_graphTopology.reset();
+    m_graphRun = GraphRun();
+    m_parkedRun = GraphRun();
+
+    GraphTopology topology;
+    topology.nodes = step.nodes;
+    topology.edges = step.edges;
+    QHash<int, int> indexOf; // Node key -> position; a repeated key keeps its last node
+    indexOf.reserve(topology.nodes.size());
+    m_graphReach = 0.0;
+    for (int i = 0; i < topology.nodes.size(); ++i) {
+        NodeState& ns = topology.nodes[i];
+        indexOf.insert(ns.id, i);
+        ns.id = i;
+        m_graphReach = std::max(m_graphReach, ns.width / 2.0);
+    }
+    for (EdgeState& es : topology.edges) {
+        es.fromId = indexOf.value(es.fromId, -1);
+        es.toId = indexOf.value(es.toId, -1);
+    }
+    m_graphIndex.build(topology);
+    m_indexedPositions.reset();
+    m_indexSlack = 0.0;
+    m_graphPositions.reset();
+    m_graphRun.nodes = topology.nodes;
+    m_graphRun.edges = topology.edges;
+}
+
+// nodes[i].id == i, so edge endpoints are looked up directly and the visible
+// part comes from m_graphIndex. Only what lies in view is drawn; zoomed far
+// out, labels and weights are dropped and primitives are batched by color,
+// nodes shrinking to points.
+void AlgorithmCanvas::drawGraphElements(QPainter& painter, const QList<NodeState>& nodes, const QList<EdgeState>& edges)
+{
+    // World rectangle on screen, grown so nodes just outside still show their
+    // rim, and multi-key boxes their far end
+    double marginX = std::max(NODE_RADIUS, m_graphReach);
+    QRectF view(-m_pan.x() / m_zoom - marginX, -m_pan.y() / m_zoom - NODE_RADIUS,
+                width() / m_zoom + 2 * marginX, height() / m_zoom + 2 * NODE_RADIUS);
+    QRectF indexedView = view.adjusted(-m_indexSlack, -m_indexSlack, m_indexSlack, m_indexSlack);
+
+    QVector<int> visibleNodes;
+    QVector<int> visibleEdges;
+    m_graphIndex.query(indexedView, visibleNodes, visibleEdges);
+    const QSet<int>& edited = m_graphRun.editedEdges;
+    if (!edited.isEmpty()) {
+        // Reshaped edges are tested one by one, where they are now
+        visibleEdges.erase(std::remove_if(visibleEdges.begin(), visibleEdges.end(), [&](int e) { return edited.contains(e); }),
+                           visibleEdges.end());
+        for (int e : edited) {
+            const EdgeState& es = edges[e];
+            if (es.fromId < 0 || es.toId < 0) continue;
+            QPointF p1 = nodes[es.fromId].position;
+            QPointF p2 = nodes[es.toId].position;
+            if (std::max(p1.x(), p2.x()) >= view.left() && std::min(p1.x(), p2.x()) <= view.right()
+                && std::max(p1.y(), p2.y()) >= view.top() && std::min(p1.y(), p2.y()) <= view.bottom()) {
+                visibleEdges.append(e);
             }
         }
     }
+    auto position = [&](int id) { return nodes[id].position; };
+
+    double radius = NODE_RADIUS * m_zoom; // On screen
+    bool detailed = radius >= LABEL_MIN_RADIUS;
+    if (detailed) {
+        // Few enough to draw one by one, in id order as before
+        std::sort(visibleNodes.begin(), visibleNodes.end());
+        std::sort(visibleEdges.begin(), visibleEdges.end());
+    }
 
-    // Draw Nodes
-    painter.setFont(QFont("Arial", 12, QFont::Bold));
-    const int nodeRadius = 20;
+    painter.save();
+    painter.setRenderHint(QPainter::Antialiasing, visibleNodes.size() + visibleEdges.size() <= ANTIALIAS_LIMIT);
+    painter.setTransform(QTransform(m_zoom, 0, 0, m_zoom, m_pan.x(), m_pan.y()));
+
+    // Edges, one drawLines() call per color; edges within a pixel are skipped
+    QHash<QRgb, QVector<QPointF>> lines; // Endpoint pairs
+    for (int e : visibleEdges) {
+        const EdgeState& es = edges[e];
+        if (es.fromId < 0 || es.toId < 0) continue;
+        QPointF p1 = position(es.fromId);
+        QPointF p2 = position(es.toId);
+        if (std::abs(p1.x() - p2.x()) * m_zoom < 1.0 && std::abs(p1.y() - p2.y()) * m_zoom < 1.0) continue;
+        QVector<QPointF>& pairs = lines[es.color.rgba()];
+        pairs.append(p1);
+        pairs.append(p2);
+    }
+    for (QRgb color : colorsByFrequency(lines)) {
+        QPen pen(QColor::fromRgba(color), EDGE_WIDTH);
+        if (EDGE_WIDTH * m_zoom < 1.0) {
+            pen.setWidthF(1.0); // Thinner than a pixel: one screen pixel instead
+            pen.setCosmetic(true);
+        }
+        painter.setPen(pen);
+        const QVector<QPointF>& pairs = lines[color];
+        painter.drawLines(pairs.constData(), pairs.size() / 2);
+    }
 
-    for (const NodeState& ns : step.nodes)
-    {
-        painter.setBrush(ns.color);
-        painter.setPen(Qt::NoPen);
-        painter.drawEllipse(ns.position, nodeRadius, nodeRadius);
+    if (detailed) {
+        // Weights on top of every edge, with a small black box behind for readability
+        painter.setFont(QFont("Arial", 10));
+        for (int e : visibleEdges) {
+            const EdgeState& es = edges[e];
+            if (es.weightLabel.isEmpty() || es.fromId < 0 || es.toId < 0) continue;
+            QPointF mid = (position(es.fromId) + position(es.toId)) / 2.0;
+            QRectF textRect(mid.x() - 10, mid.y() - 10, 20, 20);
+            painter.setBrush(Qt::black);
+            painter.setPen(Qt::NoPen);
+            painter.drawRect(textRect);
+            painter.setPen(Qt::cyan); // Cyan color for weights
+            painter.drawText(textRect, es.weightLabel, QTextOption(Qt::AlignCenter));
+        }
+
+        painter.setFont(QFont("Arial", 12, QFont::Bold));
+        for (int i : visibleNodes) {
+            const NodeState& ns = nodes[i];
+            painter.setBrush(ns.color);
+            painter.setPen(Qt::NoPen);
+
+            // Multi-key nodes (B-tree) are drawn as a box wide enough for every key
+            if (ns.width > 0) {
+                QRectF box(ns.position.x() - ns.width / 2.0, ns.position.y() - NODE_RADIUS, ns.width, NODE_RADIUS * 2);
+                painter.drawRoundedRect(box, 6, 6);
+                painter.setPen(ns.textColor);
+                painter.drawText(box, ns.label, QTextOption(Qt::AlignCenter));
+                continue;
+            }
 
-        painter.setPen(ns.textColor);
-        painter.drawText(QRectF(ns.position.x() - nodeRadius,
-                                ns.position.y() - nodeRadius,
-                                nodeRadius * 2,
-                                nodeRadius * 2),
-                         ns.label,
-                         QTextOption(Qt::AlignCenter));
+            painter.drawEllipse(ns.position, NODE_RADIUS, NODE_RADIUS);
+            painter.setPen(ns.textColor);
+            painter.drawText(QRectF(ns.position.x() - NODE_RADIUS, ns.position.y() - NODE_RADIUS,
+                                    NODE_RADIUS * 2, NODE_RADIUS * 2),
+                             ns.label, QTextOption(Qt::AlignCenter));
+        }
+    } else {
+        // Unlabeled shapes batched by color; points once they are a few pixels wide
+        QHash<QRgb, QVector<int>> byColor;
+        for (int i : visibleNodes) byColor[nodes[i].color.rgba()].append(i);
+        for (QRgb color : colorsByFrequency(byColor)) {
+            const QVector<int>& members = byColor[color];
+            if (radius < POINT_MAX_RADIUS) {
+                QPen pen(QColor::fromRgba(color));
+                pen.setWidthF(std::max(1.0, 2 * radius));
+                pen.setCosmetic(true);
+                painter.setPen(pen);
+                QVector<QPointF> points;
+                points.reserve(members.size());
+                for (int i : members) points.append(nodes[i].position);
+                painter.drawPoints(points.constData(), points.size());
+                continue;
+            }
+            painter.setBrush(QColor::fromRgba(color));
+            painter.setPen(Qt::NoPen);
+            for (int i : members) {
+                const NodeState& ns = nodes[i];
+                if (ns.width > 0) {
+                    painter.drawRect(QRectF(ns.position.x() - ns.width / 2.0, ns.position.y() - NODE_RADIUS,
+                                            ns.width, NODE_RADIUS * 2));
+                } else {
+                    painter.drawEllipse(ns.position, NODE_RADIUS, NODE_RADIUS);
+                }
+            }
+        }
+    }
+    painter.restore();
+
+    if (m_zoom != 1.0 || !m_pan.isNull()) {
+        painter.setPen(Qt::white);
+        painter.setFont(QFont("Arial", 10));
+        painter.drawText(10, 20, "Zoom " + QString::number(m_zoom * 100, 'f', 0) + "% | "
+                                 + QString::number(visibleNodes.size()) + " of " + QString::number(nodes.size())
+                                 + " nodes in view | double-click to reset");
     }
 }
 
+// --- Viewport ---
+
+void AlgorithmCanvas::wheelEvent(QWheelEvent* event)
+{
+    // Keep the world point under the cursor where it is
+    QPointF cursor = event->position();
+    QPointF world = (cursor - m_pan) / m_zoom;
+    m_zoom = std::clamp(m_zoom * std::pow(WHEEL_ZOOM_BASE, event->angleDelta().y()), MIN_ZOOM, MAX_ZOOM);
+    m_pan = cursor - world * m_zoom;
+    event->accept();
+    update();
+}
+
+void AlgorithmCanvas::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton) return;
+    m_dragging = true;
+    m_dragOrigin = QPointF(event->pos()) - m_pan;
+    setCursor(Qt::ClosedHandCursor);
+}
+
+void AlgorithmCanvas::mouseMoveEvent(QMouseEvent* event)
+{
+    if (!m_dragging) return;
+    m_pan = QPointF(event->pos()) - m_dragOrigin;
+    update();
+}
+
+void AlgorithmCanvas::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton) return;
+    m_dragging = false;
+    unsetCursor();
+}
+
+void AlgorithmCanvas::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    m_zoom = 1.0;
+    m_pan = QPointF();
+    event->accept();
+    update();
+}
+
 void AlgorithmCanvas::drawMazeStep(QPainter& painter, const MazeStep& step)
 {
     // Draw Status Message
@@ -147,10 +449,11 @@ void AlgorithmCanvas::drawMazeStep(QPainter& painter, const MazeStep& step)
     painter.setFont(QFont("Arial", 12));
     painter.drawText(10, height() - 10, step.statusMessage);
 
-    if (step.grid.isEmpty()) return;
+    if (!step.trace || step.trace->width == 0 || step.trace->height == 0) return;
+    applyMazeChanges(step);
 
-    int rows = step.grid.size();
-    int cols = step.grid[0].size();
+    int rows = step.trace->height;
+    int cols = step.trace->width;
 
     // Calculate cell size to fit canvas
     // Use slightly smaller area to leave margins
@@ -164,27 +467,96 @@ void AlgorithmCanvas::drawMazeStep(QPainter& painter, const MazeStep& step)
     double startX = (width() - (cols * cellSize)) / 2.0;
     double startY = ((height() - 30) - (rows * cellSize)) / 2.0;
 
-    for (int y = 0; y < rows; ++y) {
-        for (int x = 0; x < cols; ++x) {
-            int type = step.grid[y][x];
+    // One pixel per cell, scaled up without smoothing so cells keep sharp edges
+    painter.drawImage(QRectF(startX, startY, cols * cellSize, rows * cellSize), m_mazeImage);
+}
 
-            QRectF cellRect(startX + x * cellSize, startY + y * cellSize, cellSize, cellSize);
+// Brings the cached image to the given step, like applyGraphChanges(), but
+// starts over from the nearest keyframe when that is closer than the cache
+void AlgorithmCanvas::applyMazeChanges(const MazeStep& step)
+{
+    const MazeTrace& trace = *step.trace;
+    int target = step.changeCount;
+    int keyframe = std::min(target / trace.keyframeInterval, (int)trace.keyframes.size() - 1);
+    int fromKeyframe = target - keyframe * trace.keyframeInterval;
+
+    if (step.trace != m_mazeTrace) {
+        m_mazeTrace = step.trace;
+        m_mazeImage = QImage(trace.width, trace.height, QImage::Format_Indexed8);
+        m_mazeImage.setColorTable(MAZE_COLORS);
+        m_mazeApplied = -1; // Nothing loaded yet
+    }
+    if (m_mazeApplied < 0 || std::abs(target - m_mazeApplied) > fromKeyframe) {
+        const char* grid = trace.keyframes[keyframe].constData();
+        for (int y = 0; y < trace.height; ++y) {
+            std::copy(grid + y * trace.width, grid + (y + 1) * trace.width, m_mazeImage.scanLine(y));
+        }
+        m_mazeApplied = keyframe * trace.keyframeInterval;
+    }
 
-            // Colors
-            if (type == WALL) {
-                painter.setBrush(Qt::black);
-                painter.setPen(Qt::NoPen);
-            }
-            else if (type == PATH) {
-                painter.setBrush(Qt::white);
-                painter.setPen(Qt::NoPen);
-            }
-            else if (type == VISITED) {
-                painter.setBrush(Qt::red);
-                painter.setPen(Qt::NoPen);
-            }
+    const QVector<MazeChange>& changes = trace.changes;
+    while (m_mazeApplied < target) {
+        const MazeChange& change = changes[m_mazeApplied++];
+        m_mazeImage.scanLine(change.cell / trace.width)[change.cell % trace.width] = change.type;
+    }
+    while (m_mazeApplied > target) {
+        const MazeChange& change = changes[--m_mazeApplied];
+        m_mazeImage.scanLine(change.cell / trace.width)[change.cell % trace.width] = change.previous;
+    }
+}
+
+void AlgorithmCanvas::drawMatrixStep(QPainter& painter, const MatrixStep& step)
+{
+    painter.setPen(Qt::white);
+    painter.setFont(QFont("Arial", 12));
+    painter.drawText(10, height() - 10, step.statusMessage);
 
-            painter.drawRect(cellRect);
+    int n = step.size;
+    if (n == 0) return;
+
+    // Square cells, centered, leaving room for the text like the maze view
+    double cellSize = std::min((double)width() / n, (double)(height() - 30) / n);
+    double startX = (width() - n * cellSize) / 2.0;
+    double startY = ((height() - 30) - n * cellSize) / 2.0;
+
+    int maxVal = 1;
+    for (int value : step.values) maxVal = std::max(maxVal, value);
+
+    // Blue (short) to red (long); cells without a value stay dark gray
+    painter.setPen(Qt::NoPen);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            int value = step.values[i * n + j];
+            QColor color = value < 0 ? QColor(40, 40, 40) : QColor::fromHsv(240 - 240 * value / maxVal, 255, 230);
+            painter.setBrush(color);
+            painter.drawRect(QRectF(startX + j * cellSize, startY + i * cellSize, cellSize, cellSize));
+        }
+    }
+    painter.setBrush(Qt::NoBrush);
+
+    if (step.tileSize > 0) {
+        painter.setPen(QPen(QColor(90, 90, 90), 1));
+        for (int t = 0; t <= n; t += step.tileSize) {
+            painter.drawLine(QPointF(startX + t * cellSize, startY), QPointF(startX + t * cellSize, startY + n * cellSize));
+            painter.drawLine(QPointF(startX, startY + t * cellSize), QPointF(startX + n * cellSize, startY + t * cellSize));
+        }
+
+        painter.setPen(QPen(Qt::yellow, 2));
+        for (const QPoint& tile : step.activeTiles) {
+            int x0 = tile.x() * step.tileSize;
+            int y0 = tile.y() * step.tileSize;
+            double w = (std::min(x0 + step.tileSize, n) - x0) * cellSize;
+            double h = (std::min(y0 + step.tileSize, n) - y0) * cellSize;
+            painter.drawRect(QRectF(startX + x0 * cellSize, startY + y0 * cellSize, w, h));
         }
     }
+
+    // Pivot band: the rows and columns every update in this step reads from
+    if (step.highlightEnd > step.highlightBegin) {
+        double band = (step.highlightEnd - step.highlightBegin) * cellSize;
+        double offset = step.highlightBegin * cellSize;
+        painter.setPen(QPen(Qt::white, 2));
+        painter.drawRect(QRectF(startX + offset, startY, band, n * cellSize));
+        painter.drawRect(QRectF(startX, startY + offset, n * cellSize, band));
+    }
 }
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <QWidget>
+#include <QImage>
 #include <QPainter>
+#include <QSet>
 #include "datastructures.h"
+#include "spatialindex.h"
 
 class AlgorithmCanvas : public QWidget
 {
@@ -17,9 +20,58 @@ public slots:
 protected:
     void paintEvent(QPaintEvent* event) override;
 
+    // Graph and tree views zoom with the wheel (around the cursor), pan by
+    // dragging, and return to the default view on a double-click
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+
 private:
     QVariant m_currentStep;
+
+    // Colors and edge shapes of one delta-encoded run over m_graphTopology,
+    // with its first 'applied' changes applied
+    struct GraphRun {
+        QSharedPointer<const QVector<GraphChange>> changes;
+        QSharedPointer<const QVector<EdgeEdit>> edits;
+        int applied = 0;
+        QList<NodeState> nodes;
+        QList<EdgeState> edges;
+        QSet<int> editedEdges; // Reshaped since the topology: not where m_graphIndex has them
+    };
+    QSharedPointer<const GraphTopology> m_graphTopology;
+    GraphRun m_graphRun;  // On screen
+    GraphRun m_parkedRun; // The one before, on the same topology: dynamic updates alternate two runs
+    SpatialIndex m_graphIndex; // Over m_graphTopology, rebuilt when it changes
+    QSharedPointer<const QVector<QPointF>> m_graphPositions;   // Layout positions in m_graphRun.nodes, if any
+    QSharedPointer<const QVector<QPointF>> m_indexedPositions; // Those m_graphIndex was built on, if not the topology's
+    double m_indexSlack = 0.0;  // Farthest a node has moved since m_graphIndex was built
+    int m_framesSinceIndex = 0;
+    bool m_treeIndexed = false; // A tree step's nodes and edges are in m_graphIndex
+    double m_graphReach = 0.0;  // Widest multi-key box's half width, 0 for graphs
+
+    // Maze run on screen as an 8-bit indexed image, one pixel per cell
+    // holding its CellType, with the first m_mazeApplied changes of m_mazeTrace applied
+    QSharedPointer<const MazeTrace> m_mazeTrace;
+    int m_mazeApplied = 0;
+    QImage m_mazeImage;
+
+    // Viewport of graph steps: screen = world * m_zoom + m_pan
+    double m_zoom = 1.0;
+    QPointF m_pan;
+    bool m_dragging = false;
+    QPointF m_dragOrigin; // Cursor position minus m_pan when the drag began
+
     void drawSortingStep(QPainter& painter, const SortingStep& step);
     void drawGraphStep(QPainter& painter, const GraphStep& step);
+    void drawGraphElements(QPainter& painter, const QList<NodeState>& nodes, const QList<EdgeState>& edges);
+    void applyGraphChanges(const GraphStep& step);
+    void applyEdgeEdit(const GraphChange& change, bool forward);
+    void moveGraphNodes(const QSharedPointer<const QVector<QPointF>>& positions);
+    void indexTreeStep(const GraphStep& step);
     void drawMazeStep(QPainter& painter, const MazeStep& step);
+    void applyMazeChanges(const MazeStep& step);
+    void drawMatrixStep(QPainter& painter, const MatrixStep& step);
 };
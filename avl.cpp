@@ -3,29 +3,18 @@
 #include <cmath>
 #include <algorithm>
 
-// Define constants for layout
-const int LEVEL_HEIGHT = 80;
-const int CANVAS_WIDTH = 1200;
-
 AVL::AVL() : m_root(nullptr), m_nextNodeId(0) {}
 
 void AVL::clear()
 {
-    if (!m_root) return;
-    QQueue<TreeNode*> queue;
-    queue.enqueue(m_root);
-    while(!queue.isEmpty()) {
-        TreeNode* node = queue.dequeue();
-        if (node->left) queue.enqueue(node->left);
-        if (node->right) queue.enqueue(node->right);
-        delete node;
-    }
+    TreeView::destroy(m_root);
     m_root = nullptr;
     m_nextNodeId = 0;
 }
 
 QList<QVariant> AVL::insert(int value)
 {
+    resetStats();
     QList<QVariant> history;
     history.append(QVariant::fromValue(createSnapshot("Inserting " + QString::number(value))));
 
@@ -36,7 +25,7 @@ QList<QVariant> AVL::insert(int value)
     updatePositions();
 
     // Add a final snapshot with the correct layout
-    GraphStep finalStep = createSnapshot("Inserted " + QString::number(value) + ". Balancing complete.");
+    GraphStep finalStep = createSnapshot("Inserted " + QString::number(value) + ". Balancing complete. " + TreeView::statsText(m_stats));
 
     // Find the new node to highlight it
     QQueue<TreeNode*> queue;
@@ -57,6 +46,7 @@ QList<QVariant> AVL::insert(int value)
 
 QList<QVariant> AVL::remove(int value)
 {
+    resetStats();
     QList<QVariant> history;
     history.append(QVariant::fromValue(createSnapshot("Attempting to remove " + QString::number(value))));
     m_root = removeRecursive(m_root, value, history);
@@ -64,13 +54,151 @@ QList<QVariant> AVL::remove(int value)
     if (m_root) {
         // Recalculate all positions after deletion/rotation
         updatePositions();
-        history.append(QVariant::fromValue(createSnapshot("Removed " + QString::number(value) + ". Final check.")));
+        history.append(QVariant::fromValue(createSnapshot("Removed " + QString::number(value) + ". Final check. " + TreeView::statsText(m_stats))));
+    } else {
+        history.append(QVariant::fromValue(createSnapshot("Removed " + QString::number(value) + ". Tree is empty. " + TreeView::statsText(m_stats))));
+    }
+    return history;
+}
+
+QList<QVariant> AVL::find(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    history.append(QVariant::fromValue(createSnapshot("Searching for " + QString::number(value))));
+
+    const TreeNode* node = m_root;
+    while (node) {
+        m_stats.comparisons++;
+        m_stats.pathLength++;
+        if (value == node->value) break;
+
+        GraphStep step = createSnapshot("Comparing with " + QString::number(node->value));
+        highlightNode(step, node->id, Qt::yellow);
+        history.append(QVariant::fromValue(step));
+        node = (value < node->value) ? node->left : node->right;
+    }
+
+    QString summary = "Path length: " + QString::number(m_stats.pathLength);
+    if (node) {
+        GraphStep step = createSnapshot("Found " + QString::number(value) + ". " + summary);
+        highlightNode(step, node->id, Qt::green);
+        history.append(QVariant::fromValue(step));
     } else {
-        history.append(QVariant::fromValue(createSnapshot("Removed " + QString::number(value) + ". Tree is empty.")));
+        history.append(QVariant::fromValue(createSnapshot("Value " + QString::number(value) + " not found. " + summary)));
+    }
+    return history;
+}
+
+// --- Batched Operations ---
+
+QList<QVariant> AVL::bulkLoad(const QVector<int>& sortedValues)
+{
+    build(sortedValues);
+    updatePositions();
+
+    QList<QVariant> history;
+    GraphStep step = createSnapshot("Bulk loaded " + QString::number(m_nextNodeId) + " keys from sorted input. Height: "
+                                    + QString::number(getHeight(m_root)));
+    highlightNewNodes(step, 0, Qt::green);
+    history.append(QVariant::fromValue(step));
+    return history;
+}
+
+QList<QVariant> AVL::insertBatch(const QVector<int>& values)
+{
+    resetStats();
+    int firstNewId = m_nextNodeId;
+    int inserted = 0;
+    for (int v : values) {
+        if (insertSilent(v)) inserted++;
+    }
+    updatePositions();
+
+    QList<QVariant> history;
+    GraphStep step = createSnapshot("Batch inserted " + QString::number(inserted) + " keys ("
+                                    + QString::number(values.size() - inserted) + " duplicates skipped). Height: "
+                                    + QString::number(getHeight(m_root)) + ". " + TreeView::statsText(m_stats));
+    highlightNewNodes(step, firstNewId, Qt::green);
+    history.append(QVariant::fromValue(step));
+    return history;
+}
+
+QList<QVariant> AVL::removeBatch(const QVector<int>& values)
+{
+    resetStats();
+    int removed = 0;
+    for (int v : values) {
+        if (removeSilent(v)) removed++;
     }
+    updatePositions();
+
+    QList<QVariant> history;
+    history.append(QVariant::fromValue(createSnapshot("Batch removed " + QString::number(removed) + " keys ("
+                                                      + QString::number(values.size() - removed) + " not found). Height: "
+                                                      + QString::number(getHeight(m_root)) + ". " + TreeView::statsText(m_stats))));
     return history;
 }
 
+// --- Native Operations ---
+
+void AVL::build(const QVector<int>& sortedValues)
+{
+    clear();
+
+    // Drop duplicates in a single pass (input is already sorted)
+    QVector<int> keys;
+    keys.reserve(sortedValues.size());
+    for (int v : sortedValues) {
+        if (keys.isEmpty() || keys.last() != v) keys.append(v);
+    }
+
+    m_root = buildBalanced(keys, 0, keys.size() - 1);
+}
+
+bool AVL::contains(int value) const
+{
+    const TreeNode* node = m_root;
+    while (node) {
+        if (value < node->value) node = node->left;
+        else if (value > node->value) node = node->right;
+        else return true;
+    }
+    return false;
+}
+
+bool AVL::findSilent(int value)
+{
+    return TreeView::search(m_root, value, m_stats) != nullptr;
+}
+
+bool AVL::insertSilent(int value)
+{
+    bool inserted = false;
+    m_root = insertSilent(m_root, value, inserted);
+    return inserted;
+}
+
+bool AVL::removeSilent(int value)
+{
+    bool removed = false;
+    m_root = removeSilent(m_root, value, removed);
+    return removed;
+}
+
+int AVL::countRange(int low, int high) const
+{
+    return countRangeRecursive(m_root, low, high);
+}
+
+int AVL::countRangeRecursive(const AVL::TreeNode* node, int low, int high) const
+{
+    if (node == nullptr) return 0;
+    if (node->value < low) return countRangeRecursive(node->right, low, high);
+    if (node->value > high) return countRangeRecursive(node->left, low, high);
+    return 1 + countRangeRecursive(node->left, low, high) + countRangeRecursive(node->right, low, high);
+}
+
 AVL::TreeNode* AVL::insertRecursive(AVL::TreeNode* node, int value, int level, QList<QVariant>& history)
 {
     if (node == nullptr) {
@@ -89,6 +217,7 @@ AVL::TreeNode* AVL::insertRecursive(AVL::TreeNode* node, int value, int level, Q
     }
 
     // Add "visiting" step (positions here might be stale, but that's ok)
+    m_stats.comparisons++;
     GraphStep visitStep = createSnapshot("Comparing with " + QString::number(node->value));
     highlightNode(visitStep, node->id, Qt::yellow);
     history.append(QVariant::fromValue(visitStep));
@@ -154,6 +283,7 @@ AVL::TreeNode* AVL::removeRecursive(AVL::TreeNode* node, int value, QList<QVaria
         return nullptr;
     }
 
+    m_stats.comparisons++;
     GraphStep visitStep = createSnapshot("Comparing with " + QString::number(node->value));
     highlightNode(visitStep, node->id, Qt::yellow);
     history.append(QVariant::fromValue(visitStep));
@@ -245,6 +375,91 @@ AVL::TreeNode* AVL::balanceForRemove(AVL::TreeNode* node, QList<QVariant>& histo
 }
 
 
+// --- Silent Helpers ---
+
+AVL::TreeNode* AVL::buildBalanced(const QVector<int>& values, int lo, int hi)
+{
+    if (lo > hi) return nullptr;
+
+    // The middle key becomes the subtree root, so both halves differ in size by at most one
+    int mid = lo + (hi - lo) / 2;
+    TreeNode* node = new TreeNode(values[mid], m_nextNodeId++, 0, QPointF());
+    node->left = buildBalanced(values, lo, mid - 1);
+    node->right = buildBalanced(values, mid + 1, hi);
+    updateHeight(node);
+    return node;
+}
+
+AVL::TreeNode* AVL::insertSilent(AVL::TreeNode* node, int value, bool& inserted)
+{
+    if (node == nullptr) {
+        inserted = true;
+        return new TreeNode(value, m_nextNodeId++, 0, QPointF());
+    }
+
+    m_stats.comparisons++;
+    if (value < node->value) {
+        node->left = insertSilent(node->left, value, inserted);
+    } else if (value > node->value) {
+        node->right = insertSilent(node->right, value, inserted);
+    } else {
+        return node;
+    }
+
+    updateHeight(node);
+    return rebalance(node);
+}
+
+AVL::TreeNode* AVL::removeSilent(AVL::TreeNode* node, int value, bool& removed)
+{
+    if (node == nullptr) {
+        return nullptr;
+    }
+
+    m_stats.comparisons++;
+    if (value < node->value) {
+        node->left = removeSilent(node->left, value, removed);
+    } else if (value > node->value) {
+        node->right = removeSilent(node->right, value, removed);
+    } else {
+        removed = true;
+        if (node->left == nullptr || node->right == nullptr) {
+            TreeNode* temp = node->left ? node->left : node->right;
+            delete node;
+            return temp;
+        }
+
+        TreeNode* temp = findMin(node->right);
+        node->value = temp->value;
+        bool dummy = false;
+        node->right = removeSilent(node->right, temp->value, dummy);
+    }
+
+    updateHeight(node);
+    return rebalance(node);
+}
+
+AVL::TreeNode* AVL::rebalance(AVL::TreeNode* node)
+{
+    int balanceFactor = getBalanceFactor(node);
+
+    if (balanceFactor > 1) {
+        if (getBalanceFactor(node->left) < 0) {
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
+    }
+
+    if (balanceFactor < -1) {
+        if (getBalanceFactor(node->right) > 0) {
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
+    }
+
+    return node;
+}
+
 AVL::TreeNode* AVL::findMin(AVL::TreeNode* node)
 {
     while (node && node->left != nullptr) {
@@ -284,16 +499,8 @@ AVL::TreeNode* AVL::rightRotate(AVL::TreeNode* y, QList<QVariant>& history)
     highlightNode(preStep, y->id, Qt::red);
     history.append(QVariant::fromValue(preStep));
 
-    TreeNode* x = y->left;
-    TreeNode* T2 = x->right;
-
     // Perform rotation
-    x->right = y;
-    y->left = T2;
-
-    // Update heights
-    updateHeight(y);
-    updateHeight(x);
+    TreeNode* x = rotateRight(y);
 
     // We DON'T call updatePositions() here anymore.
     // Add a snapshot *after* rotation (layout is still old, but structure is new)
@@ -312,16 +519,8 @@ AVL::TreeNode* AVL::leftRotate(AVL::TreeNode* x, QList<QVariant>& history)
     highlightNode(preStep, x->id, Qt::red);
     history.append(QVariant::fromValue(preStep));
 
-    TreeNode* y = x->right;
-    TreeNode* T2 = y->left;
-
     // Perform rotation
-    y->left = x;
-    x->right = T2;
-
-    // Update heights
-    updateHeight(x);
-    updateHeight(y);
+    TreeNode* y = rotateLeft(x);
 
     // We DON'T call updatePositions() here anymore.
     GraphStep postStep = createSnapshot("After Left Rotation (re-calculating layout...)");
@@ -332,79 +531,63 @@ AVL::TreeNode* AVL::leftRotate(AVL::TreeNode* x, QList<QVariant>& history)
 }
 
 
-// --- Visualization & Layout Helpers ---
+// Pointer surgery shared by the recorded and silent rotations
 
-// --- THIS IS THE KEY FUNCTION ---
-void AVL::updatePositions()
+AVL::TreeNode* AVL::rotateRight(AVL::TreeNode* y)
 {
-    if (!m_root) return;
-    // Call the recursive helper, starting at level 0
-    updatePositionsRecursive(m_root, 0, CANVAS_WIDTH / 2.0, CANVAS_WIDTH / 4.0);
+    m_stats.rotations++;
+    TreeNode* x = y->left;
+    TreeNode* T2 = x->right;
+
+    x->right = y;
+    y->left = T2;
+
+    updateHeight(y);
+    updateHeight(x);
+    return x;
 }
 
-void AVL::updatePositionsRecursive(AVL::TreeNode* node, int level, double x, double xOffset)
+AVL::TreeNode* AVL::rotateLeft(AVL::TreeNode* x)
 {
-    if (node == nullptr) {
-        return;
-    }
-    // Set the node's position based on its level and x-offset
-    node->pos = QPointF(x, 50 + level * LEVEL_HEIGHT);
-    node->level = level;
+    m_stats.rotations++;
+    TreeNode* y = x->right;
+    TreeNode* T2 = y->left;
+
+    y->left = x;
+    x->right = T2;
+
+    updateHeight(x);
+    updateHeight(y);
+    return y;
+}
 
-    // Recurse for children, halving the x-offset each time
-    updatePositionsRecursive(node->left, level + 1, x - xOffset, xOffset / 2.0);
-    updatePositionsRecursive(node->right, level + 1, x + xOffset, xOffset / 2.0);
+
+// --- Visualization & Layout Helpers ---
+
+// --- THIS IS THE KEY FUNCTION ---
+void AVL::updatePositions()
+{
+    TreeView::updatePositions(m_root);
 }
 
 GraphStep AVL::createSnapshot(const QString& message)
 {
     GraphStep step;
     step.statusMessage = message;
-    if (m_root) {
-        populateSnapshot(m_root, step);
-    }
+    TreeView::populateSnapshot(m_root, step);
     return step;
 }
 
-void AVL::populateSnapshot(AVL::TreeNode* node, GraphStep& step)
+void AVL::highlightNode(GraphStep& step, int nodeId, QColor color, QColor textColor)
 {
-    if (node == nullptr) {
-        return;
-    }
-
-    // 1. Add this node
-    NodeState ns;
-    ns.id = node->id;
-    ns.label = QString::number(node->value);
-    ns.position = node->pos; // Use the pre-calculated position
-    step.nodes.append(ns);
-
-    // 2. Add edge to left child
-    if (node->left) {
-        EdgeState es;
-        es.fromId = node->id;
-        es.toId = node->left->id;
-        step.edges.append(es);
-        populateSnapshot(node->left, step); // Recurse
-    }
-
-    // 3. Add edge to right child
-    if (node->right) {
-        EdgeState es;
-        es.fromId = node->id;
-        es.toId = node->right->id;
-        step.edges.append(es);
-        populateSnapshot(node->right, step); // Recurse
-    }
+    TreeView::highlightNode(step, nodeId, color, textColor);
 }
 
-void AVL::highlightNode(GraphStep& step, int nodeId, QColor color, QColor textColor)
+void AVL::highlightNewNodes(GraphStep& step, int firstNewId, QColor color)
 {
     for (NodeState& ns : step.nodes) {
-        if (ns.id == nodeId) {
+        if (ns.id >= firstNewId) {
             ns.color = color;
-            ns.textColor = textColor;
-            return;
         }
     }
 }
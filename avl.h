@@ -1,6 +1,7 @@
 #pragma once
 
 #include "datastructures.h"
+#include "treeview.h"
 #include <QList>
 #include <QVariant>
 #include <QMap>
@@ -13,8 +14,26 @@ public:
     // Public methods that generate and return a step-by-step history
     QList<QVariant> insert(int value);
     QList<QVariant> remove(int value);
+    QList<QVariant> find(int value);
     void clear(); // Resets the tree
 
+    // Batched operations: apply many keys at once and record a single summary step
+    QList<QVariant> bulkLoad(const QVector<int>& sortedValues); // O(n) build from sorted input
+    QList<QVariant> insertBatch(const QVector<int>& values);
+    QList<QVariant> removeBatch(const QVector<int>& values);
+
+    // Native operations (no history), used for benchmarking
+    void build(const QVector<int>& sortedValues);
+    bool contains(int value) const;
+    bool findSilent(int value); // Like contains(), but counts comparisons and path length
+    int countRange(int low, int high) const;
+    bool insertSilent(int value);
+    bool removeSilent(int value);
+
+    // Counters accumulate until reset; insert/remove and the batches reset them first
+    const TreeStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = TreeStats(); }
+
 private:
     // --- Core Tree Structure ---
     struct TreeNode {
@@ -34,6 +53,7 @@ private:
 
     TreeNode* m_root;
     int m_nextNodeId;
+    TreeStats m_stats;
 
     // --- Recursive Algorithm Helpers ---
     TreeNode* insertRecursive(TreeNode* node, int value, int level, QList<QVariant>& history);
@@ -52,9 +72,17 @@ private:
 
     TreeNode* balanceForRemove(TreeNode* node, QList<QVariant>& history);
 
+    // --- Silent Helpers (no history, used by the batched operations) ---
+    TreeNode* buildBalanced(const QVector<int>& values, int lo, int hi);
+    TreeNode* insertSilent(TreeNode* node, int value, bool& inserted);
+    TreeNode* removeSilent(TreeNode* node, int value, bool& removed);
+    TreeNode* rotateRight(TreeNode* y);
+    TreeNode* rotateLeft(TreeNode* x);
+    TreeNode* rebalance(TreeNode* node);
+    int countRangeRecursive(const TreeNode* node, int low, int high) const;
+
     GraphStep createSnapshot(const QString& message);
-    void populateSnapshot(TreeNode* node, GraphStep& step);
     void updatePositions();
-    void updatePositionsRecursive(TreeNode* node, int level, double x, double xOffset);
     void highlightNode(GraphStep& step, int nodeId, QColor color, QColor textColor = Qt::black);
+    void highlightNewNodes(GraphStep& step, int firstNewId, QColor color);
 };
@@ -0,0 +1,148 @@
+#include "batchqueries.h"
+#include "graphkernels.h"
+#include "threadpool.h"
+#include <QElapsedTimer>
+
+using GraphKernels::UNREACHABLE;
+
+BatchQueryEngine::BatchQueryEngine(const CsrGraph& graph, ThreadPool& pool)
+    : m_graph(graph),
+    m_pool(pool),
+    m_workspaces(pool.threadCount())
+{
+    for (Workspace& workspace : m_workspaces) {
+        workspace.dist.assign(graph.nodeCount, UNREACHABLE);
+        workspace.touched.reserve(graph.nodeCount);
+        workspace.open.reset(graph.nodeCount);
+    }
+}
+
+template<typename OnSettle>
+void BatchQueryEngine::search(Workspace& workspace, int source, Metric metric, OnSettle onSettle)
+{
+    std::vector<long long>& dist = workspace.dist;
+    std::vector<int>& touched = workspace.touched;
+    for (int node : touched) dist[node] = UNREACHABLE;
+    touched.clear();
+    workspace.open.clear();
+    workspace.searches++;
+
+    const int* targets = m_graph.targets.constData();
+    const int* weights = m_graph.weights.constData();
+    dist[source] = 0;
+    touched.push_back(source);
+
+    if (metric == HOPS) {
+        // The touched list doubles as the FIFO queue
+        for (size_t head = 0; head < touched.size(); ++head) {
+            int u = touched[head];
+            workspace.settled++;
+            if (onSettle(u, dist[u])) return;
+            for (int arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+                int v = targets[arc];
+                if (dist[v] != UNREACHABLE) continue;
+                dist[v] = dist[u] + 1;
+                touched.push_back(v);
+            }
+        }
+        return;
+    }
+
+    DaryHeap<long long>& open = workspace.open;
+    open.push(source, 0);
+    while (!open.isEmpty()) {
+        int u = open.pop();
+        workspace.settled++;
+        if (onSettle(u, dist[u])) return;
+        for (int arc = m_graph.arcBegin(u); arc < m_graph.arcEnd(u); ++arc) {
+            int v = targets[arc];
+            long long candidate = dist[u] + weights[arc];
+            if (dist[v] == UNREACHABLE) {
+                touched.push_back(v);
+            } else if (candidate >= dist[v]) {
+                continue;
+            }
+            dist[v] = candidate;
+            open.pushOrDecrease(v, candidate);
+        }
+    }
+}
+
+void BatchQueryEngine::beginBatch()
+{
+    for (Workspace& workspace : m_workspaces) {
+        workspace.settled = 0;
+        workspace.searches = 0;
+    }
+}
+
+void BatchQueryEngine::endBatch(Stats* stats, double ms, int steals) const
+{
+    if (!stats) return;
+    *stats = Stats();
+    stats->ms = ms;
+    stats->steals = steals;
+    for (const Workspace& workspace : m_workspaces) {
+        stats->searches += workspace.searches;
+        stats->settled += workspace.settled;
+        stats->searchesPerThread.append(workspace.searches);
+    }
+}
+
+QVector<long long> BatchQueryEngine::run(const QVector<Query>& queries, Metric metric, Stats* stats)
+{
+    QVector<long long> result(queries.size(), UNREACHABLE);
+    QElapsedTimer timer;
+    timer.start();
+    beginBatch();
+
+    long long* out = result.data();
+    int steals = m_pool.parallelForStealing(queries.size(), [&](int thread, int index) {
+        const Query& query = queries[index];
+        search(m_workspaces[thread], query.source, metric, [&](int node, long long distance) {
+            if (node != query.target) return false;
+            out[index] = distance;
+            return true;
+        });
+    });
+
+    endBatch(stats, timer.nsecsElapsed() / 1e6, steals);
+    return result;
+}
+
+QVector<long long> BatchQueryEngine::distanceTable(const QVector<int>& sources, const QVector<int>& targets, Metric metric,
+                                                   Stats* stats, QVector<int>* rowThreads)
+{
+    int columns = targets.size();
+    QVector<long long> table((long long)sources.size() * columns, UNREACHABLE);
+    if (rowThreads) rowThreads->fill(0, sources.size());
+    QElapsedTimer timer;
+    timer.start();
+    beginBatch();
+
+    // Column of each target node; a node listed twice is searched for once and copied
+    QVector<int> columnOf(m_graph.nodeCount, -1);
+    int distinct = 0;
+    for (int column = 0; column < columns; ++column) {
+        if (columnOf[targets[column]] < 0) {
+            columnOf[targets[column]] = column;
+            distinct++;
+        }
+    }
+
+    long long* out = table.data();
+    int steals = m_pool.parallelForStealing(sources.size(), [&](int thread, int row) {
+        long long* rowOut = out + (long long)row * columns;
+        int remaining = distinct;
+        search(m_workspaces[thread], sources[row], metric, [&](int node, long long distance) {
+            if (columnOf[node] < 0) return false;
+            rowOut[columnOf[node]] = distance;
+            return --remaining == 0;
+        });
+        for (int column = 0; column < columns; ++column) rowOut[column] = rowOut[columnOf[targets[column]]];
+        if (rowThreads) (*rowThreads)[row] = thread;
+    });
+
+    endBatch(stats, timer.nsecsElapsed() / 1e6, steals);
+    return table;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "csrgraph.h"
+#include "daryheap.h"
+#include <QVector>
+#include <vector>
+
+class ThreadPool;
+
+// Answers large batches of BFS or Dijkstra queries on one fixed graph. Queries
+// are sharded over the pool with work stealing, and each thread searches in its
+// own workspace (distances, heap, touched list) sized to the graph once and
+// reset through the nodes the last search touched, so no query allocates.
+class BatchQueryEngine
+{
+public:
+    enum Metric { HOPS, WEIGHTED }; // BFS hop counts or Dijkstra distances
+
+    struct Query {
+        int source;
+        int target;
+    };
+
+    struct Stats {
+        int searches = 0;
+        long long settled = 0; // Nodes settled over all searches
+        double ms = 0.0;
+        int steals = 0;        // Shares split between threads
+        QVector<int> searchesPerThread;
+    };
+
+    BatchQueryEngine(const CsrGraph& graph, ThreadPool& pool);
+
+    // Distance of each query, GraphKernels::UNREACHABLE where there is no path.
+    // Each search stops when it settles its target.
+    QVector<long long> run(const QVector<Query>& queries, Metric metric, Stats* stats = nullptr);
+
+    // Row-major sources x targets table, one search per source that stops once
+    // all targets are settled. 'rowThreads', if set, receives the thread of each row.
+    QVector<long long> distanceTable(const QVector<int>& sources, const QVector<int>& targets, Metric metric,
+                                     Stats* stats = nullptr, QVector<int>* rowThreads = nullptr);
+
+private:
+    struct alignas(64) Workspace {
+        std::vector<long long> dist;
+        std::vector<int> touched; // Nodes with a distance, in discovery order (the BFS queue)
+        DaryHeap<long long> open;
+        long long settled = 0;
+        int searches = 0;
+    };
+
+    const CsrGraph& m_graph;
+    ThreadPool& m_pool;
+    std::vector<Workspace> m_workspaces; // One per pool thread
+
+    // Runs one search from 'source', calling onSettle(node, distance) for each
+    // settled node until it returns true
+    template<typename OnSettle>
+    void search(Workspace& workspace, int source, Metric metric, OnSettle onSettle);
+
+    void beginBatch();
+    void endBatch(Stats* stats, double ms, int steals) const;
+};
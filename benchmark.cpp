@@ -0,0 +1,1470 @@
+#include "benchmark.h"
+#include "avl.h"
+#include "batchqueries.h"
+#include "btree.h"
+#include "contractionhierarchy.h"
+#include "csrgraph.h"
+#include "dynamicrepair.h"
+#include "ellermaze.h"
+#include "forcelayout.h"
+#include "graph.h"
+#include "graphanalytics.h"
+#include "graphgenerators.h"
+#include "graphkernels.h"
+#include "graphloader.h"
+#include "maxflow.h"
+#include "maze.h"
+#include "rbtree.h"
+#include "search.h"
+#include "splay.h"
+#include "threadpool.h"
+#include "treap.h"
+#include "workload.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMap>
+#include <QPair>
+#include <QQueue>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <thread>
+
+const int LOOKUP_COUNT = 1000000;
+const int RANGE_SCAN_COUNT = 20000;
+const int RANGE_SCAN_WIDTH = 200;    // Keys are even numbers, so ~100 hits per scan
+const int RANDOM_SEED = 12345;
+const int WORKLOAD_SEED = 54321; // Differs from RANDOM_SEED so hot keys are not correlated with insertion order
+const int WORKING_SET_SIZE = 1000;
+const int WORKING_SET_PHASE = 100000; // Accesses before the working set moves
+const double ZIPF_SKEW = 1.0;
+const int SEARCH_QUERY_COUNT = 1000000;
+const int SEARCH_TRACE_COUNT = 10000; // Queries re-run with access tracing
+const int CACHE_LINE_SIZE = 64;
+const int MAP_BASELINE_DIVISOR = 10; // The map-based baseline runs on a graph this many times smaller
+const double GENERATED_GRAPH_DEGREE = 20.0;
+const double GRID_EDGES_PER_NODE = 2.2; // 2 orthogonal links at 80% plus 2 diagonals at 30%
+const int WRITE_BUFFER_BYTES = 1 << 24;
+const int FLOYD_NAIVE_LIMIT = 2000;  // The naive loop gets too slow to time beyond this many nodes
+const int FLOYD_CHECK_SOURCES = 10; // Rows of large matrices checked against Dijkstra
+const int LAYOUT_EXACT_DIVISOR = 10;    // Exact O(V^2) layout forces are timed on a graph this many times smaller
+const double ROAD_GRAPH_DEGREE = 6.0;  // Sparse, road-like random geometric graphs for the contraction hierarchy
+
+// --- Private Helpers ---
+namespace Benchmark
+{
+QString formatNs(double ns)
+{
+    if (ns >= 1000.0) return QString::number(ns / 1000.0, 'f', 2) + " us";
+    return QString::number(ns, 'f', 1) + " ns";
+}
+
+// Times lookups and range scans against any tree exposing contains()/countRange()
+template <typename Tree>
+QString timeQueries(const QString& name, qint64 buildMs, const Tree& tree,
+                    const QVector<int>& lookups, const QVector<int>& scanStarts)
+{
+    QElapsedTimer timer;
+    long long hits = 0;
+
+    timer.start();
+    for (int key : lookups) hits += tree.contains(key) ? 1 : 0;
+    double lookupNs = (double)timer.nsecsElapsed() / lookups.size();
+
+    timer.restart();
+    for (int low : scanStarts) hits += tree.countRange(low, low + RANGE_SCAN_WIDTH);
+    double scanNs = (double)timer.nsecsElapsed() / scanStarts.size();
+
+    // 'hits' is reported so the compiler cannot drop the query loops
+    return "  " + name + ": build " + QString::number(buildMs) + " ms | lookup " + formatNs(lookupNs)
+           + " | range scan " + formatNs(scanNs) + " | hits " + QString::number(hits);
+}
+
+// One workload operation: insert (true) or remove (false) a key
+struct TreeOp {
+    bool insert;
+    int key;
+};
+
+// Runs the same key stream against any tree exposing insertSilent()/removeSilent()/stats()
+template <typename Tree>
+QString runWorkload(const QString& name, Tree& tree, const QVector<int>& prefill, const QVector<TreeOp>& ops)
+{
+    for (int key : prefill) tree.insertSilent(key);
+    tree.resetStats();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (const TreeOp& op : ops) {
+        if (op.insert) tree.insertSilent(op.key);
+        else tree.removeSilent(op.key);
+    }
+    double seconds = timer.nsecsElapsed() / 1e9;
+
+    const TreeStats& stats = tree.stats();
+    double perOp = 1.0 / ops.size();
+    return "  " + name + ": " + QString::number(ops.size() / seconds / 1e6, 'f', 2) + " Mops/s"
+           + " | rotations/op " + QString::number(stats.rotations * perOp, 'f', 3)
+           + " | recolors/op " + QString::number(stats.recolors * perOp, 'f', 3)
+           + " | comparisons/op " + QString::number(stats.comparisons * perOp, 'f', 1);
+}
+
+// Runs one workload on all three balancing schemes with identical input
+void compareSchemes(QStringList& report, const QString& title, const QVector<int>& prefill, const QVector<TreeOp>& ops)
+{
+    report.append(title);
+    {
+        AVL avl;
+        report.append(runWorkload("AVL", avl, prefill, ops));
+        avl.clear();
+    }
+    {
+        RedBlackTree rbTree;
+        report.append(runWorkload("Red-Black", rbTree, prefill, ops));
+    }
+    {
+        Treap treap(RANDOM_SEED);
+        report.append(runWorkload("Treap", treap, prefill, ops));
+    }
+}
+
+// Fills a tree with 'keys' (in the given order), then times findSilent() over 'accesses'
+template <typename Tree>
+QString runAccesses(const QString& name, Tree& tree, const QVector<int>& keys, const QVector<int>& accesses)
+{
+    for (int key : keys) tree.insertSilent(key);
+    tree.resetStats();
+
+    QElapsedTimer timer;
+    long long hits = 0;
+    timer.start();
+    for (int key : accesses) hits += tree.findSilent(key) ? 1 : 0;
+    double accessNs = (double)timer.nsecsElapsed() / accesses.size();
+
+    const TreeStats& stats = tree.stats();
+    double perAccess = 1.0 / accesses.size();
+    return "  " + name + ": " + formatNs(accessNs) + "/access"
+           + " | path length " + QString::number(stats.pathLength * perAccess, 'f', 2)
+           + " | comparisons " + QString::number(stats.comparisons * perAccess, 'f', 2)
+           + " | rotations " + QString::number(stats.rotations * perAccess, 'f', 2)
+           + " | hits " + QString::number(hits);
+}
+
+// Runs one access pattern on every tree that supports find(), with identical keys
+void compareAccesses(QStringList& report, const QString& title, const QVector<int>& keys, const QVector<int>& accesses)
+{
+    report.append(title);
+    {
+        AVL avl;
+        report.append(runAccesses("AVL", avl, keys, accesses));
+        avl.clear();
+    }
+    {
+        RedBlackTree rbTree;
+        report.append(runAccesses("Red-Black", rbTree, keys, accesses));
+    }
+    {
+        Treap treap(RANDOM_SEED);
+        report.append(runAccesses("Treap", treap, keys, accesses));
+    }
+    {
+        SplayTree splay;
+        report.append(runAccesses("Splay", splay, keys, accesses));
+    }
+}
+}
+
+namespace Benchmark
+{
+// Times find(target, probe) with an empty probe, then traces a sample of the
+// queries to count element accesses and distinct cache lines per search.
+// 'base' is the array the kernel's indices refer to.
+template <typename Find>
+QString timeSearch(const QString& name, const int* base, const QVector<int>& queries, Find find)
+{
+    QElapsedTimer timer;
+    long long hits = 0;
+    timer.start();
+    for (int target : queries) hits += (find(target, [](int) {}) >= 0) ? 1 : 0;
+    double searchNs = (double)timer.nsecsElapsed() / queries.size();
+
+    long long probes = 0;
+    long long lines = 0;
+    int traced = qMin(SEARCH_TRACE_COUNT, queries.size());
+    for (int i = 0; i < traced; ++i) {
+        quintptr seen[64];
+        int seenCount = 0;
+        find(queries[i], [&](int index) {
+            probes++;
+            quintptr line = reinterpret_cast<quintptr>(base + index) / CACHE_LINE_SIZE;
+            for (int j = 0; j < seenCount; ++j) {
+                if (seen[j] == line) return;
+            }
+            if (seenCount < 64) seen[seenCount++] = line;
+        });
+        lines += seenCount;
+    }
+
+    return "  " + name + ": " + formatNs(searchNs) + "/search"
+           + " | accesses " + QString::number((double)probes / traced, 'f', 1)
+           + " | cache lines " + QString::number((double)lines / traced, 'f', 1)
+           + " | hits " + QString::number(hits);
+}
+}
+
+namespace Benchmark
+{
+// Random undirected multigraph without self-loops, weights 1..9
+QVector<GraphEdge> randomEdges(int nodeCount, int edgeCount, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> nodeDist(0, nodeCount - 1);
+    std::uniform_int_distribution<int> weightDist(1, 9);
+    QVector<GraphEdge> edges(edgeCount);
+    for (GraphEdge& e : edges) {
+        e.from = nodeDist(rng);
+        do {
+            e.to = nodeDist(rng);
+        } while (e.to == e.from);
+        e.weight = weightDist(rng);
+    }
+    return edges;
+}
+
+// The map-of-lists layout Graph used before CSR, timed for BFS as a baseline
+QString mapBaseline(const QVector<GraphEdge>& edges, int nodeCount)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QMap<int, QList<int>> adjList;
+    QMap<QPair<int, int>, int> edgeWeights;
+    for (const GraphEdge& e : edges) {
+        adjList[e.from].append(e.to);
+        adjList[e.to].append(e.from);
+        edgeWeights[{qMin(e.from, e.to), qMax(e.from, e.to)}] = e.weight;
+    }
+    qint64 buildMs = timer.elapsed();
+
+    timer.restart();
+    QMap<int, int> level;
+    QQueue<int> queue;
+    level[0] = 0;
+    queue.enqueue(0);
+    long long weightSum = 0;
+    while (!queue.isEmpty()) {
+        int u = queue.dequeue();
+        for (int v : adjList[u]) {
+            weightSum += edgeWeights[{qMin(u, v), qMax(u, v)}]; // The lookup Dijkstra/Prim paid per arc
+            if (!level.contains(v)) {
+                level[v] = level[u] + 1;
+                queue.enqueue(v);
+            }
+        }
+    }
+    qint64 bfsMs = timer.elapsed();
+
+    return "  Map-based (" + QString::number(nodeCount) + " nodes, " + QString::number(edges.size()) + " edges): build "
+           + QString::number(buildMs) + " ms | BFS + weight lookups " + QString::number(bfsMs) + " ms | reached "
+           + QString::number(level.size()) + " (weights " + QString::number(weightSum) + ")";
+}
+
+// Writes 'graph' in one of the loader's formats, for load benchmarks
+bool writeGraphFile(const QString& path, const CsrGraph& graph, GraphLoader::Format format)
+{
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) return false;
+
+    QByteArray buffer;
+    auto flushIfFull = [&] {
+        if (buffer.size() < WRITE_BUFFER_BYTES) return;
+        file.write(buffer);
+        buffer.clear();
+    };
+
+    if (format == GraphLoader::Format::Dimacs) {
+        buffer.append("c benchmark graph\np sp " + QByteArray::number(graph.nodeCount) + " " + QByteArray::number(graph.arcCount()) + "\n");
+    } else if (format == GraphLoader::Format::Metis) {
+        buffer.append(QByteArray::number(graph.nodeCount) + " " + QByteArray::number(graph.edgeCount) + " 1\n");
+    } else {
+        buffer.append("# benchmark graph\n");
+    }
+
+    for (int u = 0; u < graph.nodeCount; ++u) {
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = graph.targets[arc];
+            QByteArray weight = QByteArray::number(graph.weights[arc]);
+            if (format == GraphLoader::Format::Dimacs) {
+                buffer.append("a " + QByteArray::number(u + 1) + " " + QByteArray::number(v + 1) + " " + weight + "\n");
+            } else if (format == GraphLoader::Format::Metis) {
+                buffer.append(QByteArray::number(v + 1) + " " + weight + " ");
+            } else if (u < v) {
+                buffer.append(QByteArray::number(u) + " " + QByteArray::number(v) + " " + weight + "\n");
+            }
+        }
+        if (format == GraphLoader::Format::Metis) buffer.append('\n');
+        flushIfFull();
+    }
+    file.write(buffer);
+    return true;
+}
+}
+
+// --- Public Functions ---
+
+QStringList Benchmark::treeLookups(const QList<int>& sizes)
+{
+    QStringList report;
+    report.append("Benchmark: B+-tree vs AVL (" + QString::number(LOOKUP_COUNT) + " lookups, "
+                  + QString::number(RANGE_SCAN_COUNT) + " range scans)");
+
+    std::mt19937 rng(RANDOM_SEED);
+
+    for (int n : sizes) {
+        // Even keys only, so roughly half of the random lookups miss
+        QVector<int> keys(n);
+        for (int i = 0; i < n; ++i) keys[i] = 2 * i;
+
+        std::uniform_int_distribution<int> keyDist(0, 2 * n - 1);
+        QVector<int> lookups(LOOKUP_COUNT);
+        for (int& key : lookups) key = keyDist(rng);
+        QVector<int> scanStarts(RANGE_SCAN_COUNT);
+        for (int& key : scanStarts) key = keyDist(rng);
+
+        report.append("n = " + QString::number(n));
+        QElapsedTimer timer;
+
+        {
+            AVL avl;
+            timer.start();
+            avl.build(keys);
+            qint64 buildMs = timer.elapsed();
+            report.append(timeQueries("AVL", buildMs, avl, lookups, scanStarts));
+            avl.clear();
+        }
+
+        for (int order : {8, 16, 32, 64, 128}) {
+            BTree btree(order);
+            timer.start();
+            btree.build(keys);
+            qint64 buildMs = timer.elapsed();
+            report.append(timeQueries("B+ order " + QString::number(order), buildMs, btree, lookups, scanStarts));
+        }
+    }
+
+    return report;
+}
+
+QStringList Benchmark::balancingSchemes(int operations)
+{
+    QStringList report;
+    report.append("Benchmark: AVL vs Red-Black vs Treap (" + QString::number(operations) + " operations)");
+
+    std::mt19937 rng(RANDOM_SEED);
+    std::uniform_int_distribution<int> keyDist(0, 4 * operations);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    // Insert-heavy: start empty, 90% inserts and 10% removes of random keys
+    QVector<TreeOp> insertHeavy(operations);
+    for (TreeOp& op : insertHeavy) op = {percent(rng) < 90, keyDist(rng)};
+    compareSchemes(report, "Insert-heavy (90% insert / 10% remove)", {}, insertHeavy);
+
+    // Delete-heavy: start full, 90% removes of present keys and 10% inserts
+    QVector<int> prefill(operations);
+    for (int& key : prefill) key = keyDist(rng);
+    QVector<int> removalOrder = prefill;
+    std::shuffle(removalOrder.begin(), removalOrder.end(), rng);
+
+    QVector<TreeOp> deleteHeavy(operations);
+    for (int i = 0; i < operations; ++i) {
+        bool insert = percent(rng) < 10;
+        deleteHeavy[i] = {insert, insert ? keyDist(rng) : removalOrder[i]};
+    }
+    compareSchemes(report, "Delete-heavy (10% insert / 90% remove)", prefill, deleteHeavy);
+
+    return report;
+}
+
+QStringList Benchmark::accessPatterns(int keyCount, int accesses)
+{
+    QStringList report;
+    report.append("Benchmark: find() under skewed access (" + QString::number(keyCount) + " keys, "
+                  + QString::number(accesses) + " accesses)");
+
+    // Keys 0..keyCount-1, inserted in random order so the unbalanced shapes are typical
+    QVector<int> keys(keyCount);
+    for (int i = 0; i < keyCount; ++i) keys[i] = i;
+    std::mt19937 rng(RANDOM_SEED);
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    compareAccesses(report, "Uniform", keys, Workload::uniform(accesses, keyCount, WORKLOAD_SEED));
+    compareAccesses(report, "Zipfian (skew " + QString::number(ZIPF_SKEW) + ")", keys,
+                    Workload::zipfian(accesses, keyCount, ZIPF_SKEW, WORKLOAD_SEED));
+    compareAccesses(report, "Sequential", keys, Workload::sequential(accesses, keyCount));
+    compareAccesses(report, "Working set (" + QString::number(WORKING_SET_SIZE) + " keys, moves every "
+                    + QString::number(WORKING_SET_PHASE) + " accesses)", keys,
+                    Workload::workingSet(accesses, keyCount, WORKING_SET_SIZE, WORKING_SET_PHASE, WORKLOAD_SEED));
+
+    return report;
+}
+
+QStringList Benchmark::searchLayouts(const QList<int>& sizes)
+{
+    QStringList report;
+    report.append("Benchmark: search layouts (" + QString::number(SEARCH_QUERY_COUNT) + " searches, cache lines = distinct "
+                  + QString::number(CACHE_LINE_SIZE) + "-byte lines touched per search)");
+
+    std::mt19937 rng(RANDOM_SEED);
+
+    for (int n : sizes) {
+        // Even keys only, so roughly half of the searches miss
+        QVector<int> sorted(n);
+        for (int i = 0; i < n; ++i) sorted[i] = 2 * i;
+
+        std::uniform_int_distribution<int> keyDist(0, 2 * n - 1);
+        QVector<int> queries(SEARCH_QUERY_COUNT);
+        for (int& key : queries) key = keyDist(rng);
+
+        report.append("n = " + QString::number(n));
+        const int* data = sorted.constData();
+        report.append(timeSearch("Binary", data, queries, [&](int target, auto probe) {
+            return Searching::binaryFind(data, n, target, probe);
+        }));
+        report.append(timeSearch("Branchless", data, queries, [&](int target, auto probe) {
+            return Searching::branchlessFind(data, n, target, probe);
+        }));
+        report.append(timeSearch("Interpolation", data, queries, [&](int target, auto probe) {
+            return Searching::interpolationFind(data, n, target, probe);
+        }));
+
+        {
+            QVector<int> layout = Searching::eytzingerLayout(sorted);
+            const int* layoutData = layout.constData();
+            report.append(timeSearch("Eytzinger", layoutData, queries, [&](int target, auto probe) {
+                return Searching::eytzingerFind(layoutData, n, target, probe);
+            }));
+        }
+        {
+            Searching::VebLayout veb = Searching::vebLayout(sorted);
+            report.append(timeSearch("van Emde Boas", veb.keys.constData(), queries, [&](int target, auto probe) {
+                return Searching::vebFind(veb, target, probe);
+            }));
+        }
+    }
+
+    return report;
+}
+
+QStringList Benchmark::csrGraph(int nodeCount, int edgeCount)
+{
+    QStringList report;
+    report.append("Benchmark: CSR graph (" + QString::number(nodeCount) + " nodes, " + QString::number(edgeCount) + " edges)");
+
+    std::mt19937 rng(RANDOM_SEED);
+    QElapsedTimer timer;
+
+    QVector<GraphEdge> edges = randomEdges(nodeCount, edgeCount, rng);
+    timer.start();
+    CsrGraph graph = CsrGraph::build(nodeCount, edges);
+    report.append("  Build: " + QString::number(timer.elapsed()) + " ms | "
+                  + QString::number(graph.memoryBytes() / (1024.0 * 1024.0), 'f', 1) + " MB");
+    edges.clear();
+
+    timer.restart();
+    QVector<int> levels = GraphKernels::bfsLevels(graph, 0);
+    int reached = std::count_if(levels.begin(), levels.end(), [](int l) { return l != GraphKernels::UNREACHABLE; });
+    report.append("  BFS: " + QString::number(timer.elapsed()) + " ms | reached " + QString::number(reached));
+
+    timer.restart();
+    QVector<long long> dist = GraphKernels::dijkstra(graph, 0);
+    long long maxDist = *std::max_element(dist.begin(), dist.end());
+    report.append("  Dijkstra: " + QString::number(timer.elapsed()) + " ms | eccentricity " + QString::number(maxDist));
+
+    timer.restart();
+    long long mstWeight = GraphKernels::primMstWeight(graph, 0);
+    report.append("  Prim MST: " + QString::number(timer.elapsed()) + " ms | weight " + QString::number(mstWeight));
+
+    int smallNodes = nodeCount / MAP_BASELINE_DIVISOR;
+    report.append(mapBaseline(randomEdges(smallNodes, edgeCount / MAP_BASELINE_DIVISOR, rng), smallNodes));
+
+    return report;
+}
+
+QStringList Benchmark::graphGenerators(int edgeCount)
+{
+    QStringList report;
+    report.append("Benchmark: graph generators (~" + QString::number(edgeCount) + " edges, seed " + QString::number(RANDOM_SEED) + ")");
+
+    QElapsedTimer timer;
+    auto time = [&](const QString& name, const std::function<CsrGraph()>& generate) {
+        timer.start();
+        CsrGraph graph = generate();
+        qint64 ms = timer.elapsed();
+        report.append("  " + name + ": " + QString::number(ms) + " ms | "
+                      + QString::number(graph.nodeCount) + " nodes, "
+                      + QString::number(graph.edgeCount) + " edges, avg degree "
+                      + QString::number(graph.nodeCount ? graph.arcCount() / (double)graph.nodeCount : 0.0, 'f', 1));
+    };
+
+    int gridNodes = (int)(edgeCount / GRID_EDGES_PER_NODE);
+    int sparseNodes = (int)(2.0 * edgeCount / GENERATED_GRAPH_DEGREE);
+    int scale = std::max(1, (int)std::lround(std::log2(std::max(2, sparseNodes))));
+
+    time("Grid", [&] { return GraphGenerators::grid(gridNodes, RANDOM_SEED); });
+    time("Random geometric", [&] {
+        return GraphGenerators::randomGeometric(sparseNodes, GraphGenerators::radiusForDegree(sparseNodes, GENERATED_GRAPH_DEGREE), RANDOM_SEED);
+    });
+    time("Erdos-Renyi", [&] {
+        return GraphGenerators::erdosRenyi(sparseNodes, GraphGenerators::probabilityForDegree(sparseNodes, GENERATED_GRAPH_DEGREE), RANDOM_SEED);
+    });
+    time("R-MAT", [&] { return GraphGenerators::rmat(scale, edgeCount, RANDOM_SEED); });
+
+    return report;
+}
+
+QStringList Benchmark::graphLoader(int edgeCount)
+{
+    QStringList report;
+    report.append("Benchmark: graph loader (~" + QString::number(edgeCount) + " edges)");
+
+    int nodeCount = (int)(2.0 * edgeCount / GENERATED_GRAPH_DEGREE);
+    CsrGraph source = GraphGenerators::erdosRenyi(nodeCount, GraphGenerators::probabilityForDegree(nodeCount, GENERATED_GRAPH_DEGREE), RANDOM_SEED);
+
+    // The suffixes let Graph::loadFromFile() detect each format as Load Graph... does
+    struct FileFormat {
+        QString name;
+        GraphLoader::Format format;
+        QString suffix;
+    };
+    const QList<FileFormat> formats = {
+        {"Edge list", GraphLoader::Format::EdgeList, "txt"},
+        {"DIMACS", GraphLoader::Format::Dimacs, "gr"},
+        {"METIS", GraphLoader::Format::Metis, "graph"},
+    };
+
+    QElapsedTimer timer;
+    for (const FileFormat& file : formats) {
+        QString path = QDir::tempPath() + "/algvis_benchmark_graph." + file.suffix;
+        if (!writeGraphFile(path, source, file.format)) {
+            report.append("  " + file.name + ": cannot write " + path);
+            continue;
+        }
+        qint64 bytes = QFile(path).size();
+
+        CsrGraph loaded;
+        QString error;
+        timer.start();
+        bool ok = GraphLoader::load(path, file.format, loaded, &error);
+        qint64 ms = timer.elapsed();
+
+        // The whole GUI path: parsing plus everything the graph derives on load
+        Graph graph;
+        timer.restart();
+        bool shown = ok && !graph.loadFromFile(path, &error).isEmpty();
+        qint64 totalMs = timer.elapsed();
+        QFile::remove(path);
+
+        if (!ok || !shown) {
+            report.append("  " + file.name + ": " + error);
+            continue;
+        }
+        report.append("  " + file.name + ": " + QString::number(ms) + " ms parse, " + QString::number(totalMs) + " ms loaded as a graph | "
+                      + QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB, "
+                      + QString::number(bytes / (1024.0 * 1024.0) / std::max<qint64>(1, ms) * 1000.0, 'f', 0) + " MB/s | "
+                      + QString::number(loaded.nodeCount) + " nodes, " + QString::number(loaded.arcCount()) + " arcs");
+    }
+    return report;
+}
+
+QStringList Benchmark::shortestPaths(int nodeCount, int queries)
+{
+    QStringList report;
+    report.append("Benchmark: shortest paths (random geometric graph, " + QString::number(nodeCount) + " nodes, "
+                  + QString::number(queries) + " queries)");
+
+    CsrGraph graph = GraphGenerators::randomGeometric(nodeCount, GraphGenerators::radiusForDegree(nodeCount, GENERATED_GRAPH_DEGREE), RANDOM_SEED);
+    double scale = GraphKernels::heuristicScale(graph);
+
+    std::mt19937 rng(WORKLOAD_SEED);
+    std::uniform_int_distribution<int> nodeDist(0, nodeCount - 1);
+    QVector<QPair<int, int>> pairs(queries);
+    for (auto& pair : pairs) pair = {nodeDist(rng), nodeDist(rng)};
+
+    QVector<long long> expected(queries);
+    QElapsedTimer timer;
+    timer.start();
+    long long reached = 0;
+    for (int i = 0; i < queries; ++i) {
+        QVector<long long> dist = GraphKernels::dijkstra(graph, pairs[i].first);
+        expected[i] = dist[pairs[i].second];
+        reached += std::count_if(dist.begin(), dist.end(), [](long long d) { return d != GraphKernels::UNREACHABLE; });
+    }
+    report.append("  Dijkstra, binary heap (full run): " + QString::number(timer.nsecsElapsed() / 1e6 / queries, 'f', 2) + " ms/query | settled "
+                  + QString::number(reached / queries));
+
+    auto time = [&](const QString& name, const std::function<GraphKernels::PathSearch(int, int)>& search) {
+        long long settled = 0;
+        int mismatches = 0;
+        timer.restart();
+        for (int i = 0; i < queries; ++i) {
+            GraphKernels::PathSearch result = search(pairs[i].first, pairs[i].second);
+            settled += result.settled;
+            if (result.distance != expected[i]) mismatches++;
+        }
+        report.append("  " + name + ": " + QString::number(timer.nsecsElapsed() / 1e6 / queries, 'f', 2) + " ms/query | settled "
+                      + QString::number(settled / queries) + " | wrong distances " + QString::number(mismatches));
+    };
+
+    time("Dijkstra, 4-ary heap (stop at target)", [&](int s, int t) { return GraphKernels::dijkstraPath(graph, s, t); });
+    time("A*", [&](int s, int t) { return GraphKernels::aStar(graph, s, t, scale); });
+    time("Bidirectional Dijkstra", [&](int s, int t) { return GraphKernels::bidirectionalDijkstra(graph, graph, s, t); });
+
+    return report;
+}
+
+QStringList Benchmark::parallelBfs(int edgeCount)
+{
+    QStringList report;
+    report.append("Benchmark: parallel BFS (about " + QString::number(edgeCount) + " edges, "
+                  + QString::number(std::thread::hardware_concurrency()) + " hardware threads)");
+
+    int gridNodes = (int)(edgeCount / GRID_EDGES_PER_NODE);
+    int sparseNodes = (int)(2.0 * edgeCount / GENERATED_GRAPH_DEGREE);
+    int scale = std::max(1, (int)std::lround(std::log2(std::max(2, sparseNodes))));
+
+    QList<int> threadCounts;
+    int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads < hardwareThreads; threads *= 2) threadCounts.append(threads);
+    threadCounts.append(hardwareThreads);
+
+    auto run = [&](const QString& name, const CsrGraph& graph) {
+        CsrGraph reversed = graph.directed ? graph.reversed() : CsrGraph();
+        const CsrGraph& reverse = graph.directed ? reversed : graph;
+
+        // Highest-degree node, so the search reaches the giant component
+        int source = 0;
+        for (int node = 1; node < graph.nodeCount; ++node) {
+            if (graph.degree(node) > graph.degree(source)) source = node;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        QVector<int> expected = GraphKernels::bfsLevels(graph, source);
+        double serialMs = timer.nsecsElapsed() / 1e6;
+        int depth = *std::max_element(expected.begin(), expected.end());
+        report.append("  " + name + " (" + QString::number(graph.nodeCount) + " nodes, " + QString::number(depth)
+                      + " levels): serial queue " + QString::number(serialMs, 'f', 1) + " ms");
+
+        for (int threads : threadCounts) {
+            ThreadPool pool(threads);
+            GraphKernels::BfsTrace trace;
+            timer.restart();
+            QVector<int> levels = GraphKernels::directionOptimizingBfs(graph, reverse, source, pool, &trace);
+            double ms = timer.nsecsElapsed() / 1e6;
+            int bottomUpLevels = std::count(trace.bottomUp.begin(), trace.bottomUp.end(), true);
+            report.append("    direction-optimizing, " + QString::number(threads) + " threads: "
+                          + QString::number(ms, 'f', 1) + " ms (x" + QString::number(serialMs / ms, 'f', 2)
+                          + ") | bottom-up levels " + QString::number(bottomUpLevels)
+                          + (levels == expected ? "" : " | LEVELS DIFFER"));
+        }
+    };
+
+    run("Grid", GraphGenerators::grid(gridNodes, RANDOM_SEED));
+    run("Erdos-Renyi", GraphGenerators::erdosRenyi(sparseNodes, GraphGenerators::probabilityForDegree(sparseNodes, GENERATED_GRAPH_DEGREE), RANDOM_SEED));
+    run("R-MAT", GraphGenerators::rmat(scale, edgeCount, RANDOM_SEED));
+
+    return report;
+}
+
+QStringList Benchmark::deltaStepping(int nodeCount, int sources)
+{
+    QStringList report;
+    int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    report.append("Benchmark: delta-stepping SSSP (" + QString::number(nodeCount) + " nodes, "
+                  + QString::number(sources) + " sources, " + QString::number(hardwareThreads) + " hardware threads)");
+
+    std::mt19937 rng(WORKLOAD_SEED);
+    auto run = [&](const QString& name, const CsrGraph& graph) {
+        std::uniform_int_distribution<int> nodeDist(0, graph.nodeCount - 1);
+        QVector<int> starts(sources);
+        for (int& start : starts) start = nodeDist(rng);
+
+        QElapsedTimer timer;
+        timer.start();
+        QVector<QVector<long long>> expected;
+        for (int start : starts) expected.append(GraphKernels::dijkstra(graph, start));
+        double dijkstraMs = timer.nsecsElapsed() / 1e6 / sources;
+        report.append("  " + name + " (" + QString::number(graph.arcCount()) + " arcs): Dijkstra "
+                      + QString::number(dijkstraMs, 'f', 1) + " ms/source");
+
+        auto time = [&](long long delta, ThreadPool& pool) {
+            int mismatches = 0;
+            timer.restart();
+            for (int i = 0; i < sources; ++i) {
+                if (GraphKernels::deltaStepping(graph, starts[i], delta, pool) != expected[i]) mismatches++;
+            }
+            double ms = timer.nsecsElapsed() / 1e6 / sources;
+            // Phase count from one traced run, outside the timing
+            GraphKernels::DeltaSteppingTrace trace;
+            GraphKernels::deltaStepping(graph, starts[0], delta, pool, &trace);
+            return "delta " + QString::number(delta) + ", " + QString::number(pool.threadCount()) + " threads: "
+                   + QString::number(ms, 'f', 1) + " ms/source (x" + QString::number(dijkstraMs / ms, 'f', 2)
+                   + ") | phases " + QString::number(trace.phases.size()) + " | wrong distances " + QString::number(mismatches);
+        };
+
+        // Small deltas mean many near-empty phases, large ones mean re-relaxing nodes
+        long long suggested = GraphKernels::suggestedDelta(graph);
+        ThreadPool& pool = ThreadPool::global();
+        std::vector<long long> deltas = {1, suggested / 2, suggested, suggested * 2, suggested * 8};
+        std::sort(deltas.begin(), deltas.end());
+        deltas.erase(std::unique(deltas.begin(), deltas.end()), deltas.end());
+        for (long long delta : deltas) {
+            if (delta >= 1) report.append("    " + time(delta, pool));
+        }
+
+        for (int threads = 1; threads < hardwareThreads; threads *= 2) {
+            ThreadPool sized(threads);
+            report.append("    " + time(suggested, sized));
+        }
+    };
+
+    run("Random geometric", GraphGenerators::randomGeometric(nodeCount, GraphGenerators::radiusForDegree(nodeCount, GENERATED_GRAPH_DEGREE), RANDOM_SEED));
+    int scale = std::max(1, (int)std::lround(std::log2(std::max(2, nodeCount))));
+    run("R-MAT", GraphGenerators::rmat(scale, (int)(nodeCount * GENERATED_GRAPH_DEGREE / 2), RANDOM_SEED));
+
+    return report;
+}
+
+QStringList Benchmark::spanningTrees(int nodeCount)
+{
+    QStringList report;
+    int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    report.append("Benchmark: minimum spanning trees (" + QString::number(nodeCount) + " nodes, "
+                  + QString::number(hardwareThreads) + " hardware threads)");
+
+    auto run = [&](const QString& name, const CsrGraph& graph) {
+        QElapsedTimer timer;
+        timer.start();
+        long long primWeight = GraphKernels::primMstWeight(graph, 0);
+        qint64 primMs = timer.elapsed();
+
+        timer.restart();
+        GraphKernels::SpanningForest reference = GraphKernels::kruskal(graph, ThreadPool::global());
+        qint64 kruskalMs = timer.elapsed();
+
+        report.append("  " + name + " (" + QString::number(graph.edgeCount) + " edges, "
+                      + QString::number(reference.components) + " components):");
+        // Prim only spans the component of node 0, so its weight is comparable on connected graphs
+        report.append("    Prim: " + QString::number(primMs) + " ms | weight " + QString::number(primWeight)
+                      + (reference.components == 1 ? "" : " (component of node 0)"));
+        report.append("    Kruskal, " + QString::number(hardwareThreads) + " threads: " + QString::number(kruskalMs)
+                      + " ms | weight " + QString::number(reference.weight));
+
+        QList<int> threadCounts;
+        for (int threads = 1; threads < hardwareThreads; threads *= 2) threadCounts.append(threads);
+        threadCounts.append(hardwareThreads);
+        for (int threads : threadCounts) {
+            ThreadPool pool(threads);
+            QVector<int> roundEnds;
+            timer.restart();
+            GraphKernels::SpanningForest forest = GraphKernels::boruvka(graph, pool, &roundEnds);
+            report.append("    Boruvka, " + QString::number(threads) + " threads: " + QString::number(timer.elapsed())
+                          + " ms | weight " + QString::number(forest.weight) + " | rounds " + QString::number(roundEnds.size())
+                          + (forest.weight == reference.weight && forest.edges.size() == reference.edges.size() ? "" : " | WEIGHT DIFFERS"));
+        }
+    };
+
+    run("Grid", GraphGenerators::grid(nodeCount, RANDOM_SEED));
+    run("Random geometric", GraphGenerators::randomGeometric(nodeCount, GraphGenerators::radiusForDegree(nodeCount, GENERATED_GRAPH_DEGREE), RANDOM_SEED));
+    run("Erdos-Renyi", GraphGenerators::erdosRenyi(nodeCount, GraphGenerators::probabilityForDegree(nodeCount, GENERATED_GRAPH_DEGREE), RANDOM_SEED));
+
+    return report;
+}
+
+QStringList Benchmark::components(int nodeCount)
+{
+    QStringList report;
+    report.append("Benchmark: DFS and components (" + QString::number(nodeCount) + " nodes)");
+    QElapsedTimer timer;
+
+    // A single path is the deepest DFS possible: one stack frame per node
+    QVector<GraphEdge> chainEdges;
+    chainEdges.reserve(nodeCount - 1);
+    for (int u = 0; u + 1 < nodeCount; ++u) chainEdges.append({u, u + 1, 1});
+    CsrGraph chain = CsrGraph::build(nodeCount, chainEdges, true);
+    timer.start();
+    QVector<int> order = GraphKernels::dfsOrder(chain, 0);
+    report.append("  DFS on a " + QString::number(nodeCount) + "-node chain: " + QString::number(timer.elapsed())
+                  + " ms | depth " + QString::number(order.size()));
+
+    auto run = [&](const QString& name, const CsrGraph& graph) {
+        timer.restart();
+        QVector<int> reached = GraphKernels::dfsOrder(graph, 0);
+        qint64 dfsMs = timer.elapsed();
+
+        timer.restart();
+        GraphKernels::Components strong = GraphKernels::stronglyConnectedComponents(graph);
+        qint64 sccMs = timer.elapsed();
+
+        timer.restart();
+        GraphKernels::Components weak = GraphKernels::connectedComponents(graph);
+        qint64 ccMs = timer.elapsed();
+
+        timer.restart();
+        CsrGraph condensed = GraphKernels::condensation(graph, strong);
+        qint64 condenseMs = timer.elapsed();
+
+        QVector<int> sizes(strong.count, 0);
+        for (int c : strong.component) sizes[c]++;
+        int largest = strong.count ? *std::max_element(sizes.begin(), sizes.end()) : 0;
+
+        report.append("  " + name + " (" + QString::number(graph.arcCount()) + " arcs):");
+        report.append("    DFS from node 0: " + QString::number(dfsMs) + " ms | reached " + QString::number(reached.size()));
+        report.append("    Tarjan SCC: " + QString::number(sccMs) + " ms | " + QString::number(strong.count)
+                      + " components, largest " + QString::number(largest));
+        report.append("    Union-find components: " + QString::number(ccMs) + " ms | " + QString::number(weak.count) + " components");
+        report.append("    Condensation: " + QString::number(condenseMs) + " ms | " + QString::number(condensed.nodeCount)
+                      + " nodes, " + QString::number(condensed.edgeCount) + " arcs");
+    };
+
+    run("Grid", GraphGenerators::grid(nodeCount, RANDOM_SEED));
+
+    // R-MAT with every edge kept in one direction only, so SCCs are nontrivial
+    int scale = std::max(1, (int)std::lround(std::log2(std::max(2, nodeCount))));
+    CsrGraph rmat = GraphGenerators::rmat(scale, (int)(nodeCount * GENERATED_GRAPH_DEGREE / 4), RANDOM_SEED);
+    QVector<GraphEdge> arcs;
+    arcs.reserve(rmat.edgeCount);
+    for (int u = 0; u < rmat.nodeCount; ++u) {
+        for (int arc = rmat.arcBegin(u); arc < rmat.arcEnd(u); ++arc) {
+            if (u < rmat.targets[arc]) arcs.append({u, rmat.targets[arc], rmat.weights[arc]});
+        }
+    }
+    std::mt19937 rng(WORKLOAD_SEED);
+    for (GraphEdge& edge : arcs) {
+        if (rng() & 1) std::swap(edge.from, edge.to);
+    }
+    run("Directed R-MAT", CsrGraph::build(rmat.nodeCount, arcs, true));
+
+    return report;
+}
+
+QStringList Benchmark::floydWarshall(const QList<int>& sizes)
+{
+    QStringList report;
+    int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    report.append("Benchmark: Floyd-Warshall (random geometric graphs, " + QString::number(hardwareThreads)
+                  + " hardware threads; GFLOP/s counts the add and min of each of the V^3 updates)");
+
+    auto gflops = [](int n, double ms) { return 2.0 * n * n * (double)n / (ms * 1e6); };
+    auto line = [&](const QString& name, int n, double ms) {
+        return "    " + name + ": " + QString::number(ms / 1000.0, 'f', 2) + " s | "
+               + QString::number(gflops(n, ms), 'f', 2) + " GFLOP/s";
+    };
+
+    for (int n : sizes) {
+        CsrGraph graph = GraphGenerators::randomGeometric(n, GraphGenerators::radiusForDegree(n, GENERATED_GRAPH_DEGREE), RANDOM_SEED);
+        QVector<int> weights = GraphKernels::weightMatrix(graph);
+        report.append("  V = " + QString::number(n) + " (" + QString::number((double)n * n * sizeof(int) / (1024 * 1024), 'f', 0) + " MB matrix):");
+
+        QElapsedTimer timer;
+        QVector<int> naive;
+        if (n <= FLOYD_NAIVE_LIMIT) {
+            naive = weights;
+            timer.start();
+            GraphKernels::floydWarshallNaive(naive, n);
+            report.append(line("Naive triple loop", n, timer.nsecsElapsed() / 1e6));
+        }
+
+        QList<int> threadCounts;
+        for (int threads = 1; threads < hardwareThreads; threads *= 2) threadCounts.append(threads);
+        threadCounts.append(hardwareThreads);
+
+        QVector<int> blocked;
+        for (int threads : threadCounts) {
+            ThreadPool pool(threads);
+            blocked = weights;
+            timer.restart();
+            GraphKernels::floydWarshallBlocked(blocked, n, pool);
+            report.append(line("Blocked " + QString::number(GraphKernels::FLOYD_TILE) + "x" + QString::number(GraphKernels::FLOYD_TILE)
+                               + ", " + QString::number(threads) + " threads", n, timer.nsecsElapsed() / 1e6));
+        }
+
+        // Check the whole matrix against the naive one, or sample rows against Dijkstra
+        int wrongRows = 0;
+        if (!naive.isEmpty()) {
+            for (int i = 0; i < n; ++i) {
+                if (!std::equal(blocked.begin() + (size_t)i * n, blocked.begin() + (size_t)(i + 1) * n, naive.begin() + (size_t)i * n)) wrongRows++;
+            }
+        } else {
+            for (int sample = 0; sample < FLOYD_CHECK_SOURCES; ++sample) {
+                int source = (int)((long long)sample * n / FLOYD_CHECK_SOURCES);
+                QVector<long long> dist = GraphKernels::dijkstra(graph, source);
+                for (int j = 0; j < n; ++j) {
+                    long long expected = dist[j] == GraphKernels::UNREACHABLE ? GraphKernels::NO_PATH : dist[j];
+                    if (blocked[(size_t)source * n + j] != expected) {
+                        wrongRows++;
+                        break;
+                    }
+                }
+            }
+        }
+        report.append("    Rows differing from " + QString(naive.isEmpty() ? "Dijkstra (sampled)" : "the naive loop")
+                      + ": " + QString::number(wrongRows));
+    }
+    return report;
+}
+
+QStringList Benchmark::contractionHierarchy(int nodeCount, int queries)
+{
+    QStringList report;
+    report.append("Benchmark: contraction hierarchy (" + QString::number(nodeCount) + " nodes, "
+                  + QString::number(queries) + " random queries per graph)");
+
+    std::mt19937 rng(WORKLOAD_SEED);
+    std::uniform_int_distribution<int> nodeDist(0, nodeCount - 1);
+    QVector<QPair<int, int>> pairs(queries);
+    for (auto& pair : pairs) pair = {nodeDist(rng), nodeDist(rng)};
+
+    auto run = [&](const QString& name, const CsrGraph& graph) {
+        report.append("  " + name + " (" + QString::number(graph.edgeCount) + " edges):");
+
+        QElapsedTimer timer;
+        timer.start();
+        ContractionHierarchy hierarchy;
+        hierarchy.build(graph);
+        double buildMs = timer.nsecsElapsed() / 1e6;
+        report.append("    Preprocessing: " + QString::number(buildMs / 1000.0, 'f', 2) + " s | "
+                      + QString::number(hierarchy.shortcutCount()) + " shortcuts ("
+                      + QString::number((double)hierarchy.shortcutCount() / std::max(1, graph.edgeCount), 'f', 2) + " per edge)");
+
+        QVector<long long> expected(queries);
+        auto time = [&](const QString& searchName, const std::function<GraphKernels::PathSearch(int, int)>& search) {
+            long long settled = 0;
+            int mismatches = 0;
+            timer.restart();
+            for (int i = 0; i < queries; ++i) {
+                GraphKernels::PathSearch result = search(pairs[i].first, pairs[i].second);
+                settled += result.settled;
+                if (result.distance != expected[i]) mismatches++;
+            }
+            double ms = timer.nsecsElapsed() / 1e6 / queries;
+            report.append("    " + searchName + ": " + formatNs(ms * 1e6) + "/query | settled "
+                          + QString::number(settled / queries) + " | wrong distances " + QString::number(mismatches));
+            return ms;
+        };
+
+        for (int i = 0; i < queries; ++i) expected[i] = GraphKernels::dijkstraPath(graph, pairs[i].first, pairs[i].second).distance;
+        double dijkstraMs = time("Dijkstra (stop at target)", [&](int s, int t) { return GraphKernels::dijkstraPath(graph, s, t); });
+        time("Bidirectional Dijkstra", [&](int s, int t) { return GraphKernels::bidirectionalDijkstra(graph, graph, s, t); });
+        double hierarchyMs = time("Contraction hierarchy", [&](int s, int t) { return hierarchy.query(s, t); });
+
+        // Preprocessing pays for itself once the per-query savings add up to it
+        QString breakEven = dijkstraMs > hierarchyMs ? QString::number((long long)std::ceil(buildMs / (dijkstraMs - hierarchyMs))) : "never";
+        report.append("    Query speedup over Dijkstra: x" + QString::number(dijkstraMs / hierarchyMs, 'f', 1)
+                      + " | preprocessing repaid after " + breakEven + " queries");
+    };
+
+    run("Grid", GraphGenerators::grid(nodeCount, RANDOM_SEED));
+    run("Random geometric", GraphGenerators::randomGeometric(nodeCount, GraphGenerators::radiusForDegree(nodeCount, ROAD_GRAPH_DEGREE), RANDOM_SEED));
+    return report;
+}
+
+QStringList Benchmark::dynamicUpdates(int nodeCount, int updates)
+{
+    QStringList report;
+    report.append("Benchmark: dynamic updates through Graph (weighted grid, " + QString::number(nodeCount) + " nodes, "
+                  + QString::number(updates) + " each of random inserts, deletes and reweights)");
+
+    Graph graph;
+    graph.generateRandomGraph(nodeCount, RANDOM_SEED);
+    int target = nodeCount - 1;
+
+    // The full reruns the updates stand in for, recorded steps included
+    QElapsedTimer timer;
+    timer.start();
+    int pathSteps = graph.dijkstra(0, target).size();
+    double pathsMs = timer.nsecsElapsed() / 1e6;
+    timer.restart();
+    int forestSteps = graph.primMST(0).size();
+    double forestMs = timer.nsecsElapsed() / 1e6;
+    double rerunNs = (pathsMs + forestMs) * 1e6;
+    report.append("  From scratch: dijkstra() " + QString::number(pathsMs, 'f', 1) + " ms (" + QString::number(pathSteps)
+                  + " steps), primMST() " + QString::number(forestMs, 'f', 1) + " ms (" + QString::number(forestSteps) + " steps)");
+
+    // Mirrors Graph's edge numbering (deletes swap-remove) to pick edges and weights
+    QVector<GraphEdge> edges = graph.csr().edgeList();
+    std::mt19937 rng(WORKLOAD_SEED);
+    std::uniform_int_distribution<int> nodeDist(0, nodeCount - 2);
+    std::uniform_int_distribution<int> weightDist(1, 9);
+    auto randomEdge = [&]() { return std::uniform_int_distribution<int>(0, edges.size() - 1)(rng); };
+
+    // The first update creates both views, O(V + E) once; later ones only log what they change
+    graph.reweightEdge(0, edges[0].weight);
+
+    double insertNs = 0.0;
+    double deleteNs = 0.0;
+    double reweightNs = 0.0;
+    for (int update = 0; update < updates; ++update) {
+        // A short edge between index neighbors, as an editor would add one
+        int from = nodeDist(rng);
+        GraphEdge inserted = {from, from + 1, weightDist(rng)};
+        timer.restart();
+        graph.insertEdge(inserted.from, inserted.to, inserted.weight);
+        insertNs += timer.nsecsElapsed();
+        edges.append(inserted);
+
+        int edge = randomEdge();
+        timer.restart();
+        graph.deleteEdge(edge);
+        deleteNs += timer.nsecsElapsed();
+        edges[edge] = edges.last();
+        edges.removeLast();
+
+        // Half the reweights lighten an edge, half make it heavier
+        edge = randomEdge();
+        int oldWeight = edges[edge].weight;
+        int weight = update % 2 == 0 ? std::max(1, oldWeight / 2) : oldWeight * 2;
+        if (weight == oldWeight) weight++;
+        timer.restart();
+        graph.reweightEdge(edge, weight);
+        reweightNs += timer.nsecsElapsed();
+        edges[edge].weight = weight;
+    }
+
+    auto line = [&](const QString& name, double ns) {
+        return "  " + name + formatNs(ns / updates) + "/update (x" + QString::number(rerunNs / (ns / updates), 'f', 0)
+               + " faster than both reruns)";
+    };
+    report.append(line("insertEdge(): ", insertNs));
+    report.append(line("deleteEdge(): ", deleteNs));
+    report.append(line("reweightEdge(): ", reweightNs));
+
+    // Inserts and deletes sit in the CSR overlay until it is compacted
+    CsrGraph compacted = graph.csr();
+    int overlay = compacted.overlaySize();
+    timer.restart();
+    compacted.compact();
+    report.append("  Overlay: " + QString::number(overlay) + " arcs after the updates | compact() "
+                  + QString::number(timer.nsecsElapsed() / 1e6, 'f', 1) + " ms, once per " + QString::number(compacted.arcCount() / 8)
+                  + " overlay arcs");
+
+    // Both repaired results must match a recomputation on the final graph
+    DynamicShortestPaths freshPaths;
+    freshPaths.compute(compacted, 0);
+    int wrongDistances = 0;
+    for (int node = 0; node < nodeCount; ++node) {
+        if (freshPaths.distance(node) != graph.repairedPaths().distance(node)) wrongDistances++;
+    }
+    DynamicSpanningForest freshForest;
+    freshForest.compute(compacted);
+    long long forestWeight = graph.repairedForest().weight();
+    report.append("  Check against recomputation: wrong distances " + QString::number(wrongDistances) + " | forest weight "
+                  + QString::number(forestWeight) + (forestWeight == freshForest.weight() ? " (matches)" : " (EXPECTED "
+                  + QString::number(freshForest.weight()) + ")"));
+    return report;
+}
+
+QStringList Benchmark::batchQueries(int nodeCount, int queries, int tableSide)
+{
+    QStringList report;
+    report.append("Benchmark: batch queries (random geometric graph, " + QString::number(nodeCount) + " nodes, "
+                  + QString::number(queries) + " random queries, " + QString::number(std::thread::hardware_concurrency())
+                  + " hardware threads)");
+
+    CsrGraph graph = GraphGenerators::randomGeometric(nodeCount, GraphGenerators::radiusForDegree(nodeCount, ROAD_GRAPH_DEGREE), RANDOM_SEED);
+
+    std::mt19937 rng(WORKLOAD_SEED);
+    std::uniform_int_distribution<int> nodeDist(0, nodeCount - 1);
+    QVector<BatchQueryEngine::Query> batch(queries);
+    for (BatchQueryEngine::Query& query : batch) query = {nodeDist(rng), nodeDist(rng)};
+
+    QList<int> threadCounts;
+    int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads < hardwareThreads; threads *= 2) threadCounts.append(threads);
+    threadCounts.append(hardwareThreads);
+
+    // Baseline: one query after another, each allocating its own search state
+    QElapsedTimer timer;
+    timer.start();
+    QVector<long long> expected(queries);
+    for (int i = 0; i < queries; ++i) expected[i] = GraphKernels::dijkstraPath(graph, batch[i].source, batch[i].target).distance;
+    double serialMs = timer.nsecsElapsed() / 1e6;
+    report.append("  Dijkstra one by one: " + QString::number(serialMs, 'f', 1) + " ms (" + formatNs(serialMs * 1e6 / queries) + "/query)");
+
+    auto wrong = [](const QVector<long long>& result, const QVector<long long>& reference) {
+        int mismatches = 0;
+        for (int i = 0; i < result.size(); ++i) {
+            if (result[i] != reference[i]) mismatches++;
+        }
+        return mismatches;
+    };
+
+    auto run = [&](const QString& name, BatchQueryEngine::Metric metric, const QVector<long long>& reference, double baselineMs) {
+        report.append("  " + name + ":");
+        for (int threads : threadCounts) {
+            ThreadPool pool(threads);
+            BatchQueryEngine engine(graph, pool);
+            BatchQueryEngine::Stats stats;
+            QVector<long long> result = engine.run(batch, metric, &stats);
+            auto spread = std::minmax_element(stats.searchesPerThread.begin(), stats.searchesPerThread.end());
+            report.append("    " + QString::number(threads) + " threads: " + QString::number(stats.ms, 'f', 1) + " ms (x"
+                          + QString::number(baselineMs / stats.ms, 'f', 2) + ") | " + QString::number(stats.steals)
+                          + " steals, " + QString::number(*spread.first) + "-" + QString::number(*spread.second)
+                          + " queries per thread | wrong distances " + QString::number(wrong(result, reference)));
+        }
+    };
+    run("Batch Dijkstra", BatchQueryEngine::WEIGHTED, expected, serialMs);
+
+    // Hop counts have no allocating point-to-point kernel; the one-thread batch is the reference
+    ThreadPool single(1);
+    BatchQueryEngine singleEngine(graph, single);
+    BatchQueryEngine::Stats singleStats;
+    QVector<long long> expectedHops = singleEngine.run(batch, BatchQueryEngine::HOPS, &singleStats);
+    run("Batch BFS", BatchQueryEngine::HOPS, expectedHops, singleStats.ms);
+
+    // The same pairs as a table: one search per source instead of one per pair
+    int side = std::min(tableSide, nodeCount);
+    QVector<int> sources(side);
+    QVector<int> targets(side);
+    for (int i = 0; i < side; ++i) {
+        sources[i] = nodeDist(rng);
+        targets[i] = nodeDist(rng);
+    }
+    QVector<BatchQueryEngine::Query> pairs;
+    for (int source : sources) {
+        for (int target : targets) pairs.append({source, target});
+    }
+    ThreadPool& pool = ThreadPool::global();
+    BatchQueryEngine engine(graph, pool);
+    BatchQueryEngine::Stats pairStats;
+    QVector<long long> pairDistances = engine.run(pairs, BatchQueryEngine::WEIGHTED, &pairStats);
+    BatchQueryEngine::Stats tableStats;
+    QVector<long long> table = engine.distanceTable(sources, targets, BatchQueryEngine::WEIGHTED, &tableStats);
+    report.append("  " + QString::number(side) + " x " + QString::number(side) + " distance table, "
+                  + QString::number(pool.threadCount()) + " threads: " + QString::number(tableStats.ms, 'f', 1)
+                  + " ms, " + QString::number(tableStats.settled) + " nodes settled | as " + QString::number(pairs.size())
+                  + " separate queries: " + QString::number(pairStats.ms, 'f', 1) + " ms, "
+                  + QString::number(pairStats.settled) + " settled | wrong distances " + QString::number(wrong(table, pairDistances)));
+    return report;
+}
+
+QStringList Benchmark::maxFlow(const QList<int>& edgeCounts)
+{
+    QStringList report;
+    report.append("Benchmark: max flow (edge weights as capacities)");
+
+    auto run = [&](const QString& name, const CsrGraph& graph, int source, int sink) {
+        QElapsedTimer timer;
+        timer.start();
+        FlowNetwork network = FlowNetwork::build(graph);
+        double buildMs = timer.nsecsElapsed() / 1e6;
+        report.append("    " + name + " (" + QString::number(graph.nodeCount) + " nodes, " + QString::number(graph.edgeCount)
+                      + " edges, Node " + QString::number(source) + " to Node " + QString::number(sink) + "): residual network "
+                      + QString::number(buildMs, 'f', 1) + " ms");
+
+        long long expected = -1;
+        auto time = [&](const QString& algorithm, bool augmenting, const std::function<MaxFlow::Result()>& solve) {
+            timer.restart();
+            MaxFlow::Result result = solve();
+            double ms = timer.nsecsElapsed() / 1e6;
+
+            // The edges leaving the source side must add up to the flow value
+            long long cut = 0;
+            QVector<GraphEdge> edges = graph.edgeList();
+            for (const GraphEdge& e : edges) {
+                if (result.sourceSide[e.from] != result.sourceSide[e.to] && (result.sourceSide[e.from] || !graph.directed)) cut += e.weight;
+            }
+            if (expected < 0) expected = result.value;
+            QString stats = augmenting ? QString::number(result.phases) + " phases, " + QString::number(result.augmentations) + " augmenting paths"
+                                              : QString::number(result.pushes) + " pushes, " + QString::number(result.relabels) + " relabels, "
+                                                + QString::number(result.globalRelabels) + " global relabels";
+            report.append("      " + algorithm + ": " + QString::number(ms, 'f', 1) + " ms | flow " + QString::number(result.value)
+                          + " | " + stats + (result.value == expected && cut == result.value ? "" : " | MISMATCH (cut " + QString::number(cut) + ")"));
+        };
+        time("Dinic", true, [&] { return MaxFlow::dinic(network, source, sink); });
+        time("Push-relabel, FIFO", false, [&] { return MaxFlow::pushRelabel(network, source, sink, MaxFlow::FIFO); });
+        time("Push-relabel, highest label", false, [&] { return MaxFlow::pushRelabel(network, source, sink, MaxFlow::HIGHEST_LABEL); });
+    };
+
+    for (int edgeCount : edgeCounts) {
+        report.append("  About " + QString::number(edgeCount) + " edges:");
+
+        // Opposite corners, so the flow crosses the whole grid
+        int gridNodes = (int)(edgeCount / GRID_EDGES_PER_NODE);
+        run("Grid", GraphGenerators::grid(gridNodes, RANDOM_SEED), 0, gridNodes - 1);
+
+        // Leftmost to rightmost node of the largest component
+        int geometricNodes = (int)(2.0 * edgeCount / ROAD_GRAPH_DEGREE);
+        CsrGraph geometric = GraphGenerators::randomGeometric(geometricNodes, GraphGenerators::radiusForDegree(geometricNodes, ROAD_GRAPH_DEGREE), RANDOM_SEED);
+        GraphKernels::Components components = GraphKernels::connectedComponents(geometric);
+        QVector<int> sizes(components.count, 0);
+        for (int c : components.component) sizes[c]++;
+        int largest = std::max_element(sizes.begin(), sizes.end()) - sizes.begin();
+        int left = -1;
+        int right = -1;
+        for (int node = 0; node < geometricNodes; ++node) {
+            if (components.component[node] != largest) continue;
+            if (left < 0 || geometric.xs[node] < geometric.xs[left]) left = node;
+            if (right < 0 || geometric.xs[node] > geometric.xs[right]) right = node;
+        }
+        run("Random geometric", geometric, left, right);
+
+        // Every edge directed from lower to higher id; between the two hubs
+        int scale = std::max(1, (int)std::lround(std::log2(std::max(2.0, 2.0 * edgeCount / GENERATED_GRAPH_DEGREE))));
+        CsrGraph rmat = GraphGenerators::rmat(scale, edgeCount, RANDOM_SEED);
+        QVector<GraphEdge> edges = rmat.edgeList();
+        for (GraphEdge& e : edges) {
+            if (e.from > e.to) std::swap(e.from, e.to);
+        }
+        CsrGraph directed = CsrGraph::build(rmat.nodeCount, edges, true);
+        QVector<int> hubs(rmat.nodeCount);
+        for (int node = 0; node < rmat.nodeCount; ++node) hubs[node] = node;
+        std::partial_sort(hubs.begin(), hubs.begin() + 2, hubs.end(), [&](int a, int b) { return rmat.degree(a) > rmat.degree(b); });
+        run("R-MAT, directed", directed, std::min(hubs[0], hubs[1]), std::max(hubs[0], hubs[1]));
+    }
+    return report;
+}
+
+QStringList Benchmark::pageRank(int edgeCount)
+{
+    QStringList report;
+    int scale = std::max(1, (int)std::lround(std::log2(std::max(2.0, 2.0 * edgeCount / GENERATED_GRAPH_DEGREE))));
+    CsrGraph undirected = GraphGenerators::rmat(scale, edgeCount, RANDOM_SEED);
+    report.append("Benchmark: iterative analytics (R-MAT, " + QString::number(undirected.nodeCount) + " nodes, "
+                  + QString::number(undirected.edgeCount) + " edges, " + QString::number(std::thread::hardware_concurrency())
+                  + " hardware threads)");
+
+    // PageRank needs direction: each edge keeps or flips its orientation at random
+    std::mt19937 rng(WORKLOAD_SEED);
+    QVector<GraphEdge> edges = undirected.edgeList();
+    for (GraphEdge& e : edges) {
+        if (rng() & 1) std::swap(e.from, e.to);
+    }
+    CsrGraph directed = CsrGraph::build(undirected.nodeCount, edges, true);
+    CsrGraph reverse = directed.reversed();
+    int hub = 0;
+    for (int node = 1; node < directed.nodeCount; ++node) {
+        if (undirected.degree(node) > undirected.degree(hub)) hub = node;
+    }
+
+    QList<int> threadCounts;
+    int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads < hardwareThreads; threads *= 2) threadCounts.append(threads);
+    threadCounts.append(hardwareThreads);
+
+    auto line = [](int threads, double ms, const GraphAnalytics::Convergence& convergence, double baselineMs) {
+        return "    " + QString::number(threads) + " threads: " + QString::number(ms, 'f', 1) + " ms (x"
+               + QString::number(baselineMs / ms, 'f', 2) + ") | " + QString::number(convergence.iterations)
+               + (convergence.converged ? " iterations to converge | " : " iterations, not converged | ")
+               + QString::number(convergence.arcsProcessed / (ms * 1e3), 'f', 1) + " M arcs/s";
+    };
+
+    auto scores = [&](const QString& name, const std::function<QVector<double>(ThreadPool&, GraphAnalytics::Convergence*)>& run) {
+        report.append("  " + name + ":");
+        QVector<double> reference;
+        double baselineMs = 0.0;
+        for (int threads : threadCounts) {
+            ThreadPool pool(threads);
+            GraphAnalytics::Convergence convergence;
+            QElapsedTimer timer;
+            timer.start();
+            QVector<double> result = run(pool, &convergence);
+            double ms = timer.nsecsElapsed() / 1e6;
+            if (reference.isEmpty()) {
+                reference = result;
+                baselineMs = ms;
+            }
+
+            // Sums differ only by rounding between thread counts
+            double difference = 0.0;
+            double total = 0.0;
+            for (int u = 0; u < result.size(); ++u) {
+                difference += std::abs(result[u] - reference[u]);
+                total += result[u];
+            }
+            report.append(line(threads, ms, convergence, baselineMs) + " | sum " + QString::number(total, 'f', 6)
+                          + (difference < 1e-9 ? "" : " | DIFFERS BY " + QString::number(difference, 'g', 3)));
+        }
+    };
+    scores("PageRank", [&](ThreadPool& pool, GraphAnalytics::Convergence* convergence) {
+        return GraphAnalytics::pageRank(directed, reverse, pool, GraphAnalytics::DAMPING, GraphAnalytics::TOLERANCE,
+                                        GraphAnalytics::MAX_ITERATIONS, convergence);
+    });
+    scores("Personalized PageRank from the highest-degree node", [&](ThreadPool& pool, GraphAnalytics::Convergence* convergence) {
+        return GraphAnalytics::personalizedPageRank(directed, reverse, {hub}, pool, GraphAnalytics::DAMPING,
+                                                    GraphAnalytics::TOLERANCE, GraphAnalytics::MAX_ITERATIONS, convergence);
+    });
+
+    report.append("  Label propagation (undirected):");
+    QVector<int> reference;
+    double baselineMs = 0.0;
+    for (int threads : threadCounts) {
+        ThreadPool pool(threads);
+        GraphAnalytics::Convergence convergence;
+        QElapsedTimer timer;
+        timer.start();
+        QVector<int> labels = GraphAnalytics::labelPropagation(undirected, undirected, pool, GraphAnalytics::MAX_ITERATIONS, &convergence);
+        double ms = timer.nsecsElapsed() / 1e6;
+        if (reference.isEmpty()) {
+            reference = labels;
+            baselineMs = ms;
+        }
+        QVector<int> sorted = labels;
+        std::sort(sorted.begin(), sorted.end());
+        int communities = std::unique(sorted.begin(), sorted.end()) - sorted.begin();
+        report.append(line(threads, ms, convergence, baselineMs) + " | " + QString::number(communities) + " communities"
+                      + (labels == reference ? "" : " | LABELS DIFFER"));
+    }
+    return report;
+}
+
+QStringList Benchmark::forceLayout(int nodeCount, int iterations)
+{
+    QStringList report;
+    int smallCount = std::max(1, nodeCount / LAYOUT_EXACT_DIVISOR);
+    report.append("Benchmark: Barnes-Hut force layout (" + QString::number(std::thread::hardware_concurrency())
+                  + " hardware threads)");
+
+    // 1. Approximation: one iteration from the same start at several theta;
+    //    theta 0 opens every cell, so it is the exact O(V^2) sum
+    CsrGraph small = GraphGenerators::grid(smallCount, RANDOM_SEED);
+    report.append("  Grid, " + QString::number(small.nodeCount) + " nodes: one iteration per theta");
+    QVector<double> exactXs, exactYs;
+    double exactMs = 0.0;
+    for (double theta : {0.0, 0.5, ForceLayout::THETA, 1.2}) {
+        ForceLayout layout(small, small, ThreadPool::global());
+        layout.setTheta(theta);
+        QVector<double> startXs, startYs, xs, ys;
+        layout.positions(GraphGenerators::LAYOUT_WIDTH, GraphGenerators::LAYOUT_HEIGHT, startXs, startYs);
+        layout.run(1);
+        const ForceLayout::Stats& stats = layout.stats();
+        layout.positions(GraphGenerators::LAYOUT_WIDTH, GraphGenerators::LAYOUT_HEIGHT, xs, ys);
+        if (theta == 0.0) {
+            exactXs = xs;
+            exactYs = ys;
+            exactMs = stats.ms;
+        }
+
+        // On screen: how far the nodes moved, and how far from the exact move they landed
+        double moved = 0.0;
+        double deviation = 0.0;
+        for (int u = 0; u < small.nodeCount; ++u) {
+            moved += std::hypot(xs[u] - startXs[u], ys[u] - startYs[u]);
+            deviation += std::hypot(xs[u] - exactXs[u], ys[u] - exactYs[u]);
+        }
+        report.append("    theta " + QString::number(theta, 'f', 1) + ": " + QString::number(stats.ms, 'f', 1) + " ms (x"
+                      + QString::number(exactMs / stats.ms, 'f', 1) + ") | " + QString::number(stats.interactions)
+                      + " force terms | mean move " + QString::number(moved / small.nodeCount, 'f', 2)
+                      + " px, " + QString::number(deviation / small.nodeCount, 'f', 3) + " px off the exact move");
+    }
+
+    ForceLayout converging(small, small, ThreadPool::global());
+    converging.run(ForceLayout::MAX_ITERATIONS);
+    report.append("    Full run at theta " + QString::number(ForceLayout::THETA, 'f', 1) + ": "
+                  + QString::number(converging.stats().iterations)
+                  + (converging.stats().converged ? " iterations to converge in " : " iterations, not converged, in ")
+                  + QString::number(converging.stats().ms, 'f', 0) + " ms");
+
+    // 2. Scaling: the same iterations on the large graph at every thread count
+    CsrGraph large = GraphGenerators::grid(nodeCount, RANDOM_SEED);
+    report.append("  Grid, " + QString::number(large.nodeCount) + " nodes, " + QString::number(iterations) + " iterations:");
+    QList<int> threadCounts;
+    int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads < hardwareThreads; threads *= 2) threadCounts.append(threads);
+    threadCounts.append(hardwareThreads);
+
+    QVector<double> referenceXs;
+    double baselineMs = 0.0;
+    for (int threads : threadCounts) {
+        ThreadPool pool(threads);
+        ForceLayout layout(large, large, pool);
+        layout.run(iterations);
+        const ForceLayout::Stats& stats = layout.stats();
+        QVector<double> xs, ys;
+        layout.positions(GraphGenerators::LAYOUT_WIDTH, GraphGenerators::LAYOUT_HEIGHT, xs, ys);
+        if (referenceXs.isEmpty()) {
+            referenceXs = xs;
+            baselineMs = stats.ms;
+        }
+        double perIteration = stats.ms / stats.iterations;
+        report.append("    " + QString::number(threads) + " threads: " + QString::number(perIteration, 'f', 1)
+                      + " ms per iteration (x" + QString::number(baselineMs / stats.ms, 'f', 2) + ") | "
+                      + QString::number(stats.cells) + " cells, " + QString::number(stats.interactions) + " force terms | "
+                      + QString::number(1000.0 / perIteration, 'f', 1) + " iterations/s"
+                      + (xs == referenceXs ? "" : " | POSITIONS DIFFER"));
+    }
+    return report;
+}
+
+QStringList Benchmark::mazeHistory(int largeSide)
+{
+    QStringList report;
+    report.append("Benchmark: maze history (one byte per cell, delta steps with keyframes)");
+    for (int side : {41, 101, 201, 2001}) {
+        Maze maze;
+        QElapsedTimer timer;
+        timer.start();
+        QList<QVariant> history = maze.generateRecursiveBacktracker(side, side, RANDOM_SEED);
+        double ms = timer.nsecsElapsed() / 1e6;
+
+        const MazeTrace& trace = *history.last().value<MazeStep>().trace;
+        long long cells = (long long)side * side;
+        double traceMb = trace.memoryBytes() / 1e6;
+        double snapshotMb = history.size() * cells * sizeof(int) / 1e6; // One QVector<QVector<int>> grid per step
+        report.append("  " + QString::number(side) + " x " + QString::number(side) + ": "
+                      + QString::number(history.size()) + " steps, " + QString::number(trace.changes.size())
+                      + " changes, " + QString::number(trace.keyframes.size()) + " keyframes | trace "
+                      + QString::number(traceMb, 'f', 2) + " MB vs " + QString::number(snapshotMb, 'f', 1)
+                      + " MB as full grids (x" + QString::number(snapshotMb / traceMb, 'f', 0) + ") | "
+                      + QString::number(ms, 'f', 1) + " ms");
+    }
+
+    // Past Maze::MAX_TRACED_CELLS only the finished grid is kept
+    Maze maze;
+    QElapsedTimer timer;
+    timer.start();
+    maze.generateRecursiveBacktracker(largeSide, largeSide, RANDOM_SEED);
+    double ms = timer.nsecsElapsed() / 1e6;
+    long long cells = (long long)largeSide * largeSide;
+    report.append("  " + QString::number(largeSide) + " x " + QString::number(largeSide) + ", untraced: "
+                  + QString::number(ms, 'f', 0) + " ms, " + QString::number(cells / ms / 1000.0, 'f', 1)
+                  + " M cells/s");
+    return report;
+}
+
+QStringList Benchmark::ellerMaze(int width, int rows)
+{
+    QStringList report;
+    report.append("Benchmark: Eller maze (" + QString::number(width) + " columns, one row of cells at a time)");
+
+    EllerMaze maze(width, RANDOM_SEED);
+    QByteArray buffer;
+    QElapsedTimer timer;
+    timer.start();
+    while (maze.rowsGenerated() < rows) {
+        buffer.clear(); // Finished rows are dropped, as a viewer or file writer would
+        maze.nextRows(buffer, maze.rowsGenerated() + 2 >= rows);
+    }
+    double ms = timer.nsecsElapsed() / 1e6;
+    double cells = (double)maze.rowsGenerated() * width;
+    report.append("  " + QString::number(maze.rowsGenerated()) + " rows: " + QString::number(ms, 'f', 0) + " ms, "
+                  + QString::number(cells / ms / 1000.0, 'f', 1) + " M cells/s | row state "
+                  + QString::number(maze.memoryBytes() / 1024.0, 'f', 1) + " KB vs "
+                  + QString::number(cells / (1024.0 * 1024.0), 'f', 0) + " MB for the whole grid");
+
+    QString path = QDir::tempPath() + "/algvis_benchmark_maze.pbm";
+    QString error;
+    timer.start();
+    bool ok = EllerMaze::saveAsPbm(path, width, width, RANDOM_SEED, &error);
+    ms = timer.nsecsElapsed() / 1e6;
+    qint64 bytes = QFile(path).size();
+    QFile::remove(path);
+    if (!ok) {
+        report.append("  PBM: " + error);
+        return report;
+    }
+    report.append("  PBM " + QString::number(width) + " x " + QString::number(width | 1) + ": "
+                  + QString::number(ms, 'f', 0) + " ms | " + QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB, "
+                  + QString::number(bytes / (1024.0 * 1024.0) / ms * 1000.0, 'f', 0) + " MB/s");
+    return report;
+}
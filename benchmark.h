@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QList>
+#include <QStringList>
+
+// Native-mode benchmarks: the data structures run without recording any
+// history, and each function returns report lines for the algorithm log.
+namespace Benchmark
+{
+// Point lookups and range scans, B+-tree (several fan-outs) vs AVL
+QStringList treeLookups(const QList<int>& sizes = {1000000, 10000000});
+
+// Insert-heavy and delete-heavy throughput of AVL, red-black tree and treap
+QStringList balancingSchemes(int operations = 1000000);
+
+// find() cost of AVL, red-black, treap and splay trees under uniform, Zipfian,
+// sequential and working-set access: time, path length and comparisons per access
+QStringList accessPatterns(int keyCount = 100000, int accesses = 1000000);
+
+// Binary, branchless, interpolation, Eytzinger and van Emde Boas searches:
+// latency plus accesses and distinct cache lines per search
+QStringList searchLayouts(const QList<int>& sizes = {10000, 100000, 1000000, 10000000, 100000000});
+
+// Build, BFS, Dijkstra and Prim on a random CSR graph, plus the old
+// map-of-lists layout on a graph ten times smaller for comparison
+QStringList csrGraph(int nodeCount = 1000000, int edgeCount = 10000000);
+
+// Time to generate grid, random geometric, Erdos-Renyi and R-MAT graphs of
+// about 'edgeCount' edges, CSR build included
+QStringList graphGenerators(int edgeCount = 10000000);
+
+// Parse time of GraphLoader on an Erdos-Renyi graph written as edge list,
+// DIMACS and METIS temporary files, and the time of the whole Load Graph...
+// path through Graph::loadFromFile()
+QStringList graphLoader(int edgeCount = 10000000);
+
+// Point-to-point queries on a random geometric graph: Dijkstra on std::priority_queue
+// (full single-source run) and on the d-ary heap, A* and bidirectional Dijkstra,
+// with the average number of settled nodes per query
+QStringList shortestPaths(int nodeCount = 1000000, int queries = 100);
+
+// Serial queue BFS vs direction-optimizing BFS at 1, 2, 4, ... threads on a
+// grid (many small levels), Erdos-Renyi and R-MAT graphs (few huge levels)
+QStringList parallelBfs(int edgeCount = 10000000);
+
+// Sequential Dijkstra vs delta-stepping on random geometric and R-MAT graphs:
+// a sweep of delta values on every core, then the suggested delta at 1, 2, 4, ... threads
+QStringList deltaStepping(int nodeCount = 1000000, int sources = 5);
+
+// Prim, Kruskal and Boruvka (at 1, 2, 4, ... threads) on grid, random geometric
+// and Erdos-Renyi graphs, with the exact forest weight each one found
+QStringList spanningTrees(int nodeCount = 1000000);
+
+// Iterative DFS on a chain as deep as the graph, then DFS, Tarjan SCC,
+// union-find components and the condensation on a grid and a directed R-MAT graph
+QStringList components(int nodeCount = 1000000);
+
+// Naive vs cache-blocked, vectorized Floyd-Warshall (at 1, 2, 4, ... threads)
+// on random geometric graphs, in GFLOP-equivalents; the naive loop runs up to 2000 nodes
+QStringList floydWarshall(const QList<int>& sizes = {1000, 2000, 4000, 8000});
+
+// Contraction-hierarchy preprocessing time and shortcut count on a grid and a
+// sparse random geometric graph, then per-query time against Dijkstra and
+// bidirectional Dijkstra, and how many queries repay the preprocessing
+QStringList contractionHierarchy(int nodeCount = 100000, int queries = 1000);
+
+// Graph::insertEdge(), deleteEdge() and reweightEdge(), each timed on its own
+// with the repair and recorded steps, against rerunning dijkstra() and
+// primMST(); then the CSR overlay left behind and a final check
+QStringList dynamicUpdates(int nodeCount = 100000, int updates = 1000);
+
+// Many random point-to-point queries answered one by one with allocating
+// Dijkstra, then by BatchQueryEngine at 1, 2, 4, ... threads (weighted and
+// hop count), and a sources x targets table against the same pairs as queries
+QStringList batchQueries(int nodeCount = 200000, int queries = 200, int tableSide = 20);
+
+// Dinic against FIFO and highest-label push-relabel (both with global
+// relabeling) on grid, random geometric and directed R-MAT networks with
+// weights as capacities; flow values and cut capacities are cross-checked
+QStringList maxFlow(const QList<int>& edgeCounts = {100000, 1000000});
+
+// PageRank, personalized PageRank and label propagation as parallel pull
+// SpMV sweeps on an R-MAT power-law graph at 1, 2, 4, ... threads: arcs
+// processed per second and iterations to convergence
+QStringList pageRank(int edgeCount = 4000000);
+
+// Barnes-Hut force layout: theta against exact O(V^2) repulsion on a small
+// grid (time per iteration, deviation of the move), iterations to converge,
+// then time per iteration at 'nodeCount' nodes on 1, 2, 4, ... threads
+QStringList forceLayout(int nodeCount = 50000, int iterations = 20);
+
+// Recursive backtracker maze histories of growing size: steps, logged cell
+// changes, keyframes and trace memory against one full grid copy per step,
+// then the time to generate a largeSide x largeSide maze without a history
+QStringList mazeHistory(int largeSide = 10001);
+
+// Eller's algorithm on a 'width'-wide maze: rows per second with the rows
+// dropped as they finish, the row state kept, and a width x width maze
+// streamed to a PBM file
+QStringList ellerMaze(int width = 10001, int rows = 20001);
+}
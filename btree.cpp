@@ -0,0 +1,598 @@
+#include "btree.h"
+#include <QStringList>
+#include <algorithm>
+#include <limits>
+#include <new>
+
+// Define constants for layout
+const int LEVEL_HEIGHT = 80;
+const int CANVAS_WIDTH = 1200;
+const int KEY_WIDTH = 26;   // Horizontal space per key inside a node box
+const int MIN_ORDER = 3;
+
+BTree::BTree(int order) : m_root(nullptr), m_order(std::max(order, MIN_ORDER)), m_nextNodeId(0) {}
+
+BTree::~BTree()
+{
+    clear();
+}
+
+void BTree::setOrder(int order)
+{
+    clear();
+    m_order = std::max(order, MIN_ORDER);
+}
+
+void BTree::clear()
+{
+    freeRecursive(m_root);
+    m_root = nullptr;
+    m_nextNodeId = 0;
+}
+
+// --- Node Storage ---
+
+BTree::Node* BTree::allocNode(bool leaf)
+{
+    // One allocation holds the header, the key array (with one spare slot for
+    // the transient overflow before a split) and, for internal nodes, the child array.
+    size_t keyBytes = ((m_order * sizeof(int)) + alignof(Node*) - 1) & ~(alignof(Node*) - 1);
+    size_t childBytes = leaf ? 0 : (m_order + 1) * sizeof(Node*);
+    char* block = static_cast<char*>(::operator new(sizeof(Node) + keyBytes + childBytes));
+
+    Node* node = new (block) Node;
+    node->count = 0;
+    node->leaf = leaf;
+    node->id = m_nextNodeId++;
+    node->pos = QPointF();
+    node->next = nullptr;
+    node->keys = reinterpret_cast<int*>(block + sizeof(Node));
+    node->children = leaf ? nullptr : reinterpret_cast<Node**>(block + sizeof(Node) + keyBytes);
+    return node;
+}
+
+void BTree::freeNode(BTree::Node* node)
+{
+    node->~Node();
+    ::operator delete(node);
+}
+
+void BTree::freeRecursive(BTree::Node* node)
+{
+    if (!node) return;
+    if (!node->leaf) {
+        for (int i = 0; i <= node->count; ++i) freeRecursive(node->children[i]);
+    }
+    freeNode(node);
+}
+
+int BTree::upperBound(const BTree::Node* node, int value)
+{
+    return std::upper_bound(node->keys, node->keys + node->count, value) - node->keys;
+}
+
+// --- Public Methods ---
+
+QList<QVariant> BTree::insert(int value)
+{
+    QList<QVariant> history;
+    record(&history, "Inserting " + QString::number(value));
+    insertKey(value, &history);
+    record(&history, "Inserted " + QString::number(value) + ". Height: " + QString::number(height()));
+    return history;
+}
+
+QList<QVariant> BTree::remove(int value)
+{
+    QList<QVariant> history;
+    record(&history, "Attempting to remove " + QString::number(value));
+    if (removeKey(value, &history)) {
+        record(&history, "Removed " + QString::number(value) + ". Height: " + QString::number(height()));
+    } else {
+        record(&history, "Value " + QString::number(value) + " not found.");
+    }
+    return history;
+}
+
+QList<QVariant> BTree::find(int value)
+{
+    QList<QVariant> history;
+    record(&history, "Searching for " + QString::number(value));
+    if (!m_root) {
+        record(&history, "Tree is empty.");
+        return history;
+    }
+
+    // One node per level: every key lives in a leaf, so the search never stops early
+    int pathLength = 1;
+    Node* node = m_root;
+    while (!node->leaf) {
+        record(&history, "Descending towards " + QString::number(value), node);
+        node = node->children[upperBound(node, value)];
+        pathLength++;
+    }
+
+    const int* it = std::lower_bound(node->keys, node->keys + node->count, value);
+    QString summary = "Path length: " + QString::number(pathLength);
+    if (it != node->keys + node->count && *it == value) {
+        record(&history, "Found " + QString::number(value) + ". " + summary, node, Qt::green);
+    } else {
+        record(&history, "Value " + QString::number(value) + " not found. " + summary, node, Qt::red);
+    }
+    return history;
+}
+
+QList<QVariant> BTree::rangeScan(int low, int high)
+{
+    QList<QVariant> history;
+    record(&history, "Range scan [" + QString::number(low) + ", " + QString::number(high) + "]");
+    if (!m_root) {
+        record(&history, "Tree is empty.");
+        return history;
+    }
+
+    // 1. Descend to the leaf that would hold 'low'
+    Node* node = m_root;
+    while (!node->leaf) {
+        record(&history, "Descending towards " + QString::number(low), node);
+        node = node->children[upperBound(node, low)];
+    }
+
+    // 2. Walk the leaf chain until keys pass 'high'
+    QStringList found;
+    QList<int> scannedLeaves;
+    for (Node* leaf = node; leaf; leaf = leaf->next) {
+        if (leaf->count > 0 && leaf->keys[0] > high) break;
+
+        int inLeaf = 0;
+        for (int i = 0; i < leaf->count; ++i) {
+            if (leaf->keys[i] >= low && leaf->keys[i] <= high) {
+                found.append(QString::number(leaf->keys[i]));
+                inLeaf++;
+            }
+        }
+        scannedLeaves.append(leaf->id);
+
+        GraphStep step = createSnapshot("Scanning leaf: " + QString::number(inLeaf) + " keys in range");
+        for (int id : scannedLeaves) highlightNode(step, id, Qt::green);
+        highlightNode(step, leaf->id, Qt::yellow);
+        history.append(QVariant::fromValue(step));
+
+        if (leaf->count > 0 && leaf->keys[leaf->count - 1] > high) break;
+    }
+
+    GraphStep finalStep = createSnapshot("Range scan complete. " + QString::number(found.size()) + " keys: " + found.join(", "));
+    for (int id : scannedLeaves) highlightNode(finalStep, id, Qt::green);
+    history.append(QVariant::fromValue(finalStep));
+    return history;
+}
+
+QList<QVariant> BTree::bulkLoad(const QVector<int>& sortedValues)
+{
+    build(sortedValues);
+
+    QList<QVariant> history;
+    record(&history, "Bulk loaded sorted input. Order: " + QString::number(m_order) + ", Height: " + QString::number(height()));
+    return history;
+}
+
+// --- Native Operations ---
+
+void BTree::build(const QVector<int>& sortedValues)
+{
+    clear();
+
+    QVector<int> keys;
+    keys.reserve(sortedValues.size());
+    for (int v : sortedValues) {
+        if (keys.isEmpty() || keys.last() != v) keys.append(v);
+    }
+    if (keys.isEmpty()) return;
+
+    // 1. Pack the leaves. Spreading keys evenly over the minimum number of
+    // leaves keeps every leaf at or above the minimum fill.
+    int leafCapacity = m_order - 1;
+    int leafCount = (keys.size() + leafCapacity - 1) / leafCapacity;
+    QVector<Node*> level;
+    QVector<int> levelMin; // Smallest key under each node, used as separator
+    level.reserve(leafCount);
+    levelMin.reserve(leafCount);
+
+    int offset = 0;
+    Node* prev = nullptr;
+    for (int i = 0; i < leafCount; ++i) {
+        int take = keys.size() / leafCount + (i < keys.size() % leafCount ? 1 : 0);
+        Node* leaf = allocNode(true);
+        std::copy(keys.constData() + offset, keys.constData() + offset + take, leaf->keys);
+        leaf->count = take;
+        if (prev) prev->next = leaf;
+        prev = leaf;
+        level.append(leaf);
+        levelMin.append(keys[offset]);
+        offset += take;
+    }
+
+    // 2. Build internal levels bottom-up the same way
+    while (level.size() > 1) {
+        int groups = (level.size() + m_order - 1) / m_order;
+        QVector<Node*> parents;
+        QVector<int> parentMin;
+        parents.reserve(groups);
+        parentMin.reserve(groups);
+
+        int index = 0;
+        for (int g = 0; g < groups; ++g) {
+            int take = level.size() / groups + (g < level.size() % groups ? 1 : 0);
+            Node* parent = allocNode(false);
+            for (int c = 0; c < take; ++c) {
+                parent->children[c] = level[index + c];
+                if (c > 0) parent->keys[c - 1] = levelMin[index + c];
+            }
+            parent->count = take - 1;
+            parents.append(parent);
+            parentMin.append(levelMin[index]);
+            index += take;
+        }
+        level = parents;
+        levelMin = parentMin;
+    }
+
+    m_root = level.first();
+}
+
+bool BTree::insertSilent(int value)
+{
+    return insertKey(value, nullptr);
+}
+
+bool BTree::removeSilent(int value)
+{
+    return removeKey(value, nullptr);
+}
+
+bool BTree::contains(int value) const
+{
+    const Node* leaf = findLeaf(value);
+    if (!leaf) return false;
+    const int* it = std::lower_bound(leaf->keys, leaf->keys + leaf->count, value);
+    return it != leaf->keys + leaf->count && *it == value;
+}
+
+int BTree::countRange(int low, int high) const
+{
+    int total = 0;
+    for (const Node* leaf = findLeaf(low); leaf; leaf = leaf->next) {
+        const int* last = leaf->keys + leaf->count;
+        const int* begin = std::lower_bound(static_cast<const int*>(leaf->keys), last, low);
+        const int* end = std::upper_bound(begin, last, high);
+        total += end - begin;
+        if (end != last) break; // Passed 'high' inside this leaf
+    }
+    return total;
+}
+
+int BTree::height() const
+{
+    int h = 0;
+    for (const Node* node = m_root; node; node = node->leaf ? nullptr : node->children[0]) h++;
+    return h;
+}
+
+const BTree::Node* BTree::findLeaf(int value) const
+{
+    const Node* node = m_root;
+    while (node && !node->leaf) {
+        node = node->children[upperBound(node, value)];
+    }
+    return node;
+}
+
+// --- Recursive Algorithm Helpers ---
+
+bool BTree::insertKey(int value, QList<QVariant>* history)
+{
+    if (!m_root) {
+        m_root = allocNode(true);
+    }
+
+    bool inserted = false;
+    int separator = 0;
+    Node* rightSibling = nullptr;
+    if (insertRecursive(m_root, value, inserted, separator, rightSibling, history)) {
+        // The root split, so the tree grows by one level
+        Node* newRoot = allocNode(false);
+        newRoot->keys[0] = separator;
+        newRoot->children[0] = m_root;
+        newRoot->children[1] = rightSibling;
+        newRoot->count = 1;
+        m_root = newRoot;
+        if (history) record(history, "Root split. New root with separator " + QString::number(separator), newRoot, Qt::green);
+    }
+    return inserted;
+}
+
+bool BTree::insertRecursive(BTree::Node* node, int value, bool& inserted, int& separator, BTree::Node*& rightSibling, QList<QVariant>* history)
+{
+    int i = upperBound(node, value);
+
+    if (node->leaf) {
+        if (i > 0 && node->keys[i - 1] == value) {
+            if (history) record(history, "Value " + QString::number(value) + " already exists.", node, Qt::red);
+            return false;
+        }
+
+        std::copy_backward(node->keys + i, node->keys + node->count, node->keys + node->count + 1);
+        node->keys[i] = value;
+        node->count++;
+        inserted = true;
+        if (history) record(history, "Inserted " + QString::number(value) + " into leaf", node, Qt::green);
+
+        if (node->count < m_order) return false;
+
+        splitLeaf(node, separator, rightSibling);
+        if (history) record(history, "Leaf overflow. Split and copied up " + QString::number(separator), rightSibling, Qt::red);
+        return true;
+    }
+
+    if (history) record(history, "Comparing with separators, descending to child " + QString::number(i), node);
+
+    int childSeparator = 0;
+    Node* childRight = nullptr;
+    if (!insertRecursive(node->children[i], value, inserted, childSeparator, childRight, history)) {
+        return false;
+    }
+
+    // Child split: insert its separator and new right half next to it
+    std::copy_backward(node->keys + i, node->keys + node->count, node->keys + node->count + 1);
+    std::copy_backward(node->children + i + 1, node->children + node->count + 1, node->children + node->count + 2);
+    node->keys[i] = childSeparator;
+    node->children[i + 1] = childRight;
+    node->count++;
+
+    if (node->count < m_order) return false;
+
+    splitInternal(node, separator, rightSibling);
+    if (history) record(history, "Internal overflow. Split and moved up " + QString::number(separator), rightSibling, Qt::red);
+    return true;
+}
+
+void BTree::splitLeaf(BTree::Node* node, int& separator, BTree::Node*& rightSibling)
+{
+    int leftCount = (node->count + 1) / 2;
+    Node* right = allocNode(true);
+    right->count = node->count - leftCount;
+    std::copy(node->keys + leftCount, node->keys + node->count, right->keys);
+    node->count = leftCount;
+
+    right->next = node->next;
+    node->next = right;
+
+    separator = right->keys[0]; // B+-tree: the separator is copied, the key stays in the leaf
+    rightSibling = right;
+}
+
+void BTree::splitInternal(BTree::Node* node, int& separator, BTree::Node*& rightSibling)
+{
+    int mid = node->count / 2;
+    Node* right = allocNode(false);
+    right->count = node->count - mid - 1;
+    std::copy(node->keys + mid + 1, node->keys + node->count, right->keys);
+    std::copy(node->children + mid + 1, node->children + node->count + 1, right->children);
+
+    separator = node->keys[mid]; // Internal split: the middle key moves up
+    node->count = mid;
+    rightSibling = right;
+}
+
+bool BTree::removeKey(int value, QList<QVariant>* history)
+{
+    if (!m_root) return false;
+    if (!removeRecursive(m_root, value, history)) return false;
+
+    // Shrink the tree when the root runs out of keys
+    if (m_root->count == 0) {
+        Node* oldRoot = m_root;
+        m_root = oldRoot->leaf ? nullptr : oldRoot->children[0];
+        freeNode(oldRoot);
+        if (history) record(history, m_root ? "Root emptied. Tree height decreased." : "Tree is empty.");
+    }
+    return true;
+}
+
+bool BTree::removeRecursive(BTree::Node* node, int value, QList<QVariant>* history)
+{
+    if (node->leaf) {
+        int* it = std::lower_bound(node->keys, node->keys + node->count, value);
+        if (it == node->keys + node->count || *it != value) return false;
+
+        if (history) record(history, "Found " + QString::number(value) + " in leaf", node, Qt::red);
+        std::copy(it + 1, node->keys + node->count, it);
+        node->count--;
+        return true;
+    }
+
+    int i = upperBound(node, value);
+    if (history) record(history, "Comparing with separators, descending to child " + QString::number(i), node);
+
+    if (!removeRecursive(node->children[i], value, history)) return false;
+
+    if (node->children[i]->count < minKeys()) {
+        fixUnderflow(node, i, history);
+    }
+    return true;
+}
+
+void BTree::fixUnderflow(BTree::Node* parent, int childIndex, QList<QVariant>* history)
+{
+    Node* child = parent->children[childIndex];
+    Node* left = childIndex > 0 ? parent->children[childIndex - 1] : nullptr;
+    Node* right = childIndex < parent->count ? parent->children[childIndex + 1] : nullptr;
+
+    if (history) record(history, "Underflow: node has " + QString::number(child->count) + " keys, minimum is " + QString::number(minKeys()), child, Qt::red);
+
+    // Case 1: Borrow from the left sibling
+    if (left && left->count > minKeys()) {
+        std::copy_backward(child->keys, child->keys + child->count, child->keys + child->count + 1);
+        if (child->leaf) {
+            child->keys[0] = left->keys[left->count - 1];
+            parent->keys[childIndex - 1] = child->keys[0];
+        } else {
+            std::copy_backward(child->children, child->children + child->count + 1, child->children + child->count + 2);
+            child->keys[0] = parent->keys[childIndex - 1];
+            child->children[0] = left->children[left->count];
+            parent->keys[childIndex - 1] = left->keys[left->count - 1];
+        }
+        child->count++;
+        left->count--;
+        if (history) record(history, "Borrowed a key from the left sibling", child, Qt::green);
+        return;
+    }
+
+    // Case 2: Borrow from the right sibling
+    if (right && right->count > minKeys()) {
+        if (child->leaf) {
+            child->keys[child->count] = right->keys[0];
+            std::copy(right->keys + 1, right->keys + right->count, right->keys);
+            parent->keys[childIndex] = right->keys[0];
+        } else {
+            child->keys[child->count] = parent->keys[childIndex];
+            child->children[child->count + 1] = right->children[0];
+            parent->keys[childIndex] = right->keys[0];
+            std::copy(right->keys + 1, right->keys + right->count, right->keys);
+            std::copy(right->children + 1, right->children + right->count + 1, right->children);
+        }
+        child->count++;
+        right->count--;
+        if (history) record(history, "Borrowed a key from the right sibling", child, Qt::green);
+        return;
+    }
+
+    // Case 3: Merge with a sibling
+    int leftIndex = left ? childIndex - 1 : childIndex;
+    mergeChildren(parent, leftIndex);
+    if (history) record(history, "Merged with sibling", parent->children[leftIndex], Qt::green);
+}
+
+void BTree::mergeChildren(BTree::Node* parent, int leftIndex)
+{
+    Node* left = parent->children[leftIndex];
+    Node* right = parent->children[leftIndex + 1];
+
+    if (left->leaf) {
+        std::copy(right->keys, right->keys + right->count, left->keys + left->count);
+        left->count += right->count;
+        left->next = right->next;
+    } else {
+        // The separator moves down between the two halves
+        left->keys[left->count] = parent->keys[leftIndex];
+        std::copy(right->keys, right->keys + right->count, left->keys + left->count + 1);
+        std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+        left->count += right->count + 1;
+    }
+    freeNode(right);
+
+    std::copy(parent->keys + leftIndex + 1, parent->keys + parent->count, parent->keys + leftIndex);
+    std::copy(parent->children + leftIndex + 2, parent->children + parent->count + 1, parent->children + leftIndex + 1);
+    parent->count--;
+}
+
+// --- Visualization & Layout Helpers ---
+
+void BTree::record(QList<QVariant>* history, const QString& message, const BTree::Node* highlight, QColor color)
+{
+    // Callers test 'history' first, so silent runs never build the message strings
+    if (!history) return;
+    GraphStep step = createSnapshot(message);
+    if (highlight) highlightNode(step, highlight->id, color);
+    history->append(QVariant::fromValue(step));
+}
+
+void BTree::updatePositions()
+{
+    if (!m_root) return;
+
+    int leafCount = 0;
+    for (const Node* node = findLeaf(std::numeric_limits<int>::min()); node; node = node->next) leafCount++;
+
+    int leafIndex = 0;
+    updatePositionsRecursive(m_root, 0, leafIndex, leafCount);
+}
+
+double BTree::updatePositionsRecursive(BTree::Node* node, int level, int& leafIndex, int leafCount)
+{
+    double x;
+    if (node->leaf) {
+        // Leaves are spread evenly across the canvas
+        x = (leafIndex + 0.5) * CANVAS_WIDTH / leafCount;
+        leafIndex++;
+    } else {
+        // Internal nodes sit centered above their children
+        double first = 0;
+        double last = 0;
+        for (int i = 0; i <= node->count; ++i) {
+            double childX = updatePositionsRecursive(node->children[i], level + 1, leafIndex, leafCount);
+            if (i == 0) first = childX;
+            last = childX;
+        }
+        x = (first + last) / 2.0;
+    }
+    node->pos = QPointF(x, 50 + level * LEVEL_HEIGHT);
+    return x;
+}
+
+GraphStep BTree::createSnapshot(const QString& message)
+{
+    updatePositions();
+
+    GraphStep step;
+    step.statusMessage = message;
+    if (m_root) {
+        populateSnapshot(m_root, step);
+    }
+    return step;
+}
+
+void BTree::populateSnapshot(BTree::Node* node, GraphStep& step)
+{
+    // 1. Add this node as a box holding all of its keys
+    NodeState ns;
+    ns.id = node->id;
+    QStringList keys;
+    for (int i = 0; i < node->count; ++i) keys.append(QString::number(node->keys[i]));
+    ns.label = keys.join(" ");
+    ns.position = node->pos;
+    ns.width = std::max(40, node->count * KEY_WIDTH);
+    step.nodes.append(ns);
+
+    if (node->leaf) {
+        // 2a. Leaf chain link
+        if (node->next) {
+            EdgeState es;
+            es.fromId = node->id;
+            es.toId = node->next->id;
+            es.color = Qt::darkCyan;
+            step.edges.append(es);
+        }
+        return;
+    }
+
+    // 2b. Edges to every child
+    for (int i = 0; i <= node->count; ++i) {
+        EdgeState es;
+        es.fromId = node->id;
+        es.toId = node->children[i]->id;
+        step.edges.append(es);
+        populateSnapshot(node->children[i], step); // Recurse
+    }
+}
+
+void BTree::highlightNode(GraphStep& step, int nodeId, QColor color, QColor textColor)
+{
+    for (NodeState& ns : step.nodes) {
+        if (ns.id == nodeId) {
+            ns.color = color;
+            ns.textColor = textColor;
+            return;
+        }
+    }
+}
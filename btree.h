@@ -0,0 +1,79 @@
+#pragma once
+
+#include "datastructures.h"
+#include <QList>
+#include <QVariant>
+#include <QVector>
+
+// B+-tree: every key lives in a leaf, internal nodes only hold separators,
+// and the leaves are chained left-to-right for range scans.
+// A node's keys are allocated in the same block as the node itself, so a
+// search touches one or two cache lines per level instead of one per key.
+class BTree
+{
+public:
+    explicit BTree(int order = 4);
+    ~BTree();
+
+    // Order = maximum number of children per node (leaves hold order - 1 keys)
+    void setOrder(int order); // Also clears the tree
+    int order() const { return m_order; }
+
+    // Public methods that generate and return a step-by-step history
+    QList<QVariant> insert(int value);
+    QList<QVariant> remove(int value);
+    QList<QVariant> find(int value);
+    QList<QVariant> rangeScan(int low, int high);
+    QList<QVariant> bulkLoad(const QVector<int>& sortedValues);
+    void clear();
+
+    // Native operations (no history), used for benchmarking
+    void build(const QVector<int>& sortedValues);
+    bool insertSilent(int value);
+    bool removeSilent(int value);
+    bool contains(int value) const;
+    int countRange(int low, int high) const;
+    int height() const;
+
+private:
+    // --- Core Tree Structure ---
+    struct Node {
+        int count;       // Number of keys in use
+        bool leaf;
+        int id;          // Unique ID for visualization
+        QPointF pos;     // Position on canvas
+        Node* next;      // Next leaf in key order (leaves only)
+        int* keys;       // Points just past the node header
+        Node** children; // count + 1 entries (internal nodes only)
+    };
+
+    Node* m_root;
+    int m_order;
+    int m_nextNodeId;
+
+    Node* allocNode(bool leaf);
+    void freeNode(Node* node);
+    void freeRecursive(Node* node);
+    int minKeys() const { return (m_order - 1) / 2; }
+    static int upperBound(const Node* node, int value); // Number of keys <= value
+
+    // --- Recursive Algorithm Helpers ---
+    // history may be null, in which case nothing is recorded
+    bool insertRecursive(Node* node, int value, bool& inserted, int& separator, Node*& rightSibling, QList<QVariant>* history);
+    bool removeRecursive(Node* node, int value, QList<QVariant>* history);
+    void splitLeaf(Node* node, int& separator, Node*& rightSibling);
+    void splitInternal(Node* node, int& separator, Node*& rightSibling);
+    void fixUnderflow(Node* parent, int childIndex, QList<QVariant>* history);
+    void mergeChildren(Node* parent, int leftIndex);
+    const Node* findLeaf(int value) const;
+    bool insertKey(int value, QList<QVariant>* history);
+    bool removeKey(int value, QList<QVariant>* history);
+
+    // --- Visualization & Layout Helpers ---
+    void record(QList<QVariant>* history, const QString& message, const Node* highlight = nullptr, QColor color = Qt::yellow);
+    GraphStep createSnapshot(const QString& message);
+    void populateSnapshot(Node* node, GraphStep& step);
+    void updatePositions();
+    double updatePositionsRecursive(Node* node, int level, int& leafIndex, int leafCount);
+    void highlightNode(GraphStep& step, int nodeId, QColor color, QColor textColor = Qt::black);
+};
@@ -0,0 +1,298 @@
+#include "contractionhierarchy.h"
+#include <algorithm>
+#include <limits>
+
+const long long CH_INFINITY = std::numeric_limits<long long>::max();
+const int CH_WITNESS_SETTLE_LIMIT = 500; // A witness search gives up here and a shortcut is added instead
+
+namespace
+{
+// One entry of a dynamic adjacency list, copied out of the arc so witness
+// searches read neighbor lists without touching the arc array
+struct Link {
+    int node;
+    int weight;
+    int arc;
+};
+
+// Dynamic adjacency of the not yet contracted nodes, plus the scratch of the
+// bounded witness searches run while contracting them
+struct Contraction {
+    std::vector<std::vector<Link>> out; // Heads of the arcs leaving each node
+    std::vector<std::vector<Link>> in;  // Tails of the arcs entering each node
+    std::vector<int> deletedNeighbors;
+
+    std::vector<long long> witnessDist;
+    std::vector<int> touched;
+    std::vector<int> targetMark; // Equal to 'stamp' for the heads of the contracted node's arcs
+    int stamp = 0;
+    DaryHeap<long long> witnessOpen;
+
+    explicit Contraction(int nodeCount)
+        : out(nodeCount), in(nodeCount), deletedNeighbors(nodeCount, 0),
+          witnessDist(nodeCount, CH_INFINITY), targetMark(nodeCount, 0), witnessOpen(nodeCount) {}
+
+    static std::vector<Link>::iterator findArc(std::vector<Link>& list, int arc)
+    {
+        return std::find_if(list.begin(), list.end(), [arc](const Link& link) { return link.arc == arc; });
+    }
+
+    static void removeArc(std::vector<Link>& list, int arc)
+    {
+        *findArc(list, arc) = list.back();
+        list.pop_back();
+    }
+
+    // Local Dijkstra from 'source' that avoids 'skipped', stopping past 'maxDist',
+    // after CH_WITNESS_SETTLE_LIMIT nodes, or once all 'targets' marked nodes are settled
+    void witnessSearch(int source, int skipped, long long maxDist, int targets)
+    {
+        for (int node : touched) witnessDist[node] = CH_INFINITY;
+        touched.clear();
+        witnessOpen.clear();
+
+        witnessDist[source] = 0;
+        touched.push_back(source);
+        witnessOpen.push(source, 0);
+        int settled = 0;
+        while (!witnessOpen.isEmpty() && witnessOpen.topKey() <= maxDist && settled < CH_WITNESS_SETTLE_LIMIT && targets > 0) {
+            int u = witnessOpen.pop();
+            settled++;
+            if (targetMark[u] == stamp) targets--;
+            for (const Link& link : out[u]) {
+                if (link.node == skipped) continue;
+                long long candidate = witnessDist[u] + link.weight;
+                if (candidate < witnessDist[link.node]) {
+                    if (witnessDist[link.node] == CH_INFINITY) touched.push_back(link.node);
+                    witnessDist[link.node] = candidate;
+                    witnessOpen.pushOrDecrease(link.node, candidate);
+                }
+            }
+        }
+    }
+};
+} // namespace
+
+void ContractionHierarchy::build(const CsrGraph& graph)
+{
+    int n = graph.nodeCount;
+    m_arcs.clear();
+    m_order.clear();
+    m_shortcutsAdded.clear();
+    m_rank.fill(-1, n);
+
+    Contraction state(n);
+
+    // Lightest arc per (from, to), self-loops dropped
+    QVector<int> arcTo(n, -1); // Arc index from the current source to each node
+    for (int u = 0; u < n; ++u) {
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = graph.targets[arc];
+            if (v == u) continue;
+            int existing = arcTo[v];
+            if (existing >= 0 && m_arcs[existing].from == u) {
+                if (graph.weights[arc] < m_arcs[existing].weight) {
+                    m_arcs[existing].weight = graph.weights[arc];
+                    m_arcs[existing].second = graph.edgeIds[arc];
+                }
+                continue;
+            }
+            arcTo[v] = (int)m_arcs.size();
+            m_arcs.push_back({u, v, graph.weights[arc], -1, graph.edgeIds[arc]});
+        }
+    }
+    m_inputArcs = (int)m_arcs.size();
+    for (int index = 0; index < m_inputArcs; ++index) {
+        const Arc& arc = m_arcs[index];
+        state.out[arc.from].push_back({arc.to, arc.weight, index});
+        state.in[arc.to].push_back({arc.from, arc.weight, index});
+    }
+
+    // Shortcuts that contracting v needs; adds them when 'apply' is set
+    auto contract = [&](int v, bool apply) {
+        int maxOut = 0;
+        state.stamp++;
+        for (const Link& link : state.out[v]) {
+            maxOut = std::max(maxOut, link.weight);
+            state.targetMark[link.node] = state.stamp;
+        }
+
+        int shortcuts = 0;
+        std::vector<Link> incoming = state.in[v]; // Adding shortcuts below may reallocate the lists
+        for (const Link& in : incoming) {
+            int u = in.node;
+            state.witnessSearch(u, v, (long long)in.weight + maxOut, (int)state.out[v].size());
+
+            for (const Link& out : state.out[v]) {
+                int w = out.node;
+                if (w == u) continue;
+                long long through = (long long)in.weight + out.weight;
+                if (state.witnessDist[w] <= through) continue; // Another path is as short
+                shortcuts++;
+                if (!apply) continue;
+
+                // Replace a heavier direct arc, which no shortcut refers to yet since
+                // both its ends are uncontracted; otherwise add a new arc
+                Arc shortcut = {u, w, (int)through, in.arc, out.arc};
+                auto existing = std::find_if(state.out[u].begin(), state.out[u].end(), [w](const Link& link) { return link.node == w; });
+                if (existing != state.out[u].end()) {
+                    if (existing->weight > through) {
+                        m_arcs[existing->arc] = shortcut;
+                        existing->weight = shortcut.weight;
+                        Contraction::findArc(state.in[w], existing->arc)->weight = shortcut.weight;
+                    }
+                    continue;
+                }
+                state.out[u].push_back({w, shortcut.weight, (int)m_arcs.size()});
+                state.in[w].push_back({u, shortcut.weight, (int)m_arcs.size()});
+                m_arcs.push_back(shortcut);
+            }
+        }
+        return shortcuts;
+    };
+
+    auto priority = [&](int v) {
+        int removed = (int)(state.in[v].size() + state.out[v].size());
+        return contract(v, false) - removed + state.deletedNeighbors[v];
+    };
+
+    DaryHeap<int> queue(n);
+    for (int v = 0; v < n; ++v) queue.push(v, priority(v));
+
+    while (!queue.isEmpty()) {
+        int v = queue.pop();
+
+        // Lazy update: priorities go stale as neighbors are contracted
+        int current = priority(v);
+        if (!queue.isEmpty() && current > queue.topKey()) {
+            queue.push(v, current);
+            continue;
+        }
+
+        int arcsBefore = (int)m_arcs.size();
+        contract(v, true);
+        m_shortcutsAdded.append((int)m_arcs.size() - arcsBefore);
+        m_rank[v] = m_order.size();
+        m_order.append(v);
+
+        for (const Link& link : state.in[v]) {
+            Contraction::removeArc(state.out[link.node], link.arc);
+            state.deletedNeighbors[link.node]++;
+        }
+        for (const Link& link : state.out[v]) {
+            Contraction::removeArc(state.in[link.node], link.arc);
+            state.deletedNeighbors[link.node]++;
+        }
+        std::vector<Link>().swap(state.in[v]);
+        std::vector<Link>().swap(state.out[v]);
+    }
+
+    // Split the arcs by direction in the hierarchy into two upward graphs
+    QVector<GraphEdge> upEdges[2];
+    for (int side = 0; side < 2; ++side) m_arcUp[side].clear();
+    for (int index = 0; index < (int)m_arcs.size(); ++index) {
+        const Arc& arc = m_arcs[index];
+        if (m_rank[arc.from] < m_rank[arc.to]) {
+            upEdges[0].append({arc.from, arc.to, arc.weight});
+            m_arcUp[0].append(index);
+        } else {
+            upEdges[1].append({arc.to, arc.from, arc.weight});
+            m_arcUp[1].append(index);
+        }
+    }
+    for (int side = 0; side < 2; ++side) {
+        m_up[side] = CsrGraph::build(n, upEdges[side], true);
+        m_dist[side].fill(CH_INFINITY, n);
+        m_parentArc[side].fill(-1, n);
+        m_touched[side].clear();
+        m_open[side].reset(n);
+    }
+}
+
+GraphKernels::PathSearch ContractionHierarchy::query(int source, int target, QueryTrace* trace)
+{
+    GraphKernels::PathSearch result;
+    if (trace) *trace = QueryTrace();
+
+    for (int side = 0; side < 2; ++side) {
+        for (int node : m_touched[side]) {
+            m_dist[side][node] = CH_INFINITY;
+            m_parentArc[side][node] = -1;
+        }
+        m_touched[side].clear();
+        m_open[side].clear();
+    }
+
+    int ends[2] = {source, target};
+    for (int side = 0; side < 2; ++side) {
+        m_dist[side][ends[side]] = 0;
+        m_touched[side].append(ends[side]);
+        m_open[side].push(ends[side], 0);
+    }
+
+    // Both searches only climb, so each runs until its frontier alone exceeds
+    // the best meeting found: the top of the true path may be settled late
+    long long best = CH_INFINITY;
+    int meeting = -1;
+    while (true) {
+        bool live[2];
+        for (int side = 0; side < 2; ++side) live[side] = !m_open[side].isEmpty() && m_open[side].topKey() < best;
+        if (!live[0] && !live[1]) break;
+        int side = !live[1] || (live[0] && m_open[0].topKey() <= m_open[1].topKey()) ? 0 : 1;
+
+        int u = m_open[side].pop();
+        result.settled++;
+        if (trace) {
+            trace->settled.append(u);
+            trace->backward.append(side == 1);
+        }
+        if (m_dist[1 - side][u] != CH_INFINITY && m_dist[0][u] + m_dist[1][u] < best) {
+            best = m_dist[0][u] + m_dist[1][u];
+            meeting = u;
+        }
+
+        const CsrGraph& g = m_up[side];
+        for (int arc = g.arcBegin(u); arc < g.arcEnd(u); ++arc) {
+            int v = g.targets[arc];
+            long long candidate = m_dist[side][u] + g.weights[arc];
+            if (candidate < m_dist[side][v]) {
+                if (m_dist[side][v] == CH_INFINITY) m_touched[side].append(v);
+                m_dist[side][v] = candidate;
+                m_parentArc[side][v] = m_arcUp[side][g.edgeIds[arc]];
+                m_open[side].pushOrDecrease(v, candidate);
+            }
+        }
+    }
+
+    if (meeting < 0) return result;
+    result.distance = best;
+
+    if (trace) {
+        trace->meeting = meeting;
+        QVector<int> forward; // Arcs from the meeting node down to the source
+        for (int node = meeting; m_parentArc[0][node] >= 0; node = m_arcs[m_parentArc[0][node]].from) {
+            forward.append(m_parentArc[0][node]);
+        }
+        for (int i = forward.size() - 1; i >= 0; --i) appendPath(forward[i], trace->pathEdges);
+        for (int node = meeting; m_parentArc[1][node] >= 0; node = m_arcs[m_parentArc[1][node]].to) {
+            appendPath(m_parentArc[1][node], trace->pathEdges);
+        }
+    }
+    return result;
+}
+
+void ContractionHierarchy::appendPath(int arc, QVector<int>& edges) const
+{
+    // Unpack shortcuts depth first, first half before second
+    std::vector<int> stack = {arc};
+    while (!stack.empty()) {
+        const Arc& top = m_arcs[stack.back()];
+        stack.pop_back();
+        if (top.first < 0) {
+            edges.append(top.second);
+        } else {
+            stack.push_back(top.second);
+            stack.push_back(top.first);
+        }
+    }
+}
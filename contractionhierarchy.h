@@ -0,0 +1,68 @@
+#pragma once
+
+#include "csrgraph.h"
+#include "daryheap.h"
+#include "graphkernels.h"
+#include <QVector>
+#include <vector>
+
+// Contraction hierarchy (Geisberger et al.) for many point-to-point queries on
+// one fixed graph. build() removes the nodes one at a time, least important
+// first, and adds a shortcut u->w whenever u->v->w was the only shortest path
+// through the removed node v. A query then searches only upward (toward nodes
+// removed later) from both ends and meets near the top of the hierarchy, so it
+// settles a few hundred nodes where Dijkstra settles a large part of the graph.
+class ContractionHierarchy
+{
+public:
+    // What one query settled, for visualization
+    struct QueryTrace {
+        QVector<int> settled;   // In settling order
+        QVector<bool> backward; // Per settled node: reached from the target side
+        int meeting = -1;       // Highest ranked node on the shortest path
+        QVector<int> pathEdges; // Edge ids of the input graph, source to target
+    };
+
+    // Contracts every node, ordered by edge difference (shortcuts added minus
+    // arcs removed) plus contracted neighbors, with lazy priority updates
+    void build(const CsrGraph& graph);
+
+    bool isEmpty() const { return m_rank.isEmpty(); }
+    int rank(int node) const { return m_rank[node]; }
+    const QVector<int>& order() const { return m_order; }                // Nodes in contraction order
+    const QVector<int>& shortcutsAdded() const { return m_shortcutsAdded; } // Per contraction, in order
+    int shortcutCount() const { return (int)m_arcs.size() - m_inputArcs; }
+
+    // Exact shortest distance. Reuses scratch arrays between calls, so one query runs at a time.
+    GraphKernels::PathSearch query(int source, int target, QueryTrace* trace = nullptr);
+
+private:
+    // An input arc (first == -1, second is its input edge id) or a shortcut,
+    // which stands for arcs 'first' then 'second' of m_arcs
+    struct Arc {
+        int from;
+        int to;
+        int weight;
+        int first;
+        int second;
+    };
+
+    std::vector<Arc> m_arcs;
+    int m_inputArcs = 0;
+    QVector<int> m_rank;
+    QVector<int> m_order;
+    QVector<int> m_shortcutsAdded;
+
+    // [0]: arcs toward higher ranks, for the forward search; [1]: arcs from
+    // higher ranks, reversed, for the backward search. Their edge ids index m_arcUp.
+    CsrGraph m_up[2];
+    QVector<int> m_arcUp[2]; // m_arcs index of each edge id of m_up
+
+    // Query scratch, reset through the touched lists
+    QVector<long long> m_dist[2];
+    QVector<int> m_parentArc[2];
+    QVector<int> m_touched[2];
+    DaryHeap<long long> m_open[2];
+
+    void appendPath(int arc, QVector<int>& edges) const;
+};
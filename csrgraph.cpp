@@ -0,0 +1,271 @@
+#include "csrgraph.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Gives every arc of edge 'edge' leaving u, overlay included, the id 'newId'
+// (-1 tombstones them); returns how many of them sat in the base arrays
+int relabelArcs(CsrGraph& graph, int u, int edge, int newId)
+{
+    int inBase = 0;
+    for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+        if (graph.edgeIds[arc] != edge) continue;
+        graph.edgeIds[arc] = newId;
+        inBase++;
+    }
+    auto extra = graph.overflow.find(u);
+    if (extra == graph.overflow.end()) return inBase;
+    QVector<CsrGraph::Arc>& arcs = *extra;
+    for (int i = arcs.size() - 1; i >= 0; --i) {
+        if (arcs[i].edge != edge) continue;
+        if (newId >= 0) {
+            arcs[i].edge = newId;
+            continue;
+        }
+        arcs[i] = arcs.last();
+        arcs.removeLast();
+        graph.overflowArcs--;
+    }
+    if (arcs.isEmpty()) graph.overflow.erase(extra);
+    return inBase;
+}
+} // namespace
+
+CsrGraph CsrGraph::build(int nodeCount, const QVector<GraphEdge>& edges, bool directed)
+{
+    CsrGraph graph;
+    graph.nodeCount = nodeCount;
+    graph.edgeCount = edges.size();
+    graph.directed = directed;
+    graph.xs.fill(0.0, nodeCount);
+    graph.ys.fill(0.0, nodeCount);
+
+    // 1. Count the arcs leaving each node, then prefix-sum into offsets
+    graph.offsets.fill(0, nodeCount + 1);
+    for (const GraphEdge& e : edges) {
+        graph.offsets[e.from + 1]++;
+        if (!directed) graph.offsets[e.to + 1]++;
+    }
+    for (int u = 0; u < nodeCount; ++u) graph.offsets[u + 1] += graph.offsets[u];
+
+    // 2. Scatter the arcs, using a moving cursor per node
+    int arcCount = graph.offsets[nodeCount];
+    graph.targets.resize(arcCount);
+    graph.weights.resize(arcCount);
+    graph.edgeIds.resize(arcCount);
+
+    QVector<int> cursor = graph.offsets;
+    for (int id = 0; id < edges.size(); ++id) {
+        const GraphEdge& e = edges[id];
+        int arc = cursor[e.from]++;
+        graph.targets[arc] = e.to;
+        graph.weights[arc] = e.weight;
+        graph.edgeIds[arc] = id;
+
+        if (!directed) {
+            arc = cursor[e.to]++;
+            graph.targets[arc] = e.from;
+            graph.weights[arc] = e.weight;
+            graph.edgeIds[arc] = id;
+        }
+    }
+    return graph;
+}
+
+CsrGraph CsrGraph::buildParallel(int nodeCount, const QVector<QVector<GraphEdge>>& parts, bool directed)
+{
+    int partCount = parts.size();
+    auto forEachPart = [partCount](auto work) {
+        std::vector<std::thread> workers;
+        for (int p = 1; p < partCount; ++p) workers.emplace_back(work, p);
+        if (partCount > 0) work(0);
+        for (std::thread& worker : workers) worker.join();
+    };
+
+    CsrGraph graph;
+    graph.nodeCount = nodeCount;
+    graph.directed = directed;
+    graph.xs.fill(0.0, nodeCount);
+    graph.ys.fill(0.0, nodeCount);
+
+    QVector<int> firstId(partCount + 1, 0);
+    for (int p = 0; p < partCount; ++p) firstId[p + 1] = firstId[p] + parts[p].size();
+    graph.edgeCount = firstId[partCount];
+
+    // 1. Each part counts the arcs it adds to every node
+    QVector<QVector<int>> counts(partCount);
+    forEachPart([&](int p) {
+        QVector<int>& count = counts[p];
+        count.fill(0, nodeCount);
+        for (const GraphEdge& e : parts[p]) {
+            count[e.from]++;
+            if (!directed) count[e.to]++;
+        }
+    });
+
+    // 2. Node-major prefix sum: node u's arcs from part 0 come first, then part 1...
+    //    which is exactly the order build() produces. counts become write cursors.
+    graph.offsets.resize(nodeCount + 1);
+    int arc = 0;
+    for (int u = 0; u < nodeCount; ++u) {
+        graph.offsets[u] = arc;
+        for (int p = 0; p < partCount; ++p) {
+            int count = counts[p][u];
+            counts[p][u] = arc;
+            arc += count;
+        }
+    }
+    graph.offsets[nodeCount] = arc;
+
+    graph.targets.resize(arc);
+    graph.weights.resize(arc);
+    graph.edgeIds.resize(arc);
+
+    // 3. Each part scatters into its own disjoint slots
+    forEachPart([&](int p) {
+        QVector<int>& cursor = counts[p];
+        int* targets = graph.targets.data();
+        int* weights = graph.weights.data();
+        int* edgeIds = graph.edgeIds.data();
+        int id = firstId[p];
+        for (const GraphEdge& e : parts[p]) {
+            int slot = cursor[e.from]++;
+            targets[slot] = e.to;
+            weights[slot] = e.weight;
+            edgeIds[slot] = id;
+
+            if (!directed) {
+                slot = cursor[e.to]++;
+                targets[slot] = e.from;
+                weights[slot] = e.weight;
+                edgeIds[slot] = id;
+            }
+            id++;
+        }
+    });
+    return graph;
+}
+
+CsrGraph CsrGraph::reversed() const
+{
+    if (!directed) return *this;
+    if (hasOverlay()) {
+        CsrGraph plain = *this;
+        plain.compact();
+        return plain.reversed();
+    }
+
+    CsrGraph reverse;
+    reverse.nodeCount = nodeCount;
+    reverse.edgeCount = edgeCount;
+    reverse.directed = true;
+    reverse.xs = xs;
+    reverse.ys = ys;
+
+    reverse.offsets.fill(0, nodeCount + 1);
+    for (int target : targets) reverse.offsets[target + 1]++;
+    for (int u = 0; u < nodeCount; ++u) reverse.offsets[u + 1] += reverse.offsets[u];
+
+    reverse.targets.resize(targets.size());
+    reverse.weights.resize(targets.size());
+    reverse.edgeIds.resize(targets.size());
+    QVector<int> cursor = reverse.offsets;
+    for (int u = 0; u < nodeCount; ++u) {
+        for (int arc = arcBegin(u); arc < arcEnd(u); ++arc) {
+            int slot = cursor[targets[arc]]++;
+            reverse.targets[slot] = u;
+            reverse.weights[slot] = weights[arc];
+            reverse.edgeIds[slot] = edgeIds[arc];
+        }
+    }
+    return reverse;
+}
+
+QVector<GraphEdge> CsrGraph::edgeList() const
+{
+    QVector<GraphEdge> edges(edgeCount);
+    for (int u = 0; u < nodeCount; ++u) {
+        forEachArc(u, [&](int target, int weight, int edge) {
+            if (directed || u <= target) edges[edge] = {u, target, weight};
+        });
+    }
+    return edges;
+}
+
+void CsrGraph::setEdgeWeight(int edge, int from, int to, int weight)
+{
+    for (int u : {from, to}) {
+        for (int arc = arcBegin(u); arc < arcEnd(u); ++arc) {
+            if (edgeIds[arc] == edge) weights[arc] = weight;
+        }
+        auto extra = overflow.find(u);
+        if (extra != overflow.end()) {
+            for (Arc& a : *extra) {
+                if (a.edge == edge) a.weight = weight;
+            }
+        }
+        if (directed || from == to) return;
+    }
+}
+
+void CsrGraph::insertEdge(int from, int to, int weight)
+{
+    int edge = edgeCount++;
+    overflow[from].append({to, weight, edge});
+    overflowArcs++;
+    if (directed) return;
+    overflow[to].append({from, weight, edge}); // A self-loop gets both arcs at 'from', as in build()
+    overflowArcs++;
+}
+
+void CsrGraph::removeEdge(int edge, int from, int to, int lastFrom, int lastTo)
+{
+    tombstones += relabelArcs(*this, from, edge, -1);
+    if (!directed && to != from) tombstones += relabelArcs(*this, to, edge, -1);
+
+    int last = --edgeCount;
+    if (last == edge) return;
+    relabelArcs(*this, lastFrom, last, edge);
+    if (!directed && lastTo != lastFrom) relabelArcs(*this, lastTo, last, edge);
+}
+
+void CsrGraph::compact()
+{
+    if (!hasOverlay()) return;
+
+    QVector<int> compacted(nodeCount + 1, 0);
+    for (int u = 0; u < nodeCount; ++u) {
+        int live = 0;
+        forEachArc(u, [&live](int, int, int) { live++; });
+        compacted[u + 1] = compacted[u] + live;
+    }
+
+    int arcs = compacted[nodeCount];
+    QVector<int> newTargets(arcs);
+    QVector<int> newWeights(arcs);
+    QVector<int> newEdgeIds(arcs);
+    for (int u = 0; u < nodeCount; ++u) {
+        int slot = compacted[u];
+        forEachArc(u, [&](int target, int weight, int edge) {
+            newTargets[slot] = target;
+            newWeights[slot] = weight;
+            newEdgeIds[slot] = edge;
+            slot++;
+        });
+    }
+
+    offsets = std::move(compacted);
+    targets = std::move(newTargets);
+    weights = std::move(newWeights);
+    edgeIds = std::move(newEdgeIds);
+    overflow.clear();
+    tombstones = 0;
+    overflowArcs = 0;
+}
+
+long long CsrGraph::memoryBytes() const
+{
+    return (long long)(offsets.size() + targets.size() + weights.size() + edgeIds.size()) * sizeof(int)
+           + (long long)(xs.size() + ys.size()) * sizeof(double) + (long long)overflowArcs * sizeof(Arc);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QHash>
+#include <QPointF>
+#include <QVector>
+
+// One input edge for CsrGraph::build()
+struct GraphEdge {
+    int from;
+    int to;
+    int weight;
+};
+
+// Compressed sparse row graph. The arcs leaving node u occupy the index range
+// [offsets[u], offsets[u + 1]) of targets, weights and edgeIds, so a traversal
+// reads each neighbor list as one contiguous run instead of chasing map nodes.
+// An undirected edge is stored as two arcs that share its edge id.
+struct CsrGraph {
+    int nodeCount = 0;
+    int edgeCount = 0; // Input edges; arcs = edgeCount, or 2 * edgeCount if undirected
+    bool directed = false;
+
+    QVector<int> offsets; // nodeCount + 1 entries
+    QVector<int> targets;
+    QVector<int> weights;
+    QVector<int> edgeIds;
+
+    // Node positions, struct-of-arrays
+    QVector<double> xs;
+    QVector<double> ys;
+
+    // Update overlay: inserting or deleting an edge leaves the arrays above in
+    // place. A deleted arc keeps its slot with edge id -1 (a tombstone), and an
+    // inserted arc goes to the overflow list of its source node. forEachArc()
+    // and the update methods below see both; every other reader expects plain
+    // CSR and needs compact() first once hasOverlay().
+    struct Arc {
+        int target;
+        int weight;
+        int edge;
+    };
+    QHash<int, QVector<Arc>> overflow; // By source node
+    int tombstones = 0;
+    int overflowArcs = 0;
+
+    // Counting sort of the edges by source node, O(V + E). Positions start at the origin.
+    static CsrGraph build(int nodeCount, const QVector<GraphEdge>& edges, bool directed = false);
+
+    // Same graph as build() on the concatenated parts, but each part is counted
+    // and scattered by its own thread. Costs one count array per part.
+    static CsrGraph buildParallel(int nodeCount, const QVector<QVector<GraphEdge>>& parts, bool directed = false);
+
+    // Every arc flipped (u->v becomes v->u), keeping edge ids; undirected graphs come back unchanged
+    CsrGraph reversed() const;
+
+    // Input edges indexed by edge id, the inverse of build()
+    QVector<GraphEdge> edgeList() const;
+
+    // Changes the weight of edge 'edge' (from 'from' to 'to') in place: O(degree), no rebuild
+    void setEdgeWeight(int edge, int from, int to, int weight);
+
+    // Adds an edge with the next id, edgeCount, to the overlay: O(1)
+    void insertEdge(int from, int to, int weight);
+
+    // Tombstones edge 'edge' (from 'from' to 'to'), and the last edge (from
+    // lastFrom to lastTo) takes over its id, as Graph::deleteEdge() numbers
+    // them: O(degree) of the nodes involved
+    void removeEdge(int edge, int from, int to, int lastFrom, int lastTo);
+
+    // Folds the overlay back into plain CSR, O(V + E). Edge ids are kept; each
+    // node's inserted arcs follow its original ones.
+    void compact();
+
+    bool hasOverlay() const { return tombstones > 0 || overflowArcs > 0; }
+    int overlaySize() const { return tombstones + overflowArcs; }
+
+    // Calls visit(target, weight, edge) for every live arc leaving u, overlay included
+    template<class Visit>
+    void forEachArc(int u, Visit visit) const
+    {
+        for (int arc = offsets[u]; arc < offsets[u + 1]; ++arc) {
+            if (edgeIds[arc] >= 0) visit(targets[arc], weights[arc], edgeIds[arc]);
+        }
+        if (overflowArcs == 0) return;
+        auto extra = overflow.constFind(u);
+        if (extra == overflow.constEnd()) return;
+        for (const Arc& a : *extra) visit(a.target, a.weight, a.edge);
+    }
+
+    int arcBegin(int u) const { return offsets[u]; }
+    int arcEnd(int u) const { return offsets[u + 1]; }
+    int degree(int u) const { return offsets[u + 1] - offsets[u]; } // Without the overlay
+    int arcCount() const { return targets.size() - tombstones + overflowArcs; }
+    QPointF position(int u) const { return QPointF(xs[u], ys[u]); }
+    long long memoryBytes() const;
+};
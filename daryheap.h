@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QVector>
+#include <algorithm>
+
+// Indexed min-heap over item ids 0..capacity-1 with decrease-key. Each item is
+// in the heap at most once, so shortest-path searches need no lazy deletion,
+// and the heap never grows beyond the node count. Arity 4 (the default) halves
+// the height of a binary heap, so sift-up after a decrease-key is shorter.
+template<typename Key, int Arity = 4>
+class DaryHeap
+{
+public:
+    explicit DaryHeap(int capacity = 0) : m_position(capacity, ABSENT), m_keys(capacity) {}
+
+    void reset(int capacity)
+    {
+        m_heap.clear();
+        m_position.fill(ABSENT, capacity);
+        m_keys.resize(capacity);
+    }
+
+    // Empties the heap in time proportional to its size, not its capacity,
+    // for searches that touch a small part of a large graph
+    void clear()
+    {
+        for (int item : m_heap) m_position[item] = ABSENT;
+        m_heap.clear();
+    }
+
+    bool isEmpty() const { return m_heap.isEmpty(); }
+    int size() const { return m_heap.size(); }
+    bool contains(int item) const { return m_position[item] != ABSENT; }
+    Key key(int item) const { return m_keys[item]; }
+
+    int top() const { return m_heap[0]; }
+    Key topKey() const { return m_keys[m_heap[0]]; }
+
+    void push(int item, Key key)
+    {
+        m_keys[item] = key;
+        m_position[item] = m_heap.size();
+        m_heap.append(item);
+        siftUp(m_heap.size() - 1);
+    }
+
+    // Lowers the key of an item already in the heap
+    void decreaseKey(int item, Key key)
+    {
+        m_keys[item] = key;
+        siftUp(m_position[item]);
+    }
+
+    // Inserts the item, or lowers its key if 'key' is smaller. Returns true if the key changed.
+    bool pushOrDecrease(int item, Key key)
+    {
+        if (!contains(item)) {
+            push(item, key);
+            return true;
+        }
+        if (key < m_keys[item]) {
+            decreaseKey(item, key);
+            return true;
+        }
+        return false;
+    }
+
+    int pop()
+    {
+        int item = m_heap[0];
+        int last = m_heap.takeLast();
+        m_position[item] = ABSENT;
+        if (!m_heap.isEmpty()) {
+            m_heap[0] = last;
+            m_position[last] = 0;
+            siftDown(0);
+        }
+        return item;
+    }
+
+private:
+    static constexpr int ABSENT = -1;
+
+    QVector<int> m_heap;     // Item ids in heap order
+    QVector<int> m_position; // Index of each item in m_heap, or ABSENT
+    QVector<Key> m_keys;     // Indexed by item
+
+    void place(int index, int item)
+    {
+        m_heap[index] = item;
+        m_position[item] = index;
+    }
+
+    void siftUp(int index)
+    {
+        int item = m_heap[index];
+        Key key = m_keys[item];
+        while (index > 0) {
+            int parent = (index - 1) / Arity;
+            if (!(key < m_keys[m_heap[parent]])) break;
+            place(index, m_heap[parent]);
+            index = parent;
+        }
+        place(index, item);
+    }
+
+    void siftDown(int index)
+    {
+        int item = m_heap[index];
+        Key key = m_keys[item];
+        int count = m_heap.size();
+        while (true) {
+            int first = index * Arity + 1;
+            if (first >= count) break;
+
+            int best = first;
+            int last = std::min(first + Arity, count);
+            for (int child = first + 1; child < last; ++child) {
+                if (m_keys[m_heap[child]] < m_keys[m_heap[best]]) best = child;
+            }
+            if (!(m_keys[m_heap[best]] < key)) break;
+            place(index, m_heap[best]);
+            index = best;
+        }
+        place(index, item);
+    }
+};
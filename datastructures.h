@@ -1,12 +1,15 @@
 #pragma once
 
+#include <QByteArray>
 #include <QObject>
 #include <QVector>
 #include <QList>
 #include <QString>
 #include <QVariant>
 #include <QColor>
+#include <QPoint>
 #include <QPointF>
+#include <QSharedPointer>
 
 // Step definition for Sorting
 struct SortingStep {
@@ -25,8 +28,9 @@ struct NodeState {
     QPointF position;
     QColor color;
     QColor textColor;
+    double width;      // > 0 draws a box this wide instead of a circle (multi-key nodes)
 
-    NodeState() : id(-1), label(""), position(0,0), color(Qt::white), textColor(Qt::black) {}
+    NodeState() : id(-1), label(""), position(0,0), color(Qt::white), textColor(Qt::black), width(0) {}
 };
 
 struct EdgeState {
@@ -38,10 +42,49 @@ struct EdgeState {
     EdgeState() : fromId(-1), toId(-1), color(Qt::white), weightLabel("") {}
 };
 
+// --- Delta-encoded graph steps ---
+// A run's nodes and edges (positions, labels, weights) are built once into a
+// GraphTopology that every step shares; each step then only adds the colors
+// that changed to a change log shared by the whole run.
+struct GraphTopology {
+    QList<NodeState> nodes; // Indexed by node id
+    QList<EdgeState> edges; // Indexed by edge id
+};
+
+// Dynamic updates add, remove and relabel edges without a new topology: the
+// edge runs from fromId to toId with weightLabel (fromId -1: the id is unused),
+// and the previous* fields bring the old shape back when stepping backwards
+struct EdgeEdit {
+    int fromId;
+    int toId;
+    QString weightLabel;
+    int previousFrom;
+    int previousTo;
+    QString previousLabel;
+};
+
+struct GraphChange {
+    int index;       // Node or edge id
+    bool isEdge;
+    int edit;        // >= 0: the edge also takes the shape edits[edit] of its step
+    QColor color;
+    QColor previous; // Lets the canvas step backwards by undoing changes
+};
+
 struct GraphStep {
     QList<NodeState> nodes;
     QList<EdgeState> edges;
     QString statusMessage;
+
+    // Delta-encoded steps leave nodes/edges empty and show 'topology' with
+    // the first 'changeCount' entries of 'changes' applied
+    QSharedPointer<const GraphTopology> topology;
+    QSharedPointer<const QVector<GraphChange>> changes;
+    int changeCount = 0;
+    QSharedPointer<const QVector<EdgeEdit>> edits; // Shapes the changes refer to, if any
+
+    // Force layout frames: node positions replacing the topology's, by node id
+    QSharedPointer<const QVector<QPointF>> positions;
 };
 
 enum CellType {
@@ -52,12 +95,46 @@ enum CellType {
     END_POINT = 4
 };
 
+// --- Delta-encoded maze steps ---
+// The grid is one byte (a CellType) per cell, row-major. A run logs every
+// cell change once in a MazeTrace shared by all its steps, plus a full grid
+// every 'keyframeInterval' changes so a viewer can jump far without
+// replaying the log from the start.
+struct MazeChange {
+    int cell;         // y * width + x
+    quint8 type;
+    quint8 previous;  // Lets the canvas step backwards by undoing changes
+};
+
+struct MazeTrace {
+    int width = 0;
+    int height = 0;
+    QVector<MazeChange> changes;
+    int keyframeInterval = 1;
+    QVector<QByteArray> keyframes; // keyframes[k]: the grid after k * keyframeInterval changes
+
+    long long memoryBytes() const;
+};
+
 struct MazeStep {
-    // 2D Grid: rows x cols
-    QVector<QVector<int>> grid;
+    // Shows 'trace' with its first 'changeCount' changes applied
+    QSharedPointer<const MazeTrace> trace;
+    int changeCount = 0;
+    QString statusMessage;
+};
+
+// Step definition for matrix algorithms, drawn as a heatmap
+struct MatrixStep {
+    int size = 0;            // The matrix is size x size
+    QVector<int> values;     // Row-major; negative entries have no value and are drawn dark
+    int highlightBegin = 0;  // Rows and columns [highlightBegin, highlightEnd) are outlined
+    int highlightEnd = 0;
+    int tileSize = 0;        // > 0 draws the tile grid
+    QList<QPoint> activeTiles; // (tile column, tile row) of tiles updated in this step
     QString statusMessage;
 };
 
 Q_DECLARE_METATYPE(GraphStep)
 Q_DECLARE_METATYPE(SortingStep)
 Q_DECLARE_METATYPE(MazeStep)
+Q_DECLARE_METATYPE(MatrixStep)
@@ -0,0 +1,359 @@
+#include "dynamicrepair.h"
+#include "graphkernels.h"
+
+using GraphKernels::UNREACHABLE;
+
+// --- DynamicShortestPaths ---
+
+void DynamicShortestPaths::compute(const CsrGraph& graph, int source)
+{
+    int n = graph.nodeCount;
+    m_source = source;
+    m_dist.fill(UNREACHABLE, n);
+    m_parent.fill(-1, n);
+    m_parentEdge.fill(-1, n);
+    m_childOf.fill(-1, graph.edgeCount);
+    m_mark.fill(0, n);
+    m_stamp = 0;
+    m_open.reset(n);
+
+    m_dist[source] = 0;
+    m_open.push(source, 0);
+    while (!m_open.isEmpty()) {
+        int u = m_open.pop();
+        graph.forEachArc(u, [&](int v, int weight, int edge) {
+            long long candidate = m_dist[u] + weight;
+            if (m_dist[v] == UNREACHABLE || candidate < m_dist[v]) {
+                m_dist[v] = candidate;
+                setParent(v, u, edge);
+                m_open.pushOrDecrease(v, candidate);
+            }
+        });
+    }
+}
+
+void DynamicShortestPaths::setParent(int node, int parent, int edge)
+{
+    int previous = m_parentEdge[node];
+    if (previous >= 0 && m_childOf[previous] == node) m_childOf[previous] = -1;
+    m_parent[node] = parent;
+    m_parentEdge[node] = edge;
+    if (edge >= 0) m_childOf[edge] = node;
+}
+
+QVector<int> DynamicShortestPaths::arcDecreased(const CsrGraph& graph, int from, int to, int weight, int edge)
+{
+    while (m_childOf.size() <= edge) m_childOf.append(-1); // A new edge
+
+    QVector<int> changed;
+    if (m_dist[from] == UNREACHABLE) return changed;
+    long long candidate = m_dist[from] + weight;
+    if (m_dist[to] != UNREACHABLE && candidate >= m_dist[to]) return changed;
+
+    m_stamp++;
+    m_open.clear();
+    m_dist[to] = candidate;
+    setParent(to, from, edge);
+    m_open.push(to, candidate);
+    m_mark[to] = m_stamp;
+    changed.append(to);
+
+    while (!m_open.isEmpty()) {
+        int u = m_open.pop();
+        graph.forEachArc(u, [&](int v, int weight, int edge) {
+            long long improved = m_dist[u] + weight;
+            if (m_dist[v] != UNREACHABLE && improved >= m_dist[v]) return;
+            m_dist[v] = improved;
+            setParent(v, u, edge);
+            m_open.pushOrDecrease(v, improved);
+            if (m_mark[v] != m_stamp) {
+                m_mark[v] = m_stamp;
+                changed.append(v);
+            }
+        });
+    }
+    return changed;
+}
+
+QVector<int> DynamicShortestPaths::detachEdge(int edge)
+{
+    if (edge >= m_childOf.size() || m_childOf[edge] < 0) return {};
+    int node = m_childOf[edge];
+    setParent(node, -1, -1);
+    return {node};
+}
+
+QVector<int> DynamicShortestPaths::edgeIncreased(const CsrGraph& graph, const CsrGraph& reverse, const QVector<int>& detached)
+{
+    QVector<int> affected;
+    m_stamp++; // m_mark == m_stamp: affected
+    m_open.clear();
+    for (int node : detached) {
+        if (m_dist[node] != UNREACHABLE) m_open.push(node, m_dist[node]);
+    }
+
+    // Candidates leave the queue in distance order, so every node that could
+    // still vouch for one (a shorter distance, positive arc) is already decided
+    while (!m_open.isEmpty()) {
+        int x = m_open.pop();
+        bool kept = false;
+        reverse.forEachArc(x, [&](int y, int weight, int edge) {
+            if (!kept && weight > 0 && m_mark[y] != m_stamp && m_dist[y] != UNREACHABLE && m_dist[y] + weight == m_dist[x]) {
+                setParent(x, y, edge);
+                kept = true;
+            }
+        });
+        if (kept) continue;
+
+        m_mark[x] = m_stamp;
+        affected.append(x);
+        graph.forEachArc(x, [&](int child, int, int edge) {
+            if (m_parent[child] == x && m_parentEdge[child] == edge) m_open.push(child, m_dist[child]);
+        });
+    }
+
+    // Re-solve the affected region, seeded from the best unaffected in-neighbor of each node
+    for (int x : affected) {
+        m_dist[x] = UNREACHABLE;
+        setParent(x, -1, -1);
+    }
+    for (int x : affected) {
+        reverse.forEachArc(x, [&](int y, int weight, int edge) {
+            if (m_mark[y] == m_stamp || m_dist[y] == UNREACHABLE) return;
+            long long candidate = m_dist[y] + weight;
+            if (m_dist[x] == UNREACHABLE || candidate < m_dist[x]) {
+                m_dist[x] = candidate;
+                setParent(x, y, edge);
+            }
+        });
+        if (m_dist[x] != UNREACHABLE) m_open.push(x, m_dist[x]);
+    }
+    while (!m_open.isEmpty()) {
+        int u = m_open.pop();
+        graph.forEachArc(u, [&](int v, int weight, int edge) {
+            if (m_mark[v] != m_stamp) return;
+            long long candidate = m_dist[u] + weight;
+            if (m_dist[v] == UNREACHABLE || candidate < m_dist[v]) {
+                m_dist[v] = candidate;
+                setParent(v, u, edge);
+                m_open.pushOrDecrease(v, candidate);
+            }
+        });
+    }
+    return affected;
+}
+
+void DynamicShortestPaths::eraseEdge(int edge)
+{
+    int last = m_childOf.size() - 1;
+    if (edge != last) {
+        int child = m_childOf[last];
+        m_childOf[edge] = child;
+        if (child >= 0) m_parentEdge[child] = edge;
+    }
+    m_childOf.removeLast();
+}
+
+// --- DynamicSpanningForest ---
+
+void DynamicSpanningForest::compute(const CsrGraph& graph)
+{
+    int n = graph.nodeCount;
+    m_parent.fill(-1, n);
+    m_parentEdge.fill(-1, n);
+    m_parentWeight.fill(0, n);
+    m_childOf.fill(-1, graph.edgeCount);
+    m_weight = 0;
+    m_edgeCount = 0;
+    m_mark.fill(0, n);
+    m_stamp = 0;
+
+    QVector<bool> spanned(n, false);
+    QVector<int> via(n, -1);     // Tree node that offers the lightest known edge
+    QVector<int> viaEdge(n, -1);
+    DaryHeap<int> open(n);       // Key: weight of that edge
+    for (int root = 0; root < n; ++root) {
+        if (spanned[root]) continue;
+        open.push(root, 0);
+        while (!open.isEmpty()) {
+            int weight = open.topKey();
+            int u = open.pop();
+            spanned[u] = true;
+            if (via[u] >= 0) link(u, via[u], viaEdge[u], weight);
+            graph.forEachArc(u, [&](int v, int weight, int edge) {
+                if (spanned[v]) return;
+                if (open.pushOrDecrease(v, weight)) {
+                    via[v] = u;
+                    viaEdge[v] = edge;
+                }
+            });
+        }
+    }
+}
+
+void DynamicSpanningForest::link(int child, int parent, int edge, int weight)
+{
+    m_parent[child] = parent;
+    m_parentEdge[child] = edge;
+    m_parentWeight[child] = weight;
+    m_childOf[edge] = child;
+    m_weight += weight;
+    m_edgeCount++;
+}
+
+void DynamicSpanningForest::makeRoot(int node)
+{
+    int previous = -1;
+    int previousEdge = -1;
+    int previousWeight = 0;
+    for (int current = node; current != -1;) {
+        int next = m_parent[current];
+        int nextEdge = m_parentEdge[current];
+        int nextWeight = m_parentWeight[current];
+        m_parent[current] = previous;
+        m_parentEdge[current] = previousEdge;
+        m_parentWeight[current] = previousWeight;
+        if (previousEdge >= 0) m_childOf[previousEdge] = current;
+        previous = current;
+        previousEdge = nextEdge;
+        previousWeight = nextWeight;
+        current = next;
+    }
+}
+
+DynamicSpanningForest::Repair DynamicSpanningForest::edgeDecreased(int a, int b, int weight, int edge)
+{
+    while (m_childOf.size() <= edge) m_childOf.append(-1); // A new edge
+
+    Repair repair;
+    if (a == b) return repair;
+
+    // A forest edge that got lighter stays in the forest
+    if (contains(edge)) {
+        int child = m_childOf[edge];
+        m_weight += weight - m_parentWeight[child];
+        m_parentWeight[child] = weight;
+        repair.nodes = {a, b};
+        return repair;
+    }
+
+    // Climb from both ends in lockstep until one side reaches a node the other
+    // marked (their lowest common ancestor), so the walk is about as long as the cycle
+    int base = m_stamp + 1; // Side 0 marks base, side 1 marks base + 1
+    m_stamp += 2;
+    QVector<int> walked[2] = {{a}, {b}};
+    int at[2] = {a, b};
+    m_mark[a] = base;
+    m_mark[b] = base + 1;
+    int meet = -1;
+    int meetSide = 0;
+    while (meet < 0 && (at[0] != -1 || at[1] != -1)) {
+        for (int side = 0; side < 2 && meet < 0; ++side) {
+            if (at[side] == -1) continue;
+            int up = m_parent[at[side]];
+            at[side] = up;
+            if (up == -1) continue;
+            if (m_mark[up] == base + 1 - side) {
+                meet = up;
+                meetSide = side;
+            } else {
+                m_mark[up] = base + side;
+                walked[side].append(up);
+            }
+        }
+    }
+
+    repair.nodes = walked[0] + walked[1];
+    if (meet < 0) {
+        // Different trees: the new edge joins them
+        makeRoot(b);
+        link(b, a, edge, weight);
+        repair.added = edge;
+        return repair;
+    }
+
+    // The cycle is the tree path a..meet..b plus the edge; drop its heaviest edge if heavier
+    walked[1 - meetSide].resize(walked[1 - meetSide].indexOf(meet)); // The other side may have climbed past
+    int heaviest = -1;
+    int heaviestSide = 0;
+    for (int side = 0; side < 2; ++side) {
+        for (int node : walked[side]) {
+            if (heaviest < 0 || m_parentWeight[node] > m_parentWeight[heaviest]) {
+                heaviest = node;
+                heaviestSide = side;
+            }
+        }
+    }
+    if (heaviest < 0 || m_parentWeight[heaviest] <= weight) return repair;
+
+    repair.removed = m_parentEdge[heaviest];
+    detachEdge(repair.removed);
+    int end = heaviestSide == 0 ? a : b; // Now in the subtree cut off below 'heaviest'
+    makeRoot(end);
+    link(end, heaviestSide == 0 ? b : a, edge, weight);
+    repair.added = edge;
+    return repair;
+}
+
+int DynamicSpanningForest::detachEdge(int edge)
+{
+    if (edge >= m_childOf.size() || m_childOf[edge] < 0) return -1;
+    int child = m_childOf[edge];
+    m_childOf[edge] = -1;
+    m_weight -= m_parentWeight[child];
+    m_edgeCount--;
+    m_parent[child] = -1;
+    m_parentEdge[child] = -1;
+    m_parentWeight[child] = 0;
+    return child;
+}
+
+DynamicSpanningForest::Repair DynamicSpanningForest::reconnect(const CsrGraph& graph, int root)
+{
+    Repair repair;
+    if (root < 0) return repair;
+
+    // The subtree hangs from 'root' through parent pointers; tree arcs lead to children
+    m_stamp++;
+    m_mark[root] = m_stamp;
+    repair.nodes.append(root);
+    for (int i = 0; i < repair.nodes.size(); ++i) {
+        int u = repair.nodes[i];
+        graph.forEachArc(u, [&](int v, int, int edge) {
+            if (m_parent[v] == u && m_parentEdge[v] == edge && m_mark[v] != m_stamp) {
+                m_mark[v] = m_stamp;
+                repair.nodes.append(v);
+            }
+        });
+    }
+
+    // Lightest edge across the cut, ties broken by edge id
+    CsrGraph::Arc best = {-1, 0, -1};
+    int bestFrom = -1;
+    for (int u : repair.nodes) {
+        graph.forEachArc(u, [&](int v, int weight, int edge) {
+            if (m_mark[v] == m_stamp) return;
+            if (best.edge < 0 || weight < best.weight || (weight == best.weight && edge < best.edge)) {
+                best = {v, weight, edge};
+                bestFrom = u;
+            }
+        });
+    }
+    if (best.edge < 0) return repair; // The subtree is a component of its own now
+
+    makeRoot(bestFrom);
+    link(bestFrom, best.target, best.edge, best.weight);
+    repair.added = best.edge;
+    return repair;
+}
+
+void DynamicSpanningForest::eraseEdge(int edge)
+{
+    int last = m_childOf.size() - 1;
+    if (edge != last) {
+        int child = m_childOf[last];
+        m_childOf[edge] = child;
+        if (child >= 0) m_parentEdge[child] = edge;
+    }
+    m_childOf.removeLast();
+}
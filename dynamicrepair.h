@@ -0,0 +1,109 @@
+#pragma once
+
+#include "csrgraph.h"
+#include "daryheap.h"
+#include <QVector>
+
+// Results that follow a changing graph. After each edge insert, delete or
+// reweight, only the part of the result the change can reach is recomputed,
+// so an update costs time proportional to what changed rather than to the graph.
+//
+// Both classes index edges like CsrGraph (input edge ids). A deleted edge is
+// swap-removed: the last edge id takes its place, as Graph::deleteEdge() does.
+// They read arcs through CsrGraph::forEachArc(), so the graphs may carry an
+// update overlay.
+
+// Single-source shortest-path tree with Ramalingam-Reps style repair
+class DynamicShortestPaths
+{
+public:
+    void compute(const CsrGraph& graph, int source);
+
+    bool isEmpty() const { return m_source < 0; }
+    int source() const { return m_source; }
+    long long distance(int node) const { return m_dist[node]; } // GraphKernels::UNREACHABLE if no path
+    int parent(int node) const { return m_parent[node]; }
+    int parentEdge(int node) const { return m_parentEdge[node]; }
+
+    // The arc from->to (edge id 'edge') was added or got lighter. Improvements
+    // spread by Dijkstra from 'to', only through nodes they improve. Returns those nodes.
+    QVector<int> arcDecreased(const CsrGraph& graph, int from, int to, int weight, int edge);
+
+    // Call before an edge gets heavier or is deleted: unlinks the node that
+    // reached the tree through it and returns it (empty if the edge is not a tree edge)
+    QVector<int> detachEdge(int edge);
+
+    // After detachEdge() and the graph change: a node keeps its distance if a
+    // tight arc from an unaffected node still reaches it; the rest (the
+    // affected region, found in distance order) is re-solved by Dijkstra seeded
+    // from its unaffected neighbors. Returns the affected nodes.
+    QVector<int> edgeIncreased(const CsrGraph& graph, const CsrGraph& reverse, const QVector<int>& detached);
+
+    // Swap-removes a detached edge from the edge numbering
+    void eraseEdge(int edge);
+
+private:
+    int m_source = -1;
+    QVector<long long> m_dist;
+    QVector<int> m_parent;
+    QVector<int> m_parentEdge;
+    QVector<int> m_childOf; // Per edge id: the node whose parent edge it is, or -1
+
+    // Repair scratch: m_mark equals m_stamp for nodes of the current repair
+    QVector<int> m_mark;
+    int m_stamp = 0;
+    DaryHeap<long long> m_open;
+
+    void setParent(int node, int parent, int edge);
+};
+
+// Minimum spanning forest of an undirected graph with edge-swap repair:
+// a lighter or new edge replaces the heaviest edge on the cycle it closes, and
+// a heavier or deleted forest edge is replaced by the lightest edge across the cut.
+class DynamicSpanningForest
+{
+public:
+    // Prim from every node not spanned yet
+    void compute(const CsrGraph& graph);
+
+    bool isEmpty() const { return m_parent.isEmpty(); }
+    long long weight() const { return m_weight; }
+    int edgeCount() const { return m_edgeCount; }
+    bool contains(int edge) const { return m_childOf[edge] >= 0; }
+    int parent(int node) const { return m_parent[node]; }
+    int parentEdge(int node) const { return m_parentEdge[node]; }
+
+    struct Repair {
+        int added = -1;     // Edge id that joined the forest, or -1
+        int removed = -1;   // Edge id that left it, or -1
+        QVector<int> nodes; // Nodes examined: the cycle path or the cut-off subtree
+    };
+
+    // Edge 'edge' between a and b was added or got lighter
+    Repair edgeDecreased(int a, int b, int weight, int edge);
+
+    // Call before a forest edge gets heavier or is deleted: cuts it and returns
+    // the root of the cut-off subtree (-1 if the edge is not in the forest)
+    int detachEdge(int edge);
+
+    // After detachEdge() and the graph change: joins the cut-off subtree back
+    // through the lightest edge that leaves it, if any is left
+    Repair reconnect(const CsrGraph& graph, int root);
+
+    // Swap-removes a detached edge from the edge numbering
+    void eraseEdge(int edge);
+
+private:
+    QVector<int> m_parent; // -1 at each tree's root
+    QVector<int> m_parentEdge;
+    QVector<int> m_parentWeight;
+    QVector<int> m_childOf; // Per edge id: the node whose parent edge it is, or -1
+    long long m_weight = 0;
+    int m_edgeCount = 0;
+
+    QVector<int> m_mark; // Same scheme as in DynamicShortestPaths
+    int m_stamp = 0;
+
+    void link(int child, int parent, int edge, int weight);
+    void makeRoot(int node); // Reverses the parent pointers from 'node' up to its root
+};
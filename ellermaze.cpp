@@ -0,0 +1,143 @@
+#include "ellermaze.h"
+#include "datastructures.h"
+#include <QFile>
+#include <algorithm>
+
+const int PBM_BUFFER_BYTES = 1 << 24;
+
+EllerMaze::EllerMaze(int width, unsigned seed)
+    : m_width(std::max(width, 3)),
+    m_columns((m_width - 1) / 2),
+    m_rng(seed),
+    m_sets(m_columns),
+    m_parent(m_columns),
+    m_size(m_columns, 0),
+    m_down(m_columns, 0)
+{
+    for (int c = 0; c < m_columns; ++c) m_sets[c] = c; // The first row starts with every cell apart
+}
+
+long long EllerMaze::memoryBytes() const
+{
+    return (long long)m_columns * (3 * sizeof(int) + sizeof(char));
+}
+
+// One fair random bit; draws 64 at a time
+bool EllerMaze::coin()
+{
+    if (m_bitCount == 0) {
+        m_bits = m_rng.next();
+        m_bitCount = 64;
+    }
+    bool bit = m_bits & 1;
+    m_bits >>= 1;
+    m_bitCount--;
+    return bit;
+}
+
+int EllerMaze::find(int label)
+{
+    while (m_parent[label] != label) {
+        m_parent[label] = m_parent[m_parent[label]]; // Path halving
+        label = m_parent[label];
+    }
+    return label;
+}
+
+void EllerMaze::nextRows(QByteArray& rows, bool last)
+{
+    if (m_rowsGenerated == 0) {
+        rows.append(QByteArray(m_width, (char)CellType::WALL));
+        m_rowsGenerated = 1;
+    }
+    int offset = rows.size();
+    rows.append(QByteArray(2 * m_width, (char)CellType::WALL));
+    char* cells = rows.data() + offset;
+    char* below = cells + m_width;
+    m_rowsGenerated += 2;
+
+    // Join neighbours from different sets at random; the last row joins them
+    // all, so every cell ends up connected
+    for (int c = 0; c < m_columns; ++c) {
+        m_parent[m_sets[c]] = m_sets[c];
+        cells[2 * c + 1] = (char)CellType::PATH;
+    }
+    for (int c = 0; c + 1 < m_columns; ++c) {
+        int a = find(m_sets[c]), b = find(m_sets[c + 1]);
+        if (a == b || !(last || coin())) continue; // Same set: joining again would make a loop
+        m_parent[a] = b;
+        cells[2 * c + 2] = (char)CellType::PATH;
+    }
+    if (last) return; // 'below' stays the bottom border
+
+    std::fill(m_down.begin(), m_down.end(), 0);
+    for (int c = 0; c < m_columns; ++c) {
+        m_sets[c] = find(m_sets[c]);
+        m_size[m_sets[c]]++;
+    }
+
+    // Each set goes down at least once, or the cells above would be cut off;
+    // its other cells go down at random. The rest start new sets.
+    for (int c = 0; c < m_columns; ++c) {
+        int set = m_sets[c];
+        int remaining = --m_size[set];
+        if (coin() || (remaining == 0 && !m_down[set])) {
+            m_down[set] = 1;
+            below[2 * c + 1] = (char)CellType::PATH;
+        } else {
+            m_sets[c] = -1;
+        }
+    }
+
+    // New sets take the labels no set carried down
+    int label = 0;
+    for (int c = 0; c < m_columns; ++c) {
+        if (m_sets[c] >= 0) continue;
+        while (m_down[label]) label++;
+        m_sets[c] = label++;
+    }
+}
+
+bool EllerMaze::saveAsPbm(const QString& path, int width, int height, unsigned seed, QString* error)
+{
+    if (width < 3 || height < 3) {
+        if (error) *error = "Maze too small";
+        return false;
+    }
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        if (error) *error = "Cannot open " + path + ": " + file.errorString();
+        return false;
+    }
+
+    long long gridHeight = height | 1; // Odd, so the last row of cells has a border below
+    long long cellRows = (gridHeight - 1) / 2;
+    QByteArray buffer = "P4\n" + QByteArray::number(width) + " " + QByteArray::number(gridHeight) + "\n";
+    int packedWidth = (width + 7) / 8;
+
+    EllerMaze maze(width, seed);
+    QByteArray rows;
+    for (long long r = 0; r < cellRows; ++r) {
+        rows.clear();
+        maze.nextRows(rows, r == cellRows - 1);
+
+        // One bit per cell, most significant first, set for walls
+        for (int offset = 0; offset < rows.size(); offset += width) {
+            const char* row = rows.constData() + offset;
+            int start = buffer.size();
+            buffer.append(QByteArray(packedWidth, 0));
+            char* packed = buffer.data() + start;
+            for (int x = 0; x < width; ++x) {
+                if (row[x] == (char)CellType::WALL) packed[x >> 3] |= (char)(0x80 >> (x & 7));
+            }
+        }
+        if (buffer.size() >= PBM_BUFFER_BYTES || r == cellRows - 1) {
+            if (file.write(buffer) != buffer.size()) {
+                if (error) *error = "Cannot write " + path + ": " + file.errorString();
+                return false;
+            }
+            buffer.clear();
+        }
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "fastrng.h"
+#include <QByteArray>
+#include <QString>
+#include <vector>
+
+// Eller's algorithm: builds a perfect maze one row of cells at a time. Only the
+// set each cell of the current row belongs to (which cells are already joined
+// through the rows above) is kept, so memory is O(width) however many rows are
+// made, and finished rows can be handed on and forgotten.
+//
+// Rows use Maze's layout: one CellType byte per grid column, cells on odd
+// coordinates with walls between them, WALL borders.
+class EllerMaze
+{
+public:
+    EllerMaze(int width, unsigned seed);
+
+    // Appends the grid rows of the next row of cells: the cells and the
+    // passages between them, then the row below holding the passages down.
+    // The first call also appends the top border. 'last' closes the maze: all
+    // its sets are joined and the row below is the bottom border.
+    void nextRows(QByteArray& rows, bool last = false);
+
+    int width() const { return m_width; }
+    long long rowsGenerated() const { return m_rowsGenerated; } // Grid rows, borders included
+    long long memoryBytes() const;
+
+    // Streams a width x height maze to 'path' as a binary PBM image (walls
+    // black), row by row; an even height gets one more row for the bottom border
+    static bool saveAsPbm(const QString& path, int width, int height, unsigned seed, QString* error);
+
+private:
+    int m_width;
+    int m_columns;             // Cells per row
+    FastRng m_rng;
+    quint64 m_bits = 0;        // Random bits not used yet
+    int m_bitCount = 0;
+    long long m_rowsGenerated = 0;
+
+    std::vector<int> m_sets;   // Per cell of the current row; labels are in [0, m_columns)
+    std::vector<int> m_parent; // Per label: union-find over the sets joined in this row
+    std::vector<int> m_size;   // Per label: cells of the row in the set
+    std::vector<char> m_down;  // Per label: whether the set already continues down
+
+    bool coin();
+    int find(int label);
+};
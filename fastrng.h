@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QtGlobal>
+#include <cmath>
+
+// Small, fast, seedable generator (xoshiro256**, seeded through SplitMix64) for
+// generators that draw tens of millions of numbers. The same seed always gives
+// the same sequence on every platform, unlike std::uniform_int_distribution.
+// bounded() mirrors QRandomGenerator's half-open ranges.
+class FastRng
+{
+public:
+    explicit FastRng(quint64 seed)
+    {
+        for (quint64& word : m_state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            quint64 z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    quint64 next()
+    {
+        quint64 result = rotl(m_state[1] * 5, 7) * 9;
+        quint64 t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, highest), unbiased (Lemire's multiply-and-reject)
+    quint32 bounded(quint32 highest)
+    {
+        quint64 product = (quint64)(quint32)(next() >> 32) * highest;
+        quint32 low = (quint32)product;
+        if (low < highest) {
+            quint32 threshold = -highest % highest;
+            while (low < threshold) {
+                product = (quint64)(quint32)(next() >> 32) * highest;
+                low = (quint32)product;
+            }
+        }
+        return (quint32)(product >> 32);
+    }
+
+    // Uniform in [lowest, highest)
+    int bounded(int lowest, int highest) { return lowest + (int)bounded((quint32)(highest - lowest)); }
+
+    // Uniform in [0, 1)
+    double generateDouble() { return (next() >> 11) * 0x1.0p-53; }
+
+private:
+    quint64 m_state[4];
+
+    static quint64 rotl(quint64 x, int k) { return (x << k) | (x >> (64 - k)); }
+};
@@ -0,0 +1,292 @@
+#include "forcelayout.h"
+#include "threadpool.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const double SPRING_LENGTH = 1.0; // K: the edge length the forces balance at
+const double REPULSION = 0.2;     // C, Hu's relative strength of repulsion
+const double COOLING = 0.9;       // Step factor per iteration that did not lower the energy
+const int PROGRESS_RUN = 5;       // Iterations in a row lowering the energy before the step grows
+const int LEAF_SIZE = 8;          // Nodes a cell may hold before it splits
+const int MAX_DEPTH = 16;         // Bits per axis of the Morton code
+const int STACK_SIZE = 4 * (MAX_DEPTH + 1);
+const int FORCE_GRAIN = 256;      // Nodes per chunk of the force loop
+const double MARGIN = 0.95;
+
+// 16 bits spread to the even bit positions of 32
+unsigned long long spreadBits(unsigned v)
+{
+    v &= 0xffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+}
+
+// Deterministic offset in [-0.5, 0.5) that separates nodes starting on one spot
+double jitter(int u, unsigned multiplier)
+{
+    return ((u * multiplier) % 1024) / 1024.0 - 0.5;
+}
+
+// Per-thread sums, one cache line each
+struct alignas(64) Partial {
+    long long interactions = 0;
+};
+} // namespace
+
+ForceLayout::ForceLayout(const CsrGraph& graph, const CsrGraph& reverse, ThreadPool& pool)
+    : m_graph(graph),
+    m_reverse(reverse),
+    m_pool(pool),
+    m_previousEnergy(std::numeric_limits<double>::infinity())
+{
+    int n = graph.nodeCount;
+    m_xs.resize(n);
+    m_ys.resize(n);
+    m_fx.resize(n);
+    m_fy.resize(n);
+    m_keys.resize(n);
+    m_order.resize(n);
+
+    // Keep the starting shape but rescale it to a square of about one node per K^2
+    double minX = std::numeric_limits<double>::infinity(), maxX = -minX;
+    double minY = minX, maxY = maxX;
+    for (int u = 0; u < n; ++u) {
+        minX = std::min(minX, graph.xs[u]);
+        maxX = std::max(maxX, graph.xs[u]);
+        minY = std::min(minY, graph.ys[u]);
+        maxY = std::max(maxY, graph.ys[u]);
+    }
+    double side = SPRING_LENGTH * std::sqrt((double)n);
+    double span = std::max(maxX - minX, maxY - minY);
+    double scale = span > 0.0 ? side / span : 0.0;
+    for (int u = 0; u < n; ++u) {
+        m_xs[u] = (graph.xs[u] - minX) * scale + 0.01 * SPRING_LENGTH * jitter(u, 2654435761u);
+        m_ys[u] = (graph.ys[u] - minY) * scale + 0.01 * SPRING_LENGTH * jitter(u, 40503u);
+    }
+    m_stats.step = std::max(SPRING_LENGTH, side / 10.0);
+}
+
+bool ForceLayout::run(int iterations)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations && !isDone(); ++i) iterate();
+    m_stats.ms += timer.nsecsElapsed() / 1e6;
+    return isDone();
+}
+
+void ForceLayout::buildTree()
+{
+    int n = m_xs.size();
+    m_cells.clear();
+    if (n == 0) return;
+
+    double minX = m_xs[0], maxX = m_xs[0];
+    double minY = m_ys[0], maxY = m_ys[0];
+    for (int u = 1; u < n; ++u) {
+        minX = std::min(minX, m_xs[u]);
+        maxX = std::max(maxX, m_xs[u]);
+        minY = std::min(minY, m_ys[u]);
+        maxY = std::max(maxY, m_ys[u]);
+    }
+    double side = std::max(maxX - minX, maxY - minY);
+    if (side <= 0.0) side = SPRING_LENGTH;
+
+    // Quantize to the finest cells; sorting by Morton code groups every cell's
+    // nodes into one contiguous range at every level
+    double cellsPerSide = 1 << MAX_DEPTH;
+    unsigned last = (1u << MAX_DEPTH) - 1;
+    for (int u = 0; u < n; ++u) {
+        unsigned qx = std::min(last, (unsigned)((m_xs[u] - minX) / side * cellsPerSide));
+        unsigned qy = std::min(last, (unsigned)((m_ys[u] - minY) / side * cellsPerSide));
+        m_keys[u] = (spreadBits(qx) | spreadBits(qy) << 1) << 32 | (unsigned)u;
+    }
+    std::sort(m_keys.begin(), m_keys.end());
+    for (int i = 0; i < n; ++i) m_order[i] = (int)(m_keys[i] & 0xffffffffu);
+
+    m_cells.push_back(Cell());
+    m_cells[0].size = side;
+    buildCell(0, 0, n, 0);
+}
+
+void ForceLayout::buildCell(int cell, int begin, int end, int level)
+{
+    m_cells[cell].begin = begin;
+    m_cells[cell].end = end;
+    m_cells[cell].mass = end - begin;
+    m_cells[cell].firstChild = -1;
+    m_cells[cell].childCount = 0;
+
+    double x = 0.0, y = 0.0;
+    if (end - begin <= LEAF_SIZE || level == MAX_DEPTH) {
+        for (int i = begin; i < end; ++i) {
+            x += m_xs[m_order[i]];
+            y += m_ys[m_order[i]];
+        }
+    } else {
+        // Quadrant ranges: the two code bits below this level's prefix
+        int shift = 32 + 2 * (MAX_DEPTH - 1 - level);
+        int bounds[5] = {begin, 0, 0, 0, end};
+        for (int q = 1; q < 4; ++q) {
+            bounds[q] = std::partition_point(m_keys.begin() + bounds[q - 1], m_keys.begin() + end,
+                                             [&](unsigned long long key) { return (int)((key >> shift) & 3) < q; })
+                        - m_keys.begin();
+        }
+        int count = 0;
+        for (int q = 0; q < 4; ++q) count += bounds[q + 1] > bounds[q];
+
+        // Children are appended as one block, so 'm_cells' may move: index only
+        int first = m_cells.size();
+        m_cells.resize(first + count);
+        m_cells[cell].firstChild = first;
+        m_cells[cell].childCount = count;
+        int child = first;
+        for (int q = 0; q < 4; ++q) {
+            if (bounds[q + 1] == bounds[q]) continue;
+            m_cells[child].size = m_cells[cell].size / 2;
+            buildCell(child, bounds[q], bounds[q + 1], level + 1);
+            x += m_cells[child].x * m_cells[child].mass;
+            y += m_cells[child].y * m_cells[child].mass;
+            child++;
+        }
+    }
+    m_cells[cell].x = x / (end - begin);
+    m_cells[cell].y = y / (end - begin);
+}
+
+void ForceLayout::iterate()
+{
+    int n = m_xs.size();
+    buildTree();
+
+    const double strength = REPULSION * SPRING_LENGTH * SPRING_LENGTH;
+    const double theta2 = m_theta * m_theta;
+    const double* xs = m_xs.data();
+    const double* ys = m_ys.data();
+    const int* order = m_order.data();
+    const Cell* cells = m_cells.data();
+    const CsrGraph* sides[2] = {&m_graph, &m_reverse};
+    int sideCount = &m_reverse == &m_graph ? 1 : 2; // An undirected graph has both arcs already
+    std::vector<Partial> partials(m_pool.threadCount());
+
+    m_pool.parallelFor(n, FORCE_GRAIN, [&](int thread, int begin, int end) {
+        long long interactions = 0;
+        int stack[STACK_SIZE];
+        for (int k = begin; k < end; ++k) {
+            int u = order[k];
+            double x = xs[u], y = ys[u];
+            double fx = 0.0, fy = 0.0;
+
+            // Repulsion: open cells until they are small enough to lump together
+            int top = 0;
+            stack[top++] = 0;
+            while (top > 0) {
+                const Cell& c = cells[stack[--top]];
+                if (c.firstChild < 0) {
+                    for (int i = c.begin; i < c.end; ++i) {
+                        int v = order[i];
+                        double dx = x - xs[v], dy = y - ys[v];
+                        double d2 = dx * dx + dy * dy;
+                        if (d2 == 0.0) continue; // Itself, or a node on the same spot: no direction
+                        double f = strength / d2;
+                        fx += dx * f;
+                        fy += dy * f;
+                    }
+                    interactions += c.end - c.begin - (k >= c.begin && k < c.end);
+                    continue;
+                }
+                double dx = x - c.x, dy = y - c.y;
+                double d2 = dx * dx + dy * dy;
+                bool inside = k >= c.begin && k < c.end; // A cell never lumps in the node itself
+                if (!inside && c.size * c.size < theta2 * d2) {
+                    double f = strength * c.mass / d2;
+                    fx += dx * f;
+                    fy += dy * f;
+                    interactions++;
+                } else {
+                    for (int i = 0; i < c.childCount; ++i) stack[top++] = c.firstChild + i;
+                }
+            }
+
+            // Attraction along every edge, whichever way it points
+            for (int s = 0; s < sideCount; ++s) {
+                const CsrGraph& side = *sides[s];
+                for (int arc = side.arcBegin(u); arc < side.arcEnd(u); ++arc) {
+                    int v = side.targets[arc];
+                    double dx = xs[v] - x, dy = ys[v] - y;
+                    double f = std::sqrt(dx * dx + dy * dy) / SPRING_LENGTH;
+                    fx += dx * f;
+                    fy += dy * f;
+                }
+            }
+            m_fx[u] = fx;
+            m_fy[u] = fy;
+        }
+        partials[thread].interactions += interactions;
+    });
+
+    // Move every node one step along its force; serial, so the energy sum and
+    // with it the step schedule do not depend on the thread count
+    double step = m_stats.step;
+    double energy = 0.0;
+    for (int u = 0; u < n; ++u) {
+        double f2 = m_fx[u] * m_fx[u] + m_fy[u] * m_fy[u];
+        energy += f2;
+        if (f2 == 0.0) continue;
+        double f = std::sqrt(f2);
+        m_xs[u] += step * m_fx[u] / f;
+        m_ys[u] += step * m_fy[u] / f;
+    }
+
+    if (energy < m_previousEnergy) {
+        if (++m_progress >= PROGRESS_RUN) {
+            m_progress = 0;
+            step /= COOLING;
+        }
+    } else {
+        m_progress = 0;
+        step *= COOLING;
+    }
+    m_previousEnergy = energy;
+
+    m_stats.iterations++;
+    m_stats.step = step;
+    m_stats.energy = energy;
+    m_stats.cells = m_cells.size();
+    m_stats.interactions = 0;
+    for (const Partial& partial : partials) m_stats.interactions += partial.interactions;
+    m_stats.converged = step < TOLERANCE * SPRING_LENGTH;
+}
+
+void ForceLayout::positions(double width, double height, QVector<double>& xs, QVector<double>& ys) const
+{
+    int n = m_xs.size();
+    xs.resize(n);
+    ys.resize(n);
+    if (n == 0) return;
+
+    double minX = m_xs[0], maxX = m_xs[0];
+    double minY = m_ys[0], maxY = m_ys[0];
+    for (int u = 1; u < n; ++u) {
+        minX = std::min(minX, m_xs[u]);
+        maxX = std::max(maxX, m_xs[u]);
+        minY = std::min(minY, m_ys[u]);
+        maxY = std::max(maxY, m_ys[u]);
+    }
+    double scale = std::numeric_limits<double>::infinity();
+    if (maxX > minX) scale = std::min(scale, MARGIN * width / (maxX - minX));
+    if (maxY > minY) scale = std::min(scale, MARGIN * height / (maxY - minY));
+    if (std::isinf(scale)) scale = 0.0; // Every node on one spot
+    double centerX = (minX + maxX) / 2, centerY = (minY + maxY) / 2;
+    for (int u = 0; u < n; ++u) {
+        xs[u] = width / 2 + (m_xs[u] - centerX) * scale;
+        ys[u] = height / 2 + (m_ys[u] - centerY) * scale;
+    }
+}
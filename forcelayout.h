@@ -0,0 +1,88 @@
+#pragma once
+
+#include "csrgraph.h"
+#include <QVector>
+#include <vector>
+
+class ThreadPool;
+
+// Force-directed layout: every pair of nodes repels with C K^2 / d, every edge
+// pulls its ends together with d^2 / K (Fruchterman-Reingold forces, edge
+// weights ignored), and each iteration moves every node one step along its net
+// force. The step adapts as in Hu's scheme: it grows after a run of iterations
+// that lowered the energy and shrinks after any that did not, and the layout
+// has converged once it is below TOLERANCE spring lengths.
+//
+// Repulsion is the O(V^2) part, so it is approximated Barnes-Hut style: a
+// quadtree over the current positions is rebuilt every iteration, and a cell
+// seen from a node under an angle below theta acts as a single body at its
+// center of mass. An iteration then costs O(V log V + E). Nodes are sorted
+// along a Morton curve to build the tree, and forces are summed in that order
+// in parallel, so neighboring nodes walk the same cells on the same thread
+// and each thread writes only its own nodes.
+class ForceLayout
+{
+public:
+    static constexpr double THETA = 0.8;      // Cell side / distance below which a cell acts as one body
+    static constexpr double TOLERANCE = 0.01; // Step, in spring lengths, at which the layout has converged
+    static constexpr int MAX_ITERATIONS = 2000;
+
+    struct Stats {
+        int iterations = 0;
+        bool converged = false;
+        double step = 0.0;           // Distance each node moves per iteration, in spring lengths
+        double energy = 0.0;         // Sum of squared net forces in the last iteration
+        long long interactions = 0;  // Node-node and node-cell force terms in the last iteration
+        int cells = 0;               // Quadtree cells in the last iteration
+        double ms = 0.0;             // Time spent in run() so far
+    };
+
+    // Starts from the graph's current positions. 'reverse' is graph.reversed(),
+    // or the graph itself if undirected; both must outlive the layout.
+    ForceLayout(const CsrGraph& graph, const CsrGraph& reverse, ThreadPool& pool);
+
+    // Runs up to 'iterations' more iterations, stopping early once done;
+    // returns whether the layout is done
+    bool run(int iterations);
+    bool isDone() const { return m_stats.converged || m_stats.iterations >= MAX_ITERATIONS; }
+
+    // A theta of 0 opens every cell: exact O(V^2) repulsion
+    void setTheta(double theta) { m_theta = theta; }
+
+    // Current positions scaled uniformly and centered in a width x height box,
+    // with a 5% margin
+    void positions(double width, double height, QVector<double>& xs, QVector<double>& ys) const;
+
+    const Stats& stats() const { return m_stats; }
+
+private:
+    struct Cell {
+        double x, y;    // Center of mass
+        double size;    // Side of the square
+        int mass;       // Nodes inside
+        int begin, end; // Range of m_order holding them
+        int firstChild; // Children are contiguous; -1 for a leaf
+        int childCount;
+    };
+
+    const CsrGraph& m_graph;
+    const CsrGraph& m_reverse;
+    ThreadPool& m_pool;
+    double m_theta = THETA;
+
+    std::vector<double> m_xs;
+    std::vector<double> m_ys;
+    std::vector<double> m_fx;
+    std::vector<double> m_fy;
+    std::vector<unsigned long long> m_keys; // Morton code << 32 | node, sorted to build the tree
+    std::vector<int> m_order;               // Nodes in Morton order
+    std::vector<Cell> m_cells;              // Root first
+
+    double m_previousEnergy;
+    int m_progress = 0; // Iterations in a row that lowered the energy
+    Stats m_stats;
+
+    void iterate();
+    void buildTree();
+    void buildCell(int cell, int begin, int end, int level);
+};
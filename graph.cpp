@@ -1,115 +1,182 @@
 #include "graph.h"
+#include "batchqueries.h"
+#include "graphanalytics.h"
+#include "graphgenerators.h"
+#include "graphloader.h"
+#include "graphkernels.h"
+#include "daryheap.h"
+#include "maxflow.h"
+#include "threadpool.h"
+#include "unionfind.h"
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QPair>
 #include <cmath>
 #include <QQueue>
-#include <QSet>
-#include <QRandomGenerator>
-#include <limits>
-#include <queue>
 #include <algorithm>
 
-const int CANVAS_WIDTH = 1200;
-const int CANVAS_HEIGHT = 700;
-
-Graph::Graph() : m_nodeCount(0) {}
-
-QList<QVariant> Graph::generateRandomGraph(int nodeCount)
+const int UNREACHED = -1; // Distance of nodes no search has reached yet
+const int MAX_COMPONENT_STEPS = 100; // Larger partitions show the rest in one step
+const int MAX_MATRIX_NODES = 400;    // Every Floyd-Warshall step holds a V x V snapshot
+const int MATRIX_VIEW_BLOCKS = 8;    // Tiles per matrix side, at most, in the Floyd-Warshall view
+const int MAX_CONTRACTION_STEPS = 100; // Contraction order is shown in at most this many batches
+const int MAX_TABLE_NODES = 64;        // Sources and targets of the distance table view
+const int MAX_FLOW_STEPS = 100;        // Push-relabel pulses are shown in at most this many batches
+const int MAX_PATH_STEPS = 20;         // Augmenting paths shown one by one per Dinic phase
+const int MIN_OVERLAY_ARCS = 1024;     // Updates leave at least this many arcs in the CSR overlay before compacting
+
+const QColor SOURCE_COLOR = QColor(50, 205, 50);
+const QColor SINK_COLOR = QColor(220, 20, 60);
+const QColor LEVEL_EDGE_COLOR = QColor(255, 215, 0);     // Arcs of the current level graph
+const QColor AUGMENT_EDGE_COLOR = QColor(255, 165, 0);   // The augmenting path
+const QColor FLOW_EDGE_COLOR = QColor(135, 206, 250);    // Carries some flow
+const QColor SATURATED_EDGE_COLOR = QColor(65, 105, 225); // Carries its full capacity
+const QColor ACTIVE_NODE_COLOR = QColor(255, 215, 0);
+const QColor DISCHARGED_NODE_COLOR = QColor(255, 140, 0);
+const QColor CUT_SIDE_COLOR = QColor(144, 238, 144);    // Source side of the minimum cut
+
+// Distinct colors for threads or components, reused cyclically
+const QColor GROUP_COLORS[] = {
+    QColor(255, 99, 71), QColor(65, 105, 225), QColor(255, 215, 0), QColor(186, 85, 211),
+    QColor(64, 224, 208), QColor(255, 140, 0), QColor(154, 205, 50), QColor(255, 105, 180)
+};
+const int GROUP_COLOR_COUNT = sizeof(GROUP_COLORS) / sizeof(GROUP_COLORS[0]);
+
+Graph::Graph() {}
+
+void Graph::setCsr(CsrGraph graph)
 {
-    m_adjList.clear();
-    m_nodePositions.clear();
-    m_edgeWeights.clear();
-    m_nodeCount = nodeCount;
-
-    QList<QVariant> history;
+    m_csr = std::move(graph);
+    m_reverse = CsrGraph();
+    m_edges.clear();
+    refreshDerived();
+    m_paths = DynamicShortestPaths();
+    m_pathTarget = -1;
+    m_forest = DynamicSpanningForest();
+    m_pathsView = UpdateView();
+    m_forestView = UpdateView();
+    m_layout.reset();
+}
 
-    // 1. Position Nodes in a Grid
-    double aspectRatio = (double)CANVAS_WIDTH / CANVAS_HEIGHT;
-    int cols = std::ceil(std::sqrt(nodeCount * aspectRatio));
-    int rows = std::ceil((double)nodeCount / cols);
+void Graph::compactCsr()
+{
+    m_csr.compact();
+    m_reverse.compact();
+}
 
-    double hSpacing = CANVAS_WIDTH / (cols + 1);
-    double vSpacing = CANVAS_HEIGHT / (rows + 1);
+void Graph::refreshDerived()
+{
+    m_heuristicScale = -1.0;
+    m_topology = buildTopology(m_csr);
+    m_topologyMoved = false;
+    m_reshapedEdges.clear();
+    m_weightLabels = (long long)m_csr.nodeCount + m_csr.edgeCount <= MAX_LABELED_ELEMENTS;
+    m_hierarchyStale = true;
+}
 
-    for (int i = 0; i < nodeCount; ++i) {
-        int r = i / cols;
-        int c = i % cols;
+const QSharedPointer<const GraphTopology>& Graph::topology()
+{
+    if (!m_topologyMoved && m_reshapedEdges.isEmpty()) return m_topology;
 
-        double x = hSpacing * (c + 1);
-        double y = vSpacing * (r + 1);
-        m_nodePositions[i] = QPointF(x, y);
+    // A copy with the layout's positions and the updates' edges; the labels stay shared
+    GraphTopology* topology = new GraphTopology(*m_topology);
+    if (m_topologyMoved) {
+        for (int u = 0; u < m_csr.nodeCount; ++u) topology->nodes[u].position = m_csr.position(u);
+    }
+    if (!m_reshapedEdges.isEmpty()) {
+        topology->edges.resize(m_edges.size());
+        for (int edge : m_reshapedEdges) {
+            if (edge < m_edges.size()) topology->edges[edge] = edgeState(edge);
+        }
     }
+    m_topology = QSharedPointer<const GraphTopology>(topology);
+    m_topologyMoved = false;
+    m_reshapedEdges.clear();
+    return m_topology;
+}
 
-    // 2. Generate Edges (Locally Only)
-    for (int i = 0; i < nodeCount; ++i) {
-        int r1 = i / cols;
-        int c1 = i % cols;
+EdgeState Graph::edgeState(int edge) const
+{
+    EdgeState es;
+    es.fromId = m_edges[edge].from;
+    es.toId = m_edges[edge].to;
+    if (m_weightLabels) es.weightLabel = QString::number(m_edges[edge].weight);
+    return es;
+}
+
+const CsrGraph& Graph::reverse()
+{
+    if (!m_csr.directed) return m_csr;
+    if (m_reverse.nodeCount != m_csr.nodeCount) m_reverse = m_csr.reversed(); // Cleared with every new m_csr
+    return m_reverse;
+}
 
-        for (int j = i + 1; j < nodeCount; ++j) {
-            int r2 = j / cols;
-            int c2 = j % cols;
+double Graph::heuristicScale()
+{
+    if (m_heuristicScale < 0.0) m_heuristicScale = GraphKernels::heuristicScale(m_csr);
+    return m_heuristicScale;
+}
 
-            int distR = std::abs(r1 - r2);
-            int distC = std::abs(c1 - c2);
+const QVector<GraphEdge>& Graph::edges()
+{
+    if (m_edges.isEmpty() && m_csr.edgeCount > 0) m_edges = m_csr.edgeList();
+    return m_edges;
+}
 
-            bool connected = false;
+QList<QVariant> Graph::generateRandomGraph(int nodeCount, unsigned seed)
+{
+    QList<QVariant> history;
+    setCsr(GraphGenerators::grid(nodeCount, seed));
 
-            if ((distR == 0 && distC == 1) || (distR == 1 && distC == 0)) {
-                if (QRandomGenerator::global()->bounded(100) < 80) connected = true;
-            }
-            else if (distR == 1 && distC == 1) {
-                if (QRandomGenerator::global()->bounded(100) < 30) connected = true;
-            }
+    GraphRecorder recorder(topology());
+    recorder.record(history, "Generated Weighted Grid Graph with " + QString::number(nodeCount) + " nodes.");
+    return history;
+}
 
-            if (connected) {
-                m_adjList[i].append(j);
-                m_adjList[j].append(i);
-                m_edgeWeights[{std::min(i,j), std::max(i,j)}] = QRandomGenerator::global()->bounded(1, 10);
-            }
-        }
-    }
+QList<QVariant> Graph::loadFromFile(const QString& path, QString* error)
+{
+    QList<QVariant> history;
+    CsrGraph loaded;
+    if (!GraphLoader::load(path, loaded, error)) return history;
 
-    // 3. Ensure Connectivity
-    for(int i = 0; i < nodeCount; ++i) {
-        if (!m_adjList.contains(i) || m_adjList[i].isEmpty()) {
-            int neighbor = (i > 0) ? i - 1 : i + 1;
-            if (neighbor < nodeCount) {
-                m_adjList[i].append(neighbor);
-                m_adjList[neighbor].append(i);
-                m_edgeWeights[{std::min(i,neighbor), std::max(i,neighbor)}] = QRandomGenerator::global()->bounded(1, 10);
-            }
-        }
-    }
+    setCsr(std::move(loaded));
 
-    history.append(QVariant::fromValue(createSnapshot("Generated Weighted Grid Graph with " + QString::number(nodeCount) + " nodes.", {}, {})));
+    GraphRecorder recorder(topology());
+    recorder.record(history, "Loaded " + QFileInfo(path).fileName() + ": " + QString::number(m_csr.nodeCount)
+                             + " nodes, " + QString::number(m_csr.edgeCount) + " edges.");
     return history;
 }
 
 QList<QVariant> Graph::bfs(int startNodeId)
 {
+    compactCsr();
     QList<QVariant> history;
-    QSet<int> visited;
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
     QQueue<int> queue;
     QList<int> traversalOrder;
 
-    history.append(QVariant::fromValue(createSnapshot("Starting BFS from Node " + QString::number(startNodeId), visited, {})));
+    recorder.record(history, "Starting BFS from Node " + QString::number(startNodeId));
 
-    visited.insert(startNodeId);
     queue.enqueue(startNodeId);
+    painter.setFrontier(startNodeId, true);
+    painter.visit(startNodeId);
 
     while (!queue.isEmpty()) {
         int u = queue.dequeue();
+        painter.setFrontier(u, false);
+        painter.setCurrent(u);
         traversalOrder.append(u);
 
-        QSet<int> queueSet;
-        for(int x : queue) queueSet.insert(x);
-        history.append(QVariant::fromValue(createSnapshot("Visiting Node " + QString::number(u), visited, queueSet, u)));
+        recorder.record(history, "Visiting Node " + QString::number(u));
 
-        const QList<int>& neighbors = m_adjList[u];
-        for (int v : neighbors) {
-            if (!visited.contains(v)) {
-                visited.insert(v);
+        for (int arc = m_csr.arcBegin(u); arc < m_csr.arcEnd(u); ++arc) {
+            int v = m_csr.targets[arc];
+            if (!painter.isVisited(v)) {
                 queue.enqueue(v);
-                queueSet.insert(v);
-                history.append(QVariant::fromValue(createSnapshot("Found unvisited neighbor " + QString::number(v), visited, queueSet, u)));
+                painter.setFrontier(v, true);
+                painter.visit(v);
+                recorder.record(history, "Found unvisited neighbor " + QString::number(v));
             }
         }
     }
@@ -120,18 +187,103 @@ QList<QVariant> Graph::bfs(int startNodeId)
         if (i < traversalOrder.size() - 1) pathStr += " -> ";
     }
 
-    history.append(QVariant::fromValue(createSnapshot("BFS Complete. Order: " + pathStr, visited, {})));
+    painter.setCurrent(-1);
+    recorder.record(history, "BFS Complete. Order: " + pathStr);
+    return history;
+}
+
+QList<QVariant> Graph::parallelBfs(int startNodeId)
+{
+    compactCsr();
+    QList<QVariant> history;
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
+    ThreadPool& pool = ThreadPool::global();
+
+    GraphKernels::BfsTrace trace;
+    QVector<int> level = GraphKernels::directionOptimizingBfs(m_csr, reverse(), startNodeId, pool, &trace);
+
+    QVector<QVector<int>> levels(trace.bottomUp.size() + 1);
+    for (int node = 0; node < m_csr.nodeCount; ++node) {
+        if (level[node] != GraphKernels::UNREACHABLE) levels[level[node]].append(node);
+    }
+
+    painter.visit(startNodeId);
+    painter.setCurrent(startNodeId);
+    recorder.record(history, "Starting Parallel BFS from Node " + QString::number(startNodeId)
+                             + " on " + QString::number(pool.threadCount()) + " threads");
+    painter.setCurrent(-1);
+
+    int reached = 1;
+    for (int depth = 1; depth < levels.size(); ++depth) {
+        for (int node : levels[depth - 1]) painter.visit(node);
+
+        QVector<int> perThread(pool.threadCount());
+        for (int node : levels[depth]) {
+            int thread = trace.discoveredBy[node];
+            perThread[thread]++;
+            recorder.setNodeColor(node, GROUP_COLORS[thread % GROUP_COLOR_COUNT]); // Tinted by the thread that found it
+        }
+        reached += levels[depth].size();
+
+        QString split;
+        for (int thread = 0; thread < perThread.size(); ++thread) {
+            if (perThread[thread] == 0) continue;
+            if (!split.isEmpty()) split += ", ";
+            split += "T" + QString::number(thread) + ": " + QString::number(perThread[thread]);
+        }
+        recorder.record(history, "Level " + QString::number(depth) + ": " + QString::number(levels[depth].size())
+                                 + " nodes, " + (trace.bottomUp[depth - 1] ? "bottom-up" : "top-down")
+                                 + " (" + split + ")");
+    }
+
+    for (int node : levels.last()) painter.visit(node);
+    recorder.record(history, "Parallel BFS Complete. " + QString::number(reached) + " of "
+                             + QString::number(m_csr.nodeCount) + " nodes in "
+                             + QString::number(levels.size()) + " levels");
     return history;
 }
 
 QList<QVariant> Graph::dfs(int startNodeId)
 {
+    compactCsr();
     QList<QVariant> history;
-    QSet<int> visited;
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
     QList<int> traversalOrder;
 
-    history.append(QVariant::fromValue(createSnapshot("Starting DFS from Node " + QString::number(startNodeId), visited, {})));
-    dfsRecursive(startNodeId, visited, history, traversalOrder);
+    // Explicit stack of (node, next arc to try), one frame per node on the current path
+    QVector<QPair<int, int>> stack;
+    auto enter = [&](int u) {
+        painter.visit(u);
+        painter.setCurrent(u);
+        traversalOrder.append(u);
+        recorder.record(history, "Visiting Node " + QString::number(u));
+        stack.append({u, m_csr.arcBegin(u)});
+    };
+
+    recorder.record(history, "Starting DFS from Node " + QString::number(startNodeId));
+    enter(startNodeId);
+
+    while (!stack.isEmpty()) {
+        int u = stack.last().first;
+        int arc = stack.last().second;
+        if (arc == m_csr.arcEnd(u)) {
+            stack.removeLast();
+            if (!stack.isEmpty()) {
+                painter.setCurrent(stack.last().first);
+                recorder.record(history, "Backtracked to Node " + QString::number(stack.last().first));
+            }
+            continue;
+        }
+
+        stack.last().second++;
+        int v = m_csr.targets[arc];
+        if (!painter.isVisited(v)) {
+            recorder.record(history, "Moving to unvisited neighbor " + QString::number(v));
+            enter(v);
+        }
+    }
 
     QString pathStr;
     for (int i = 0; i < traversalOrder.size(); ++i) {
@@ -139,203 +291,1230 @@ QList<QVariant> Graph::dfs(int startNodeId)
         if (i < traversalOrder.size() - 1) pathStr += " -> ";
     }
 
-    history.append(QVariant::fromValue(createSnapshot("DFS Complete. Order: " + pathStr, visited, {})));
+    painter.setCurrent(-1);
+    recorder.record(history, "DFS Complete. Order: " + pathStr);
     return history;
 }
 
-void Graph::dfsRecursive(int u, QSet<int>& visited, QList<QVariant>& history, QList<int>& traversalOrder)
+QList<QVariant> Graph::stronglyConnectedComponents()
 {
-    visited.insert(u);
-    traversalOrder.append(u);
-    history.append(QVariant::fromValue(createSnapshot("Visiting Node " + QString::number(u), visited, {}, u)));
+    compactCsr();
+    QList<QVariant> history;
+    GraphKernels::Components components = GraphKernels::stronglyConnectedComponents(m_csr);
+    recordComponents(history, components, m_csr.directed ? "Strongly connected component" : "Connected component");
+    return history;
+}
+
+QList<QVariant> Graph::connectedComponents()
+{
+    compactCsr();
+    QList<QVariant> history;
+    GraphKernels::Components components = GraphKernels::connectedComponents(m_csr);
+    recordComponents(history, components, m_csr.directed ? "Weakly connected component" : "Connected component");
+    return history;
+}
 
-    const QList<int>& neighbors = m_adjList[u];
-    for (int v : neighbors) {
-        if (!visited.contains(v)) {
-            history.append(QVariant::fromValue(createSnapshot("Moving to unvisited neighbor " + QString::number(v), visited, {}, u)));
-            dfsRecursive(v, visited, history, traversalOrder);
-            history.append(QVariant::fromValue(createSnapshot("Backtracked to Node " + QString::number(u), visited, {}, u)));
+// One step per component, each in its own color with the arcs inside it, then
+// the condensation (one node per component) on a topology of its own
+void Graph::recordComponents(QList<QVariant>& history, const GraphKernels::Components& components, const QString& kind)
+{
+    GraphRecorder recorder(topology());
+    QVector<QVector<int>> members(components.count);
+    for (int u = 0; u < m_csr.nodeCount; ++u) members[components.component[u]].append(u);
+
+    recorder.record(history, "Finding " + kind.toLower() + "s of " + QString::number(m_csr.nodeCount) + " nodes");
+
+    auto paint = [&](int c) {
+        QColor color = GROUP_COLORS[c % GROUP_COLOR_COUNT];
+        for (int u : members[c]) {
+            recorder.setNodeColor(u, color);
+            for (int arc = m_csr.arcBegin(u); arc < m_csr.arcEnd(u); ++arc) {
+                if (components.component[m_csr.targets[arc]] == c) recorder.setEdgeColor(m_csr.edgeIds[arc], color);
+            }
         }
+    };
+
+    int shown = std::min(components.count, MAX_COMPONENT_STEPS);
+    for (int c = 0; c < shown; ++c) {
+        paint(c);
+        QString list;
+        if (members[c].size() <= 10) {
+            QStringList ids;
+            for (int u : members[c]) ids.append(QString::number(u));
+            list = ": {" + ids.join(", ") + "}";
+        }
+        recorder.record(history, kind + " C" + QString::number(c) + ", " + QString::number(members[c].size()) + " nodes" + list);
     }
+    if (shown < components.count) {
+        int rest = 0;
+        for (int c = shown; c < components.count; ++c) {
+            paint(c);
+            rest += members[c].size();
+        }
+        recorder.record(history, "... and " + QString::number(components.count - shown) + " more components with "
+                                 + QString::number(rest) + " nodes");
+    }
+
+    CsrGraph condensed = GraphKernels::condensation(m_csr, components);
+    QStringList labels;
+    for (int c = 0; c < components.count; ++c) labels.append("C" + QString::number(c));
+    GraphRecorder condensedRecorder(buildTopology(condensed, labels));
+    for (int c = 0; c < components.count; ++c) condensedRecorder.setNodeColor(c, GROUP_COLORS[c % GROUP_COLOR_COUNT]);
+    condensedRecorder.record(history, "Condensation: " + QString::number(components.count) + " components, "
+                                      + QString::number(condensed.edgeCount) + (condensed.directed ? " arcs (a DAG)" : " edges")
+                                      + " between them");
 }
 
 QList<QVariant> Graph::dijkstra(int startNodeId, int endNodeId)
+{
+    compactCsr();
+    // Keep the whole tree, not just the searched part, for later updates to repair
+    m_paths.compute(m_csr, startNodeId);
+    m_pathTarget = endNodeId;
+    m_pathsView = UpdateView();
+    return bestFirstSearch(startNodeId, endNodeId, 0.0, "Dijkstra");
+}
+
+QList<QVariant> Graph::aStar(int startNodeId, int endNodeId)
+{
+    compactCsr();
+    return bestFirstSearch(startNodeId, endNodeId, heuristicScale(), "A*");
+}
+
+// Dijkstra when heuristicScale is 0, A* with a straight-line estimate otherwise.
+// The frontier (yellow) is exactly the heap contents.
+QList<QVariant> Graph::bestFirstSearch(int startNodeId, int endNodeId, double heuristicScale, const QString& name)
 {
     QList<QVariant> history;
-    QSet<int> visited;
-    QMap<int, int> dist;
-    QMap<int, int> parent;
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
+    QVector<int> dist(m_csr.nodeCount, UNREACHED);
+    QVector<int> parent(m_csr.nodeCount, -1);
+    QVector<int> parentEdge(m_csr.nodeCount, -1); // Edge id used to reach each node
+    DaryHeap<double> open(m_csr.nodeCount);
+
+    QPointF goal = m_csr.position(endNodeId);
+    auto estimate = [&](int v) {
+        QPointF delta = m_csr.position(v) - goal;
+        return heuristicScale * std::hypot(delta.x(), delta.y());
+    };
 
-    for(int i=0; i<m_nodeCount; ++i) dist[i] = 9999;
     dist[startNodeId] = 0;
+    open.push(startNodeId, estimate(startNodeId));
+    painter.setFrontier(startNodeId, true);
 
-    std::priority_queue<QPair<int, int>> pq;
-    pq.push({0, startNodeId});
-
-    history.append(QVariant::fromValue(createSnapshot("Finding shortest path from " + QString::number(startNodeId) + " to " + QString::number(endNodeId), visited, {}, startNodeId, dist)));
+    painter.setCurrent(startNodeId);
+    recorder.record(history, name + ": finding shortest path from " + QString::number(startNodeId) + " to " + QString::number(endNodeId));
 
     bool found = false;
+    int settled = 0;
 
-    while (!pq.empty()) {
-        int u = pq.top().second;
-        pq.pop();
-
-        if (visited.contains(u)) continue;
-        visited.insert(u);
+    while (!open.isEmpty()) {
+        int u = open.pop();
+        settled++;
+        painter.setFrontier(u, false);
+        painter.visit(u);
+        painter.setCurrent(u);
 
         if (u == endNodeId) {
             found = true;
-            history.append(QVariant::fromValue(createSnapshot("Target Node " + QString::number(u) + " Reached!", visited, {}, u, dist)));
+            recorder.record(history, "Target Node " + QString::number(u) + " Reached!");
             break;
         }
 
-        history.append(QVariant::fromValue(createSnapshot("Processing Node " + QString::number(u), visited, {}, u, dist)));
+        recorder.record(history, "Processing Node " + QString::number(u) + " (distance " + QString::number(dist[u]) + ")");
 
-        const QList<int>& neighbors = m_adjList[u];
-        for (int v : neighbors) {
-            if (visited.contains(v)) continue;
+        for (int arc = m_csr.arcBegin(u); arc < m_csr.arcEnd(u); ++arc) {
+            int v = m_csr.targets[arc];
+            if (painter.isVisited(v)) continue;
 
-            int weight = m_edgeWeights[{std::min(u,v), std::max(u,v)}];
-            int newDist = dist[u] + weight;
+            int newDist = dist[u] + m_csr.weights[arc];
 
-            if (newDist < dist[v]) {
+            if (dist[v] == UNREACHED || newDist < dist[v]) {
                 dist[v] = newDist;
                 parent[v] = u;
-                pq.push({-newDist, v});
+                parentEdge[v] = m_csr.edgeIds[arc];
+                open.pushOrDecrease(v, newDist + estimate(v));
+                painter.setFrontier(v, true);
 
-                history.append(QVariant::fromValue(createSnapshot("Relaxing Edge " + QString::number(u) + "->" + QString::number(v), visited, {}, u, dist)));
+                recorder.record(history, "Relaxing Edge " + QString::number(u) + "->" + QString::number(v));
             }
         }
     }
 
+    painter.setCurrent(-1);
+    QString summary = " | " + QString::number(settled) + " of " + QString::number(m_csr.nodeCount) + " nodes settled";
     if (found) {
-        QSet<QPair<int, int>> pathEdges;
-        int curr = endNodeId;
-        QString pathStr = QString::number(curr);
+        QString pathStr = tracePath(painter, parent, parentEdge, startNodeId, endNodeId);
+        recorder.record(history, "Shortest Path Found: " + pathStr + " (cost " + QString::number(dist[endNodeId]) + ")" + summary);
+    } else {
+        recorder.record(history, "Target Node " + QString::number(endNodeId) + " is unreachable!" + summary);
+    }
+
+    return history;
+}
+
+QList<QVariant> Graph::bidirectionalDijkstra(int startNodeId, int endNodeId)
+{
+    compactCsr();
+    QList<QVariant> history;
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
+
+    // Side 0 searches forward from the start, side 1 backward from the end
+    const CsrGraph* sides[2] = {&m_csr, &reverse()};
+    QVector<int> dist[2] = {QVector<int>(m_csr.nodeCount, UNREACHED), QVector<int>(m_csr.nodeCount, UNREACHED)};
+    QVector<int> parent[2] = {QVector<int>(m_csr.nodeCount, -1), QVector<int>(m_csr.nodeCount, -1)};
+    QVector<int> parentEdge[2] = {QVector<int>(m_csr.nodeCount, -1), QVector<int>(m_csr.nodeCount, -1)};
+    DaryHeap<int> open[2] = {DaryHeap<int>(m_csr.nodeCount), DaryHeap<int>(m_csr.nodeCount)};
+    const QString sideName[2] = {"forward", "backward"};
+
+    dist[0][startNodeId] = 0;
+    dist[1][endNodeId] = 0;
+    open[0].push(startNodeId, 0);
+    open[1].push(endNodeId, 0);
+    painter.setFrontier(startNodeId, true);
+    painter.setFrontier(endNodeId, true);
+    recorder.record(history, "Bidirectional Dijkstra from " + QString::number(startNodeId) + " and " + QString::number(endNodeId));
+
+    int best = (startNodeId == endNodeId) ? 0 : UNREACHED; // Shortest path through a meeting node so far
+    int meeting = startNodeId;
+    int settled = 0;
+
+    while (!open[0].isEmpty() && !open[1].isEmpty()) {
+        if (best != UNREACHED && open[0].topKey() + open[1].topKey() >= best) {
+            recorder.record(history, "Frontiers " + QString::number(open[0].topKey()) + " + " + QString::number(open[1].topKey())
+                                     + " >= best path " + QString::number(best) + ": stopping");
+            break;
+        }
+
+        int side = open[0].topKey() <= open[1].topKey() ? 0 : 1;
+        const CsrGraph& graph = *sides[side];
+        int u = open[side].pop();
+        settled++;
+        if (!open[0].contains(u) && !open[1].contains(u)) painter.setFrontier(u, false);
+        painter.visit(u, side == 1);
+        painter.setCurrent(u);
+        recorder.record(history, "Settling Node " + QString::number(u) + " " + sideName[side]
+                                 + " (distance " + QString::number(dist[side][u]) + ")");
+
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = graph.targets[arc];
+            int newDist = dist[side][u] + graph.weights[arc];
+            if (dist[side][v] == UNREACHED || newDist < dist[side][v]) {
+                dist[side][v] = newDist;
+                parent[side][v] = u;
+                parentEdge[side][v] = graph.edgeIds[arc];
+                open[side].pushOrDecrease(v, newDist);
+                if (!painter.isVisited(v)) painter.setFrontier(v, true);
+            }
+            int other = dist[1 - side][v];
+            if (other != UNREACHED && (best == UNREACHED || dist[side][v] + other < best)) {
+                best = dist[side][v] + other;
+                meeting = v;
+                recorder.record(history, "Searches meet at Node " + QString::number(v) + ": path cost " + QString::number(best));
+            }
+        }
+    }
+
+    painter.setCurrent(-1);
+    QString summary = " | " + QString::number(settled) + " of " + QString::number(m_csr.nodeCount) + " nodes settled";
+    if (best == UNREACHED) {
+        recorder.record(history, "Target Node " + QString::number(endNodeId) + " is unreachable!" + summary);
+        return history;
+    }
+
+    // Forward half: start -> meeting, then the backward parents lead on to the end
+    QString pathStr = tracePath(painter, parent[0], parentEdge[0], startNodeId, meeting);
+    for (int curr = meeting; curr != endNodeId; curr = parent[1][curr]) {
+        painter.markPathEdge(parentEdge[1][curr]);
+        pathStr += " -> " + QString::number(parent[1][curr]);
+    }
+
+    recorder.record(history, "Shortest Path Found: " + pathStr + " (cost " + QString::number(best) + ")" + summary);
+    return history;
+}
 
-        while (curr != startNodeId) {
-            int prev = parent[curr];
-            pathEdges.insert({std::min(prev, curr), std::max(prev, curr)});
-            pathStr.prepend(QString::number(prev) + " -> ");
-            curr = prev;
+QList<QVariant> Graph::deltaStepping(int startNodeId)
+{
+    compactCsr();
+    QList<QVariant> history;
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
+    long long delta = GraphKernels::suggestedDelta(m_csr);
+
+    GraphKernels::DeltaSteppingTrace trace;
+    QVector<long long> dist = GraphKernels::deltaStepping(m_csr, startNodeId, delta, ThreadPool::global(), &trace);
+
+    painter.setCurrent(startNodeId);
+    recorder.record(history, "Delta-Stepping from Node " + QString::number(startNodeId) + " with delta "
+                             + QString::number(delta) + " (light arcs weigh at most " + QString::number(delta) + ")");
+    painter.setCurrent(-1);
+
+    // The frontier is the bucket being emptied; a node settles in the bucket of its final distance
+    int buckets = 0;
+    for (int i = 0; i < trace.phases.size(); ++i) {
+        const GraphKernels::DeltaSteppingTrace::Phase& phase = trace.phases[i];
+        for (int node : phase.nodes) painter.setFrontier(node, true);
+        recorder.record(history, "Bucket " + QString::number(phase.bucket) + " [" + QString::number(phase.bucket * delta) + ", "
+                                 + QString::number((phase.bucket + 1) * delta) + "): relaxing light arcs of "
+                                 + QString::number(phase.nodes.size()) + " nodes in parallel");
+        for (int node : phase.nodes) painter.setFrontier(node, false);
+
+        bool bucketDone = i + 1 == trace.phases.size() || trace.phases[i + 1].bucket != phase.bucket;
+        if (!bucketDone) continue;
+
+        int settledHere = 0;
+        for (int node = 0; node < m_csr.nodeCount; ++node) {
+            if (dist[node] != GraphKernels::UNREACHABLE && dist[node] / delta == phase.bucket) {
+                painter.visit(node);
+                settledHere++;
+            }
         }
+        buckets++;
+        recorder.record(history, "Bucket " + QString::number(phase.bucket) + " settled " + QString::number(settledHere)
+                                 + " nodes; relaxing their heavy arcs");
+    }
+
+    // Shortest-path tree: each node keeps one arc that is tight under the final distances
+    const CsrGraph& backward = reverse();
+    int reached = 0;
+    int farthest = startNodeId;
+    for (int v = 0; v < m_csr.nodeCount; ++v) {
+        if (dist[v] == GraphKernels::UNREACHABLE) continue;
+        reached++;
+        if (dist[v] > dist[farthest]) farthest = v;
+        if (v == startNodeId) continue;
+        for (int arc = backward.arcBegin(v); arc < backward.arcEnd(v); ++arc) {
+            int u = backward.targets[arc];
+            if (dist[u] != GraphKernels::UNREACHABLE && dist[u] + backward.weights[arc] == dist[v]) {
+                painter.markPathEdge(backward.edgeIds[arc]);
+                break;
+            }
+        }
+    }
 
-        history.append(QVariant::fromValue(createSnapshot("Shortest Path Found: " + pathStr, visited, {}, -1, dist, pathEdges)));
+    recorder.record(history, "Delta-Stepping Complete: " + QString::number(reached) + " of " + QString::number(m_csr.nodeCount)
+                             + " nodes reached in " + QString::number(buckets) + " buckets, "
+                             + QString::number(trace.phases.size()) + " phases | farthest Node "
+                             + QString::number(farthest) + " (cost " + QString::number(dist[farthest]) + ")");
+    return history;
+}
+
+// Nodes are shaded by rank, pale (contracted first) to dark (contracted last),
+// then the query shows both upward searches: forward green, backward cyan.
+QList<QVariant> Graph::contractionHierarchy(int startNodeId, int endNodeId)
+{
+    compactCsr();
+    QList<QVariant> history;
+
+    if (m_hierarchyStale) {
+        QElapsedTimer timer;
+        timer.start();
+        m_hierarchy = ContractionHierarchy();
+        m_hierarchy.build(m_csr);
+        m_hierarchyStale = false;
+        qint64 buildMs = timer.elapsed();
+
+        GraphRecorder recorder(topology());
+        const QVector<int>& order = m_hierarchy.order();
+        const QVector<int>& added = m_hierarchy.shortcutsAdded();
+        int total = order.size();
+        int batch = std::max(1, (total + MAX_CONTRACTION_STEPS - 1) / MAX_CONTRACTION_STEPS);
+        int shortcuts = 0;
+        for (int begin = 0; begin < total; begin += batch) {
+            int end = std::min(begin + batch, total);
+            int batchShortcuts = 0;
+            for (int rank = begin; rank < end; ++rank) {
+                double depth = total > 1 ? double(rank) / (total - 1) : 0.0;
+                recorder.setNodeColor(order[rank], QColor::fromHsv(220, 40 + int(215 * depth), 255 - int(135 * depth)));
+                batchShortcuts += added[rank];
+            }
+            shortcuts += batchShortcuts;
+            recorder.record(history, "Contracting nodes " + QString::number(begin + 1) + "-" + QString::number(end) + " of "
+                                     + QString::number(total) + ": +" + QString::number(batchShortcuts)
+                                     + " shortcuts (" + QString::number(shortcuts) + " total)");
+        }
+        recorder.record(history, "Contraction hierarchy built in " + QString::number(buildMs) + " ms: "
+                                 + QString::number(m_hierarchy.shortcutCount()) + " shortcuts over "
+                                 + QString::number(m_csr.edgeCount) + " edges");
     } else {
-        history.append(QVariant::fromValue(createSnapshot("Target Node " + QString::number(endNodeId) + " is unreachable!", visited, {}, -1, dist)));
+        GraphRecorder recorder(topology());
+        recorder.record(history, "Reusing contraction hierarchy: " + QString::number(m_hierarchy.shortcutCount()) + " shortcuts");
+    }
+
+    // A fresh recorder starts the query from the plain graph colors
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
+    const QString sideName[2] = {"forward", "backward"};
+
+    ContractionHierarchy::QueryTrace trace;
+    GraphKernels::PathSearch search = m_hierarchy.query(startNodeId, endNodeId, &trace);
+
+    painter.setFrontier(startNodeId, true);
+    painter.setFrontier(endNodeId, true);
+    recorder.record(history, "Contraction Hierarchy: upward searches from " + QString::number(startNodeId) + " and " + QString::number(endNodeId));
+    painter.setFrontier(startNodeId, false);
+    painter.setFrontier(endNodeId, false);
+
+    for (int i = 0; i < trace.settled.size(); ++i) {
+        int u = trace.settled[i];
+        bool backward = trace.backward[i];
+        painter.visit(u, backward);
+        painter.setCurrent(u);
+        recorder.record(history, "Settling Node " + QString::number(u) + " " + sideName[backward ? 1 : 0]
+                                 + " (rank " + QString::number(m_hierarchy.rank(u)) + ")");
+    }
+
+    painter.setCurrent(-1);
+    QString summary = " | " + QString::number(search.settled) + " of " + QString::number(m_csr.nodeCount) + " nodes settled";
+    if (search.distance == GraphKernels::UNREACHABLE) {
+        recorder.record(history, "Target Node " + QString::number(endNodeId) + " is unreachable!" + summary);
+        return history;
+    }
+
+    // Unpacked shortcuts give input edges in path order; follow them from the start
+    QString pathStr = QString::number(startNodeId);
+    int curr = startNodeId;
+    for (int edge : trace.pathEdges) {
+        painter.markPathEdge(edge);
+        const EdgeState& es = m_topology->edges[edge];
+        curr = es.fromId == curr ? es.toId : es.fromId;
+        pathStr += " -> " + QString::number(curr);
     }
 
+    painter.setCurrent(trace.meeting);
+    recorder.record(history, "Shortest Path Found: " + pathStr + " (cost " + QString::number(search.distance) + ", meeting at Node "
+                             + QString::number(trace.meeting) + ")" + summary);
     return history;
 }
 
+// Marks the parent-edge chain from 'to' back to 'from' and returns it as "from -> ... -> to"
+QString Graph::tracePath(TraversalPainter& painter, const QVector<int>& parent, const QVector<int>& parentEdge, int from, int to)
+{
+    QString pathStr = QString::number(to);
+    for (int curr = to; curr != from; curr = parent[curr]) {
+        painter.markPathEdge(parentEdge[curr]);
+        pathStr.prepend(QString::number(parent[curr]) + " -> ");
+    }
+    return pathStr;
+}
+
 QList<QVariant> Graph::primMST(int startNodeId)
 {
+    compactCsr();
     QList<QVariant> history;
-    QSet<int> visited;
-    QMap<int, int> minEdgeWeight;
-    QMap<int, int> parent;
-    QSet<QPair<int, int>> mstEdges;
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
+    QVector<int> parent(m_csr.nodeCount, -1);
+    QVector<int> parentEdge(m_csr.nodeCount, -1);
+    DaryHeap<int> open(m_csr.nodeCount); // Key: lightest known edge into the tree
 
-    for(int i=0; i<m_nodeCount; ++i) minEdgeWeight[i] = 9999;
-    minEdgeWeight[startNodeId] = 0;
+    open.push(startNodeId, 0);
 
-    std::priority_queue<QPair<int, int>> pq;
-    pq.push({0, startNodeId});
+    painter.setCurrent(startNodeId);
+    recorder.record(history, "Starting Prim's MST from Node " + QString::number(startNodeId));
 
-    history.append(QVariant::fromValue(createSnapshot("Starting Prim's MST from Node " + QString::number(startNodeId), visited, {}, startNodeId)));
+    int totalWeight = 0;
+    while (!open.isEmpty()) {
+        int weightIn = open.topKey();
+        int u = open.pop();
+        totalWeight += weightIn;
+        painter.visit(u);
+        painter.setCurrent(u);
+
+        if (parent[u] != -1) {
+            int p = parent[u];
+            painter.markPathEdge(parentEdge[u]);
+            recorder.record(history, "Added Edge " + QString::number(p) + "-" + QString::number(u) + " to MST.");
+        } else {
+            recorder.record(history, "Processing Node " + QString::number(u));
+        }
 
-    while (!pq.empty()) {
-        int u = pq.top().second;
-        pq.pop();
+        for (int arc = m_csr.arcBegin(u); arc < m_csr.arcEnd(u); ++arc) {
+            int v = m_csr.targets[arc];
+            if (painter.isVisited(v)) continue;
 
-        if (visited.contains(u)) continue;
-        visited.insert(u);
+            if (open.pushOrDecrease(v, m_csr.weights[arc])) {
+                parent[v] = u;
+                parentEdge[v] = m_csr.edgeIds[arc];
+            }
+        }
+    }
 
-        if (parent.contains(u)) {
-            int p = parent[u];
-            mstEdges.insert({std::min(p, u), std::max(p, u)});
-            history.append(QVariant::fromValue(createSnapshot("Added Edge " + QString::number(p) + "-" + QString::number(u) + " to MST.", visited, {}, u, {}, mstEdges)));
+    painter.setCurrent(-1);
+    recorder.record(history, "MST Complete. Total Weight: " + QString::number(totalWeight));
+    if (!m_csr.directed) m_forest.compute(m_csr);
+    m_forestView = UpdateView();
+    return history;
+}
+
+QList<QVariant> Graph::kruskalMST()
+{
+    compactCsr();
+    QList<QVariant> history;
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
+    const QList<EdgeState>& edges = m_topology->edges;
+
+    // Edge ids, lightest first; equal weights keep id order like GraphKernels::kruskal
+    QVector<int> order;
+    QVector<int> weightOf(edges.size());
+    for (int u = 0; u < m_csr.nodeCount; ++u) {
+        for (int arc = m_csr.arcBegin(u); arc < m_csr.arcEnd(u); ++arc) {
+            int v = m_csr.targets[arc];
+            if (v == u || (!m_csr.directed && v < u)) continue;
+            order.append(m_csr.edgeIds[arc]);
+            weightOf[m_csr.edgeIds[arc]] = m_csr.weights[arc];
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return weightOf[a] != weightOf[b] ? weightOf[a] < weightOf[b] : a < b;
+    });
+
+    recorder.record(history, "Starting Kruskal's MST: " + QString::number(order.size()) + " edges sorted by weight");
+
+    UnionFind sets(m_csr.nodeCount);
+    long long totalWeight = 0;
+    for (int edge : order) {
+        if (sets.setCount() == 1) break;
+        int u = edges[edge].fromId;
+        int v = edges[edge].toId;
+        QString name = QString::number(u) + "-" + QString::number(v) + " (weight " + QString::number(weightOf[edge]) + ")";
+
+        painter.setCurrent(u);
+        if (sets.unite(u, v)) {
+            totalWeight += weightOf[edge];
+            painter.visit(u);
+            painter.visit(v);
+            painter.markPathEdge(edge);
+            recorder.record(history, "Added Edge " + name + " to MST.");
+        } else {
+            recorder.record(history, "Skipped Edge " + name + ": both ends are already connected");
+        }
+    }
+
+    painter.setCurrent(-1);
+    QString trees = sets.setCount() > 1 ? " | " + QString::number(sets.setCount()) + " trees" : "";
+    recorder.record(history, "MST Complete. Total Weight: " + QString::number(totalWeight) + trees);
+    return history;
+}
+
+QList<QVariant> Graph::boruvkaMST()
+{
+    compactCsr();
+    QList<QVariant> history;
+    GraphRecorder recorder(topology());
+    TraversalPainter painter(m_csr, recorder);
+    ThreadPool& pool = ThreadPool::global();
+
+    QVector<int> roundEnds;
+    GraphKernels::SpanningForest forest = GraphKernels::boruvka(m_csr, pool, &roundEnds);
+
+    recorder.record(history, "Starting Boruvka's MST on " + QString::number(pool.threadCount()) + " threads: "
+                             + QString::number(m_csr.nodeCount) + " single-node components");
+
+    int components = m_csr.nodeCount;
+    int first = 0;
+    for (int round = 0; round < roundEnds.size(); ++round) {
+        for (int i = first; i < roundEnds[round]; ++i) {
+            const EdgeState& edge = m_topology->edges[forest.edges[i]];
+            painter.visit(edge.fromId);
+            painter.visit(edge.toId);
+            painter.markPathEdge(forest.edges[i]);
+        }
+        int joined = roundEnds[round] - first;
+        components -= joined;
+        recorder.record(history, "Round " + QString::number(round + 1) + ": each component took its lightest outgoing edge; "
+                                 + QString::number(joined) + " edges added, " + QString::number(components) + " components left");
+        first = roundEnds[round];
+    }
+
+    QString trees = forest.components > 1 ? " | " + QString::number(forest.components) + " trees" : "";
+    recorder.record(history, "MST Complete. Total Weight: " + QString::number(forest.weight) + trees);
+    return history;
+}
+
+QList<QVariant> Graph::floydWarshall()
+{
+    compactCsr();
+    QList<QVariant> history;
+    int n = m_csr.nodeCount;
+
+    MatrixStep step;
+    if (n > MAX_MATRIX_NODES) {
+        step.statusMessage = "Floyd-Warshall shows at most " + QString::number(MAX_MATRIX_NODES) + " nodes; this graph has "
+                             + QString::number(n);
+        history.append(QVariant::fromValue(step));
+        return history;
+    }
+
+    // Smallest kernel tile that keeps the schedule to a few blocks per side
+    int tileSize = 8;
+    while (tileSize < GraphKernels::FLOYD_TILE && (n + tileSize - 1) / tileSize > MATRIX_VIEW_BLOCKS) tileSize *= 2;
+
+    // NO_PATH is drawn as "no value"
+    auto showValues = [&](const QVector<int>& dist) {
+        step.values = dist;
+        for (int& value : step.values) {
+            if (value >= GraphKernels::NO_PATH) value = -1;
+        }
+    };
+
+    QVector<int> dist = GraphKernels::weightMatrix(m_csr);
+    step.size = n;
+    step.tileSize = tileSize;
+    showValues(dist);
+    step.statusMessage = "Floyd-Warshall on " + QString::number(n) + " nodes: direct arc weights, "
+                         + QString::number(tileSize) + "x" + QString::number(tileSize) + " tiles";
+    history.append(QVariant::fromValue(step));
+
+    QVector<GraphKernels::FloydPhase> phases;
+    ThreadPool& pool = ThreadPool::global();
+    GraphKernels::floydWarshallBlocked(dist, n, pool, tileSize, &phases);
+
+    for (const GraphKernels::FloydPhase& phase : phases) {
+        int first = phase.pivotBlock * tileSize;
+        int last = std::min(first + tileSize, n) - 1;
+        step.highlightBegin = first;
+        step.highlightEnd = last + 1;
+        step.activeTiles.clear();
+        for (const QPair<int, int>& tile : phase.tiles) step.activeTiles.append(QPoint(tile.second, tile.first));
+        showValues(phase.dist);
+
+        QString pivots = "Pivots " + QString::number(first) + "-" + QString::number(last) + ": ";
+        if (phase.kind == GraphKernels::FloydPhase::DIAGONAL) {
+            step.statusMessage = pivots + "diagonal tile relaxes through itself";
+        } else if (phase.kind == GraphKernels::FloydPhase::CROSS) {
+            step.statusMessage = pivots + QString::number(phase.tiles.size()) + " row and column tiles in parallel";
         } else {
-            history.append(QVariant::fromValue(createSnapshot("Processing Node " + QString::number(u), visited, {}, u, {}, mstEdges)));
+            step.statusMessage = pivots + "remaining " + QString::number(phase.tiles.size()) + " tiles in parallel on "
+                                 + QString::number(pool.threadCount()) + " threads";
+        }
+        history.append(QVariant::fromValue(step));
+    }
+
+    long long reachable = 0;
+    int diameter = 0;
+    for (int value : dist) {
+        if (value >= GraphKernels::NO_PATH) continue;
+        reachable++;
+        diameter = std::max(diameter, value);
+    }
+    step.highlightBegin = step.highlightEnd = 0;
+    step.activeTiles.clear();
+    step.statusMessage = "All-Pairs Complete: " + QString::number(reachable) + " of " + QString::number((long long)n * n)
+                         + " pairs connected | longest shortest path " + QString::number(diameter);
+    history.append(QVariant::fromValue(step));
+    return history;
+}
+
+QList<QVariant> Graph::distanceTable()
+{
+    compactCsr();
+    QList<QVariant> history;
+    int n = m_csr.nodeCount;
+    ThreadPool& pool = ThreadPool::global();
+    BatchQueryEngine engine(m_csr, pool);
+
+    // Evenly spaced nodes, ordered left to right so neighboring rows are nearby nodes
+    int k = std::min(n, MAX_TABLE_NODES);
+    QVector<int> sample(k);
+    for (int i = 0; i < k; ++i) sample[i] = (int)((long long)i * n / k);
+    std::sort(sample.begin(), sample.end(), [this](int a, int b) { return m_csr.xs[a] < m_csr.xs[b]; });
+
+    BatchQueryEngine::Stats weighted;
+    QVector<int> rowThreads;
+    QVector<long long> distances = engine.distanceTable(sample, sample, BatchQueryEngine::WEIGHTED, &weighted, &rowThreads);
+    BatchQueryEngine::Stats hops;
+    QVector<long long> hopCounts = engine.distanceTable(sample, sample, BatchQueryEngine::HOPS, &hops);
+
+    // Which thread answered each row
+    GraphRecorder recorder(topology());
+    for (int row = 0; row < k; ++row) recorder.setNodeColor(sample[row], GROUP_COLORS[rowThreads[row] % GROUP_COLOR_COUNT]);
+    QString split;
+    for (int thread = 0; thread < weighted.searchesPerThread.size(); ++thread) {
+        if (weighted.searchesPerThread[thread] == 0) continue;
+        if (!split.isEmpty()) split += ", ";
+        split += "T" + QString::number(thread) + ": " + QString::number(weighted.searchesPerThread[thread]);
+    }
+    recorder.record(history, "Distance table of " + QString::number(k) + " nodes: one search per row on "
+                             + QString::number(pool.threadCount()) + " threads (" + split + "), "
+                             + QString::number(weighted.steals) + " steals");
+
+    auto recordTable = [&](const QVector<long long>& table, const BatchQueryEngine::Stats& stats, const QString& name) {
+        MatrixStep step;
+        step.size = k;
+        step.values.resize(table.size());
+        long long connected = 0;
+        long long longest = 0;
+        for (int i = 0; i < table.size(); ++i) {
+            step.values[i] = (int)table[i]; // UNREACHABLE (-1) is drawn as "no value"
+            if (table[i] == GraphKernels::UNREACHABLE) continue;
+            connected++;
+            longest = std::max(longest, table[i]);
         }
+        step.statusMessage = name + ": " + QString::number(connected) + " of " + QString::number((long long)k * k)
+                             + " pairs connected, longest " + QString::number(longest) + " | "
+                             + QString::number(stats.settled) + " nodes settled in " + QString::number(stats.ms, 'f', 2) + " ms";
+        history.append(QVariant::fromValue(step));
+    };
+    recordTable(distances, weighted, "Weighted distances");
+    recordTable(hopCounts, hops, "Hop counts");
+    return history;
+}
 
-        const QList<int>& neighbors = m_adjList[u];
-        for (int v : neighbors) {
-            if (visited.contains(v)) continue;
+// --- Max flow ---
 
-            int weight = m_edgeWeights[{std::min(u,v), std::max(u,v)}];
+namespace
+{
+QColor flowColor(int flow, int capacity)
+{
+    if (flow == 0) return Qt::white;
+    return std::abs(flow) >= capacity ? SATURATED_EDGE_COLOR : FLOW_EDGE_COLOR;
+}
+} // namespace
 
-            if (weight < minEdgeWeight[v]) {
-                minEdgeWeight[v] = weight;
-                parent[v] = u;
-                pq.push({-weight, v});
+QList<QVariant> Graph::dinicMaxFlow(int source, int sink)
+{
+    compactCsr();
+    QList<QVariant> history;
+    FlowNetwork network = FlowNetwork::build(m_csr);
+    MaxFlow::DinicTrace trace;
+    MaxFlow::Result result = MaxFlow::dinic(network, source, sink, &trace);
+
+    GraphRecorder recorder(topology());
+    QVector<GraphEdge> edges = m_csr.edgeList();
+    QVector<int> flow(m_csr.edgeCount, 0);
+    auto residual = [&](int edge, int from) { // Capacity left from 'from' to the other end
+        const GraphEdge& e = edges[edge];
+        return from == e.from ? e.weight - flow[edge] : (m_csr.directed ? 0 : e.weight) + flow[edge];
+    };
+
+    recorder.setNodeColor(source, SOURCE_COLOR);
+    recorder.setNodeColor(sink, SINK_COLOR);
+    recorder.record(history, "Dinic: max flow from Node " + QString::number(source) + " to Node " + QString::number(sink)
+                             + ", edge weights as capacities");
+
+    long long total = 0;
+    for (int phase = 0; phase < trace.phases.size(); ++phase) {
+        const MaxFlow::DinicTrace::Phase& traced = trace.phases[phase];
+        const QVector<int>& level = traced.level;
+        int depth = level[sink];
+
+        // Nodes shaded by level, the arcs one level deeper with capacity left highlighted
+        for (int u = 0; u < m_csr.nodeCount; ++u) {
+            if (u == source || u == sink) continue;
+            double shade = level[u] >= 0 && level[u] <= depth ? double(level[u]) / depth : -1.0;
+            recorder.setNodeColor(u, shade < 0 ? QColor(Qt::white) : QColor::fromHsv(220, 40 + int(215 * shade), 255 - int(135 * shade)));
+        }
+        int levelEdges = 0;
+        for (int edge = 0; edge < edges.size(); ++edge) {
+            int a = edges[edge].from;
+            int b = edges[edge].to;
+            bool forward = level[a] >= 0 && level[b] == level[a] + 1 && level[b] <= depth && residual(edge, a) > 0;
+            bool backward = level[b] >= 0 && level[a] == level[b] + 1 && level[a] <= depth && residual(edge, b) > 0;
+            if (forward || backward) levelEdges++;
+            recorder.setEdgeColor(edge, forward || backward ? LEVEL_EDGE_COLOR : flowColor(flow[edge], edges[edge].weight));
+        }
+        recorder.record(history, "Phase " + QString::number(phase + 1) + ": level graph of " + QString::number(levelEdges)
+                                 + " edges, sink at depth " + QString::number(depth));
+
+        long long phaseFlow = 0;
+        for (int i = 0; i < traced.paths.size(); ++i) {
+            const MaxFlow::DinicTrace::Path& path = traced.paths[i];
+            QString pathStr = QString::number(source);
+            int curr = source;
+            for (int edge : path.edges) {
+                bool forward = edges[edge].from == curr;
+                flow[edge] += forward ? path.amount : -path.amount;
+                curr = forward ? edges[edge].to : edges[edge].from;
+                pathStr += " -> " + QString::number(curr);
+            }
+            phaseFlow += path.amount;
+            if (i >= MAX_PATH_STEPS) continue;
+
+            for (int edge : path.edges) recorder.setEdgeColor(edge, AUGMENT_EDGE_COLOR);
+            recorder.record(history, "Augmenting path +" + QString::number(path.amount) + ": " + pathStr);
+            for (int edge : path.edges) {
+                bool saturated = residual(edge, edges[edge].from) == 0 || residual(edge, edges[edge].to) == 0;
+                recorder.setEdgeColor(edge, saturated ? flowColor(flow[edge], edges[edge].weight) : LEVEL_EDGE_COLOR);
             }
         }
+        total += phaseFlow;
+
+        for (int edge = 0; edge < edges.size(); ++edge) recorder.setEdgeColor(edge, flowColor(flow[edge], edges[edge].weight));
+        recorder.record(history, "Phase " + QString::number(phase + 1) + " blocking flow: " + QString::number(traced.paths.size())
+                                 + " augmenting paths, +" + QString::number(phaseFlow) + " (flow " + QString::number(total) + ")");
     }
 
-    int totalWeight = 0;
-    for(int i=0; i<m_nodeCount; ++i) if(minEdgeWeight[i] != 9999) totalWeight += minEdgeWeight[i];
+    recordMinCut(history, recorder, result, " | " + QString::number(result.phases) + " phases, "
+                                               + QString::number(result.augmentations) + " augmenting paths");
+    return history;
+}
+
+QList<QVariant> Graph::pushRelabelMaxFlow(int source, int sink)
+{
+    compactCsr();
+    QList<QVariant> history;
+    FlowNetwork network = FlowNetwork::build(m_csr);
+    MaxFlow::PushRelabelTrace trace;
+    MaxFlow::Result result = MaxFlow::pushRelabel(network, source, sink, MaxFlow::HIGHEST_LABEL, &trace);
+
+    GraphRecorder recorder(topology());
+    QVector<GraphEdge> edges = m_csr.edgeList();
+    recorder.setNodeColor(source, SOURCE_COLOR);
+    recorder.setNodeColor(sink, SINK_COLOR);
+    recorder.record(history, "Push-relabel (highest label): max flow from Node " + QString::number(source) + " to Node "
+                             + QString::number(sink) + ", edge weights as capacities");
+
+    int total = trace.pulses.size();
+    int batch = std::max(1, (total + MAX_FLOW_STEPS - 1) / MAX_FLOW_STEPS);
+    QVector<bool> shown(m_csr.nodeCount, false); // Active or discharged in the last step
+    for (int begin = 0; begin < total; begin += batch) {
+        int end = std::min(begin + batch, total);
+        for (int u = 0; u < m_csr.nodeCount; ++u) {
+            if (shown[u]) recorder.setNodeColor(u, Qt::white);
+            shown[u] = false;
+        }
+
+        int discharged = 0;
+        int relabels = 0;
+        int globalRelabels = 0;
+        for (int p = begin; p < end; ++p) {
+            const MaxFlow::PushRelabelTrace::Pulse& pulse = trace.pulses[p];
+            for (const QPair<int, int>& change : pulse.changedFlows) {
+                recorder.setEdgeColor(change.first, flowColor(change.second, edges[change.first].weight));
+            }
+            discharged += pulse.discharged.size();
+            relabels += pulse.relabels;
+            globalRelabels += pulse.globalRelabel;
+            for (int u : pulse.discharged) shown[u] = true;
+        }
+        const MaxFlow::PushRelabelTrace::Pulse& last = trace.pulses[end - 1];
+        for (int u = 0; u < m_csr.nodeCount; ++u) {
+            if (shown[u]) recorder.setNodeColor(u, DISCHARGED_NODE_COLOR);
+        }
+        for (int u : last.active) {
+            recorder.setNodeColor(u, ACTIVE_NODE_COLOR);
+            shown[u] = true;
+        }
+        recorder.setNodeColor(source, SOURCE_COLOR);
+        recorder.setNodeColor(sink, SINK_COLOR);
+
+        QString pulses = end - begin == 1 ? "Pulse " + QString::number(begin + 1)
+                                          : "Pulses " + QString::number(begin + 1) + "-" + QString::number(end);
+        recorder.record(history, pulses + ": " + QString::number(discharged) + " nodes discharged, "
+                                 + QString::number(relabels) + " relabels" + (globalRelabels > 0 ? ", global relabel" : "")
+                                 + " | " + QString::number(last.active.size()) + " active, excess at sink "
+                                 + QString::number(last.sinkExcess));
+    }
 
-    history.append(QVariant::fromValue(createSnapshot("MST Complete. Total Weight: " + QString::number(totalWeight), visited, {}, -1, {}, mstEdges)));
+    recordMinCut(history, recorder, result, " | " + QString::number(result.pushes) + " pushes, "
+                                               + QString::number(result.relabels) + " relabels, "
+                                               + QString::number(result.globalRelabels) + " global relabels");
     return history;
 }
 
-GraphStep Graph::createSnapshot(const QString& message, const QSet<int>& visited,
-                                const QSet<int>& currentQueueStack, int currentNode,
-                                const QMap<int, int>& distances,
-                                const QSet<QPair<int, int>>& pathEdges)
+void Graph::recordMinCut(QList<QVariant>& history, GraphRecorder& recorder, const MaxFlow::Result& result, const QString& summary)
+{
+    QVector<GraphEdge> edges = m_csr.edgeList();
+    int cutEdges = 0;
+    for (int u = 0; u < m_csr.nodeCount; ++u) recorder.setNodeColor(u, result.sourceSide[u] ? CUT_SIDE_COLOR : QColor(Qt::white));
+    for (int edge = 0; edge < edges.size(); ++edge) {
+        const GraphEdge& e = edges[edge];
+        bool crosses = result.sourceSide[e.from] != result.sourceSide[e.to];
+        if (crosses && (result.sourceSide[e.from] || !m_csr.directed)) {
+            recorder.setEdgeColor(edge, SINK_COLOR);
+            cutEdges++;
+        } else {
+            recorder.setEdgeColor(edge, flowColor(result.edgeFlow[edge], e.weight));
+        }
+    }
+    recorder.record(history, "Max Flow Found: " + QString::number(result.value) + " | minimum cut of "
+                             + QString::number(cutEdges) + " edges" + summary);
+}
+
+// --- Iterative analytics ---
+
+QList<QVariant> Graph::pageRank()
+{
+    compactCsr();
+    QVector<QVector<double>> trace;
+    GraphAnalytics::Convergence convergence;
+    GraphAnalytics::pageRank(m_csr, reverse(), ThreadPool::global(), GraphAnalytics::DAMPING,
+                             GraphAnalytics::TOLERANCE, GraphAnalytics::MAX_ITERATIONS, &convergence, &trace);
+    return recordScores(trace, convergence, "PageRank", "PageRank (damping " + QString::number(GraphAnalytics::DAMPING)
+                                                        + ") on " + QString::number(m_csr.nodeCount) + " nodes: every node starts at 1/V");
+}
+
+QList<QVariant> Graph::personalizedPageRank(int seedNodeId)
+{
+    compactCsr();
+    QVector<QVector<double>> trace;
+    GraphAnalytics::Convergence convergence;
+    GraphAnalytics::personalizedPageRank(m_csr, reverse(), {seedNodeId}, ThreadPool::global(),
+                                         GraphAnalytics::DAMPING, GraphAnalytics::TOLERANCE, GraphAnalytics::MAX_ITERATIONS,
+                                         &convergence, &trace);
+    return recordScores(trace, convergence, "Personalized PageRank", "Personalized PageRank from Node " + QString::number(seedNodeId)
+                                                                     + ": random jumps return to the seed");
+}
+
+QList<QVariant> Graph::recordScores(const QVector<QVector<double>>& trace, const GraphAnalytics::Convergence& convergence,
+                                    const QString& name, const QString& intro)
 {
+    QList<QVariant> history;
+    GraphRecorder recorder(topology());
+    recorder.record(history, intro);
+
+    // Shaded relative to the top score of each iteration
+    auto top = [](const QVector<double>& scores) { return int(std::max_element(scores.begin(), scores.end()) - scores.begin()); };
+    for (int iteration = 0; iteration < trace.size(); ++iteration) {
+        const QVector<double>& scores = trace[iteration];
+        int best = top(scores);
+        for (int u = 0; u < m_csr.nodeCount; ++u) {
+            double shade = scores[best] > 0.0 ? std::sqrt(scores[u] / scores[best]) : 0.0;
+            recorder.setNodeColor(u, QColor::fromHsv(220, 40 + int(215 * shade), 255 - int(135 * shade)));
+        }
+        recorder.record(history, "Iteration " + QString::number(iteration + 1) + ": L1 change "
+                                 + QString::number(convergence.residuals[iteration], 'g', 3) + " | top Node "
+                                 + QString::number(best) + " (" + QString::number(scores[best], 'g', 4) + ")");
+    }
+
+    if (trace.isEmpty()) return history;
+    const QVector<double>& scores = trace.last();
+    QVector<int> order(m_csr.nodeCount);
+    for (int u = 0; u < order.size(); ++u) order[u] = u;
+    int shown = std::min(3, (int)order.size());
+    std::partial_sort(order.begin(), order.begin() + shown, order.end(), [&](int a, int b) { return scores[a] > scores[b]; });
+    QString ranking;
+    for (int i = 0; i < shown; ++i) {
+        if (i > 0) ranking += ", ";
+        ranking += "Node " + QString::number(order[i]) + " (" + QString::number(scores[order[i]], 'g', 4) + ")";
+    }
+    recorder.record(history, name + (convergence.converged ? " Converged after " : " Stopped after ")
+                             + QString::number(convergence.iterations) + " iterations | top: " + ranking);
+    return history;
+}
+
+QList<QVariant> Graph::labelPropagation()
+{
+    compactCsr();
+    QList<QVariant> history;
+    QVector<QVector<int>> trace;
+    GraphAnalytics::Convergence convergence;
+    GraphAnalytics::labelPropagation(m_csr, reverse(), ThreadPool::global(),
+                                     GraphAnalytics::MAX_ITERATIONS, &convergence, &trace);
+
+    GraphRecorder recorder(topology());
+    recorder.record(history, "Label propagation on " + QString::number(m_csr.nodeCount)
+                             + " nodes: every node starts in its own community");
+
+    QVector<int> members(m_csr.nodeCount);
+    int communities = 0;
+    for (int iteration = 0; iteration < trace.size(); ++iteration) {
+        const QVector<int>& label = trace[iteration];
+        members.fill(0);
+        communities = 0;
+        for (int u = 0; u < m_csr.nodeCount; ++u) {
+            recorder.setNodeColor(u, GROUP_COLORS[label[u] % GROUP_COLOR_COUNT]);
+            if (members[label[u]]++ == 0) communities++;
+        }
+        recorder.record(history, "Iteration " + QString::number(iteration + 1) + ": "
+                                 + QString::number((int)convergence.residuals[iteration]) + " nodes changed label | "
+                                 + QString::number(communities) + " communities");
+    }
+    recorder.record(history, QString(convergence.converged ? "Label Propagation Converged after " : "Label Propagation Stopped after ")
+                             + QString::number(convergence.iterations) + " iterations | "
+                             + QString::number(communities) + " communities");
+    return history;
+}
+
+// --- Force-directed layout ---
+
+void Graph::startForceLayout()
+{
+    compactCsr();
+    m_layout.reset(new ForceLayout(m_csr, reverse(), ThreadPool::global()));
+    m_layoutChanges.reset(new QVector<GraphChange>);
+    m_pathsView = UpdateView(); // Their steps show the old positions
+    m_forestView = UpdateView();
+}
+
+QVariant Graph::forceLayoutFrame(int budgetMs, bool* done)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!m_layout->run(1) && timer.elapsed() < budgetMs) {}
+    const ForceLayout::Stats& stats = m_layout->stats();
+    *done = m_layout->isDone();
+
+    m_layout->positions(GraphGenerators::LAYOUT_WIDTH, GraphGenerators::LAYOUT_HEIGHT, m_csr.xs, m_csr.ys);
+    if (m_reverse.nodeCount == m_csr.nodeCount) {
+        m_reverse.xs = m_csr.xs;
+        m_reverse.ys = m_csr.ys;
+    }
+    m_heuristicScale = -1.0; // The lengths changed; recomputed by the next A* query
+
+    // Frames in progress show the topology as it was with just the positions
+    // replaced, all sharing one empty change log, so the canvas keeps its colors
+    // and index and only moves the nodes. The topology itself is copied with
+    // the new positions once, by the last frame or whatever runs next.
+    m_topologyMoved = true;
+
+    QString message = "Force Layout Iteration " + QString::number(stats.iterations) + " | step "
+                      + QString::number(stats.step, 'g', 3) + " | " + QString::number(stats.cells) + " quadtree cells, "
+                      + QString::number(stats.interactions) + " force terms | "
+                      + QString::number(stats.ms / stats.iterations, 'f', 1) + " ms per iteration";
+    if (*done) {
+        message = QString(stats.converged ? "Force Layout Converged after " : "Force Layout Stopped after ")
+                  + QString::number(stats.iterations) + " iterations in " + QString::number(stats.ms, 'f', 0) + " ms";
+    }
+
     GraphStep step;
     step.statusMessage = message;
+    step.changes = m_layoutChanges;
+    if (*done) {
+        step.topology = topology();
+    } else {
+        step.topology = m_topology;
+        QVector<QPointF>* positions = new QVector<QPointF>(m_csr.nodeCount);
+        for (int u = 0; u < m_csr.nodeCount; ++u) (*positions)[u] = m_csr.position(u);
+        step.positions = QSharedPointer<const QVector<QPointF>>(positions);
+    }
+    return QVariant::fromValue(step);
+}
+
+// --- Dynamic updates ---
+
+// Inserts and deletes go to the CSR overlay and patch only the edges they
+// touch, so an update costs the repair plus O(degree); the overlay is folded
+// in once it holds an eighth of the arcs, which keeps that amortized O(1).
+QList<QVariant> Graph::insertEdge(int from, int to, int weight)
+{
+    int edge = edges().size();
+    m_edges.append({from, to, weight});
+    m_csr.insertEdge(from, to, weight);
+    if (m_csr.directed && m_reverse.nodeCount == m_csr.nodeCount) m_reverse.insertEdge(to, from, weight);
+    weightChanged(from, to, weight);
+    m_layout.reset();
+    reshapeEdge(edge, -1);
+
+    QVector<int> affected;
+    if (!m_paths.isEmpty()) {
+        affected = m_paths.arcDecreased(m_csr, from, to, weight, edge);
+        if (!m_csr.directed) affected += m_paths.arcDecreased(m_csr, to, from, weight, edge);
+    }
+    DynamicSpanningForest::Repair repair;
+    if (!m_forest.isEmpty()) repair = m_forest.edgeDecreased(from, to, weight, edge);
+    compactIfOverlayFull();
+
+    return recordUpdate("Inserted Edge " + QString::number(from) + "-" + QString::number(to) + " (weight "
+                        + QString::number(weight) + ")", edge, affected, repair);
+}
 
-    // Create Nodes
-    for (int i = 0; i < m_nodeCount; ++i) {
-        NodeState ns;
-        ns.id = i;
-        ns.position = m_nodePositions[i];
+QList<QVariant> Graph::deleteEdge(int edge)
+{
+    GraphEdge removed = edges()[edge];
+    int last = m_edges.size() - 1;
+    GraphEdge moved = m_edges[last];
+
+    // Unlink the results from the edge while its id still means it
+    QVector<int> detached;
+    if (!m_paths.isEmpty()) {
+        detached = m_paths.detachEdge(edge);
+        m_paths.eraseEdge(edge);
+    }
+    int cutRoot = -1;
+    if (!m_forest.isEmpty()) {
+        cutRoot = m_forest.detachEdge(edge);
+        m_forest.eraseEdge(edge);
+    }
 
-        ns.label = QString::number(i);
+    m_csr.removeEdge(edge, removed.from, removed.to, moved.from, moved.to);
+    if (m_csr.directed && m_reverse.nodeCount == m_csr.nodeCount) m_reverse.removeEdge(edge, removed.to, removed.from, moved.to, moved.from);
+    m_edges[edge] = moved;
+    m_edges.removeLast();
+    m_hierarchyStale = true; // The A* scale stays admissible with fewer edges
+    m_layout.reset();
+
+    // The views follow the renumbering: 'edge' takes the last edge's shape and color
+    if (edge != last) reshapeEdge(edge, last);
+    reshapeEdge(last, -1);
+    for (UpdateView* view : {&m_pathsView, &m_forestView}) {
+        QVector<int> highlighted;
+        for (int id : view->edges) {
+            if (id != edge) highlighted.append(id == last ? edge : id);
+        }
+        view->edges = highlighted;
+    }
+
+    QVector<int> affected;
+    if (!m_paths.isEmpty()) affected = m_paths.edgeIncreased(m_csr, reverse(), detached);
+    DynamicSpanningForest::Repair repair;
+    if (!m_forest.isEmpty()) repair = m_forest.reconnect(m_csr, cutRoot);
+    compactIfOverlayFull();
+
+    return recordUpdate("Deleted Edge " + QString::number(removed.from) + "-" + QString::number(removed.to) + " (weight "
+                        + QString::number(removed.weight) + ")" + (cutRoot >= 0 ? ", a forest edge" : ""), -1, affected, repair);
+}
 
-        if (i == currentNode) {
-            ns.color = Qt::red;
-        } else if (currentQueueStack.contains(i)) {
-            ns.color = Qt::yellow;
-        } else if (visited.contains(i)) {
-            ns.color = Qt::green;
+QList<QVariant> Graph::reweightEdge(int edge, int weight)
+{
+    // Endpoints from the edge list: the display topology is not the graph
+    GraphEdge changed = edges()[edge];
+    int from = changed.from;
+    int to = changed.to;
+    int oldWeight = changed.weight;
+    m_edges[edge].weight = weight;
+
+    // In place: O(degree) for the CSR, and only what this one weight changes of
+    // the rest, so the update stays proportional to the repair
+    m_csr.setEdgeWeight(edge, from, to, weight);
+    if (m_csr.directed && m_reverse.nodeCount == m_csr.nodeCount) m_reverse.setEdgeWeight(edge, to, from, weight);
+    weightChanged(from, to, weight); // A heavier one leaves the old scale, smaller than needed but still admissible
+    if (m_weightLabels) reshapeEdge(edge, edge);
+
+    QVector<int> affected;
+    DynamicSpanningForest::Repair repair;
+    if (weight < oldWeight) {
+        if (!m_paths.isEmpty()) {
+            affected = m_paths.arcDecreased(m_csr, from, to, weight, edge);
+            if (!m_csr.directed) affected += m_paths.arcDecreased(m_csr, to, from, weight, edge);
+        }
+        if (!m_forest.isEmpty()) repair = m_forest.edgeDecreased(from, to, weight, edge);
+    } else if (weight > oldWeight) {
+        if (!m_paths.isEmpty()) affected = m_paths.edgeIncreased(m_csr, reverse(), m_paths.detachEdge(edge));
+        if (!m_forest.isEmpty()) {
+            int cutRoot = m_forest.detachEdge(edge);
+            repair = m_forest.reconnect(m_csr, cutRoot);
+            if (cutRoot >= 0 && repair.added != edge) repair.removed = edge;
+            if (repair.added == edge) repair.added = -1; // Cut and rejoined by itself: no swap
+        }
+    }
+
+    return recordUpdate("Reweighted Edge " + QString::number(from) + "-" + QString::number(to) + ": "
+                        + QString::number(oldWeight) + " -> " + QString::number(weight), edge, affected, repair);
+}
+
+// The hierarchy is rebuilt by the next query that needs it. A lower ratio of
+// weight to length lowers the A* scale; an unknown scale stays unknown, and
+// zero stays zero
+void Graph::weightChanged(int from, int to, int weight)
+{
+    m_hierarchyStale = true;
+    if (m_heuristicScale > 0.0) {
+        double length = std::hypot(m_csr.xs[from] - m_csr.xs[to], m_csr.ys[from] - m_csr.ys[to]);
+        if (length == 0.0) m_heuristicScale = 0.0;
+        else m_heuristicScale = std::min(m_heuristicScale, weight / length * (1.0 - 1e-9));
+    }
+}
+
+void Graph::compactIfOverlayFull()
+{
+    if (m_csr.overlaySize() > std::max(MIN_OVERLAY_ARCS, m_csr.arcCount() / 8)) compactCsr();
+}
+
+void Graph::reshapeEdge(int edge, int colorOf)
+{
+    EdgeState es = edge < m_edges.size() ? edgeState(edge) : EdgeState();
+    for (UpdateView* view : {&m_pathsView, &m_forestView}) {
+        if (!view->recorder) continue;
+        QColor color = colorOf >= 0 ? view->recorder->edgeColor(colorOf) : EdgeState().color;
+        view->recorder->setEdgeShape(edge, es.fromId, es.toId, es.weightLabel, color);
+    }
+    m_reshapedEdges.insert(edge);
+}
+
+GraphRecorder& Graph::updateView(UpdateView& view)
+{
+    if (!view.recorder) view.recorder.reset(new GraphRecorder(topology()));
+    return *view.recorder;
+}
+
+void Graph::clearUpdateView(UpdateView& view)
+{
+    for (int node : view.nodes) view.recorder->setNodeColor(node, m_topology->nodes[node].color);
+    for (int edge : view.edges) view.recorder->setEdgeColor(edge, EdgeState().color);
+    view.nodes.clear();
+    view.edges.clear();
+}
+
+// One step for the change itself (the edge in orange), then the repaired
+// shortest paths (affected nodes visited, the tracked path in orange) and the
+// repaired forest (examined nodes visited, forest edges in orange). Both views
+// carry over from the last update and only repaint what it and this one touched.
+QList<QVariant> Graph::recordUpdate(const QString& message, int edge, const QVector<int>& affected,
+                                    const DynamicSpanningForest::Repair& repair)
+{
+    QList<QVariant> history;
+    auto edgeName = [this](int id) {
+        return QString::number(edges()[id].from) + "-" + QString::number(edges()[id].to);
+    };
+    const QColor changeColor = QColor(255, 165, 0);
+
+    // The change is shown on the first view, and taken back before its own step.
+    // With no results to repair the paths view still carries the edits, so
+    // updates never copy the topology
+    bool repaired = !m_paths.isEmpty() || !m_forest.isEmpty();
+    GraphRecorder& changeRecorder = updateView(!m_paths.isEmpty() || !repaired ? m_pathsView : m_forestView);
+    QColor before = edge >= 0 ? changeRecorder.edgeColor(edge) : QColor();
+    if (edge >= 0) changeRecorder.setEdgeColor(edge, changeColor);
+    changeRecorder.record(history, repaired ? message : message + " | run Dijkstra or Prim's MST to have its result repaired");
+    if (edge >= 0) changeRecorder.setEdgeColor(edge, before);
+    if (!repaired) return history;
+
+    if (!m_paths.isEmpty()) {
+        GraphRecorder& recorder = updateView(m_pathsView);
+        clearUpdateView(m_pathsView);
+        int source = m_paths.source();
+        for (int node : affected) {
+            recorder.setNodeColor(node, Qt::green);
+            m_pathsView.nodes.append(node);
+        }
+        recorder.setNodeColor(source, Qt::red);
+        m_pathsView.nodes.append(source);
+        recorder.record(history, "Shortest paths from Node " + QString::number(source) + " repaired: "
+                                 + QString::number(affected.size()) + " of " + QString::number(m_csr.nodeCount) + " nodes affected");
+
+        if (m_paths.distance(m_pathTarget) == GraphKernels::UNREACHABLE) {
+            recorder.record(history, "Target Node " + QString::number(m_pathTarget) + " is now unreachable");
         } else {
-            ns.color = Qt::white;
-        }
-
-        ns.textColor = Qt::black;
-        step.nodes.append(ns);
-    }
-
-    // Create Edges
-    for (auto it = m_adjList.begin(); it != m_adjList.end(); ++it) {
-        int u = it.key();
-        const QList<int>& neighbors = it.value();
-        for (int v : neighbors) {
-            if (u < v) {
-                EdgeState es;
-                es.fromId = u;
-                es.toId = v;
-
-                int w = m_edgeWeights[{u, v}];
-                es.weightLabel = QString::number(w);
-
-                // Check for Path/MST edges
-                if (pathEdges.contains({u, v})) {
-                    es.color = QColor(255, 165, 0);
-                }
-                else if (visited.contains(u) && visited.contains(v)) {
-                    es.color = Qt::lightGray;
-                } else {
-                    es.color = Qt::white;
-                }
-                step.edges.append(es);
+            QString pathStr = QString::number(m_pathTarget);
+            for (int curr = m_pathTarget; curr != source; curr = m_paths.parent(curr)) {
+                recorder.setEdgeColor(m_paths.parentEdge(curr), changeColor);
+                m_pathsView.edges.append(m_paths.parentEdge(curr));
+                pathStr.prepend(QString::number(m_paths.parent(curr)) + " -> ");
             }
+            recorder.record(history, "Path to Node " + QString::number(m_pathTarget) + ": " + pathStr
+                                     + " (cost " + QString::number(m_paths.distance(m_pathTarget)) + ")");
         }
     }
 
-    return step;
+    if (!m_forest.isEmpty()) {
+        // A new view paints the whole forest once; after that only the swap
+        bool fresh = !m_forestView.recorder;
+        GraphRecorder& recorder = updateView(m_forestView);
+        clearUpdateView(m_forestView);
+        if (fresh) {
+            for (int node = 0; node < m_csr.nodeCount; ++node) {
+                if (m_forest.parentEdge(node) >= 0) recorder.setEdgeColor(m_forest.parentEdge(node), changeColor);
+            }
+        } else {
+            if (repair.removed >= 0) recorder.setEdgeColor(repair.removed, EdgeState().color);
+            if (repair.added >= 0) recorder.setEdgeColor(repair.added, changeColor);
+        }
+        for (int node : repair.nodes) {
+            recorder.setNodeColor(node, Qt::green);
+            m_forestView.nodes.append(node);
+        }
+
+        QString change = "no swap needed";
+        if (repair.added >= 0 && repair.removed >= 0) change = "Edge " + edgeName(repair.added) + " replaces Edge " + edgeName(repair.removed);
+        else if (repair.added >= 0) change = "Edge " + edgeName(repair.added) + " joins the forest";
+        else if (repair.removed >= 0) change = "Edge " + edgeName(repair.removed) + " leaves the forest";
+        recorder.record(history, "Spanning forest repaired: " + change + " | " + QString::number(repair.nodes.size())
+                                 + " nodes examined | total weight " + QString::number(m_forest.weight()));
+    }
+    return history;
 }
@@ -1,35 +1,134 @@
 #pragma once
 
 #include "datastructures.h"
+#include "contractionhierarchy.h"
+#include "csrgraph.h"
+#include "dynamicrepair.h"
+#include "forcelayout.h"
+#include "graphanalytics.h"
+#include "graphkernels.h"
+#include "graphrecorder.h"
+#include "maxflow.h"
 #include <QList>
+#include <QSet>
 #include <QVariant>
 #include <QVector>
-#include <QPair>
-#include <QMap>
 
 class Graph
 {
 public:
     Graph();
 
-    QList<QVariant> generateRandomGraph(int nodeCount = 10);
+    QList<QVariant> generateRandomGraph(int nodeCount = 10, unsigned seed = 1);
+
+    // Replaces the graph with one read from an edge-list, DIMACS or METIS file.
+    // On failure the current graph is kept, 'error' is set and the history is empty.
+    QList<QVariant> loadFromFile(const QString& path, QString* error = nullptr);
 
     QList<QVariant> bfs(int startNodeId);
+    QList<QVariant> parallelBfs(int startNodeId); // Direction-optimizing, one step per level
     QList<QVariant> dfs(int startNodeId);
+    QList<QVariant> stronglyConnectedComponents(); // Tarjan, then the condensation
+    QList<QVariant> connectedComponents();         // Union-find, then the condensation
     QList<QVariant> dijkstra(int startNodeId, int endNodeId);
+    QList<QVariant> aStar(int startNodeId, int endNodeId); // Straight-line heuristic
+    QList<QVariant> bidirectionalDijkstra(int startNodeId, int endNodeId);
+    QList<QVariant> deltaStepping(int startNodeId); // Parallel SSSP, one step per bucket phase
+
+    // Builds the hierarchy on first use (showing the contraction order), then
+    // answers the query with upward searches; later queries reuse the hierarchy
+    // until an edge changes
+    QList<QVariant> contractionHierarchy(int startNodeId, int endNodeId);
 
     QList<QVariant> primMST(int startNodeId);
+    QList<QVariant> kruskalMST();
+    QList<QVariant> boruvkaMST(); // Parallel, one step per round
+
+    QList<QVariant> floydWarshall(); // All pairs, MatrixSteps: one per tile phase
+
+    // Weighted and hop distances between a sample of nodes, answered as one
+    // parallel batch: the rows colored by thread, then one heatmap per metric
+    QList<QVariant> distanceTable();
+
+    // Max flow with edge weights as capacities, ending on the minimum cut
+    QList<QVariant> dinicMaxFlow(int source, int sink);       // Level graph, then augmenting paths per phase
+    QList<QVariant> pushRelabelMaxFlow(int source, int sink); // Highest label; active nodes per pulse
+
+    // Parallel iterative scores, one step per iteration: nodes shaded by
+    // score, or colored by community for label propagation
+    QList<QVariant> pageRank();
+    QList<QVariant> personalizedPageRank(int seedNodeId);
+    QList<QVariant> labelPropagation();
+
+    // --- Force-directed layout ---
+    // Streamed rather than recorded up front: startForceLayout() begins a
+    // Barnes-Hut layout from the current positions, and each
+    // forceLayoutFrame() runs it for about 'budgetMs' (at least one iteration),
+    // moves the nodes and returns one step showing them. 'done' is set once it
+    // has converged; every later algorithm runs on the new positions.
+    void startForceLayout();
+    QVariant forceLayoutFrame(int budgetMs, bool* done);
+
+    // --- Dynamic updates ---
+    // Each change repairs the results of the last dijkstra() (its whole
+    // shortest-path tree) and primMST() (the minimum spanning forest) rather
+    // than recomputing them, and shows only the nodes the repair touched
+    QList<QVariant> insertEdge(int from, int to, int weight);
+    QList<QVariant> deleteEdge(int edge); // The last edge takes over its id
+    QList<QVariant> reweightEdge(int edge, int weight);
+
+    const CsrGraph& csr() const { return m_csr; } // With the overlay of the updates since the last algorithm
+    const DynamicShortestPaths& repairedPaths() const { return m_paths; } // As the updates keep them
+    const DynamicSpanningForest& repairedForest() const { return m_forest; }
 
 private:
-    QMap<int, QList<int>> m_adjList;
-    QMap<QPair<int, int>, int> m_edgeWeights;
-    QMap<int, QPointF> m_nodePositions;
-    int m_nodeCount;
+    CsrGraph m_csr;                // Updates add to its overlay; every other algorithm compacts it first
+    CsrGraph m_reverse;            // Reversed arcs for backward searches; built by reverse() on first use
+    QVector<GraphEdge> m_edges;    // m_csr's edges by id, built by the first update that needs them
+    double m_heuristicScale = -1.0; // A* estimate per unit of straight-line distance; -1 until needed
+    QSharedPointer<const GraphTopology> m_topology; // Shared by every step recorded on this graph
+    bool m_topologyMoved = false;     // A layout moved the nodes since m_topology was built
+    QSet<int> m_reshapedEdges;        // Edge ids updates changed since then
+    bool m_weightLabels = true;       // m_topology labels edges with their weights
+    ContractionHierarchy m_hierarchy; // Built by the first contractionHierarchy() query on this graph
+    bool m_hierarchyStale = true;     // The weights changed since m_hierarchy was built
+    DynamicShortestPaths m_paths;     // Full tree of the last dijkstra(), kept valid by updates
+    int m_pathTarget = -1;            // Its target, whose path is shown after each update
+    DynamicSpanningForest m_forest;   // Forest of the last primMST() on an undirected graph
+    QSharedPointer<ForceLayout> m_layout; // Layout in progress; dropped whenever the graph changes
+    QSharedPointer<const QVector<GraphChange>> m_layoutChanges; // Empty, shared by its frames
 
-    void dfsRecursive(int node, QSet<int>& visited, QList<QVariant>& history, QList<int>& traversalOrder);
+    // Views of the repaired results, kept from one update to the next so each
+    // update only logs the colors it changes; dropped whenever edge ids change
+    struct UpdateView {
+        QSharedPointer<GraphRecorder> recorder;
+        QVector<int> nodes; // Highlighted by the last update
+        QVector<int> edges;
+    };
+    UpdateView m_pathsView;
+    UpdateView m_forestView;
 
-    GraphStep createSnapshot(const QString& message, const QSet<int>& visited,
-                             const QSet<int>& currentQueueStack, int currentNode = -1,
-                             const QMap<int, int>& distances = {},
-                             const QSet<QPair<int, int>>& pathEdges = {});
+    void setCsr(CsrGraph graph);
+    void compactCsr();                                // Folds the update overlay into m_csr and m_reverse
+    void refreshDerived();                            // Everything computed from the edge weights
+    const QVector<GraphEdge>& edges();                // m_edges, built on first use
+    const QSharedPointer<const GraphTopology>& topology(); // m_topology, with the layout's positions and updated edges
+    EdgeState edgeState(int edge) const;              // As the topology shows m_edges[edge]
+    const CsrGraph& reverse();                        // m_csr itself if undirected, else m_reverse
+    double heuristicScale();                          // m_heuristicScale, computed on first use
+    QList<QVariant> recordUpdate(const QString& message, int edge, const QVector<int>& affected,
+                                 const DynamicSpanningForest::Repair& repair);
+    void weightChanged(int from, int to, int weight); // Edge from-to is new or reweighted: drops what it invalidates
+    void compactIfOverlayFull();
+    // Shows the current m_edges[edge] (no edge past the end) in every live view,
+    // in the color 'colorOf' has there (-1: plain), without a new topology
+    void reshapeEdge(int edge, int colorOf);
+    GraphRecorder& updateView(UpdateView& view); // Its recorder, created on first use
+    void clearUpdateView(UpdateView& view);      // Last update's highlights back to plain
+    QList<QVariant> bestFirstSearch(int startNodeId, int endNodeId, double heuristicScale, const QString& name);
+    QString tracePath(TraversalPainter& painter, const QVector<int>& parent, const QVector<int>& parentEdge, int from, int to);
+    QList<QVariant> recordScores(const QVector<QVector<double>>& trace, const GraphAnalytics::Convergence& convergence,
+                                 const QString& name, const QString& intro);
+    void recordMinCut(QList<QVariant>& history, GraphRecorder& recorder, const MaxFlow::Result& result, const QString& summary);
+    void recordComponents(QList<QVariant>& history, const GraphKernels::Components& components, const QString& kind);
 };
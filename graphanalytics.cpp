@@ -0,0 +1,250 @@
+#include "graphanalytics.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace GraphAnalytics
+{
+namespace
+{
+const int BLOCKS_PER_THREAD = 8; // Row blocks per thread, so uneven blocks still balance
+const int VOTE_GRAIN = 256;      // Nodes per chunk of a label propagation class
+
+// Row ranges [blocks[i], blocks[i + 1]) of about equal cost, a row costing one
+// plus its arc count
+QVector<int> rowBlocks(const CsrGraph& graph, int blockCount)
+{
+    int n = graph.nodeCount;
+    long long total = (long long)graph.arcCount() + n;
+    blockCount = (int)std::max(1LL, std::min<long long>(blockCount, n));
+    QVector<int> blocks(blockCount + 1);
+    blocks[0] = 0;
+    blocks[blockCount] = n;
+    for (int i = 1; i < blockCount; ++i) {
+        // First row whose start lies at or past i / blockCount of the total cost
+        long long target = total * i / blockCount;
+        int low = blocks[i - 1];
+        int high = n;
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if ((long long)graph.offsets[mid] + mid < target) low = mid + 1;
+            else high = mid;
+        }
+        blocks[i] = low;
+    }
+    return blocks;
+}
+
+// Per-thread sums, one cache line each
+struct alignas(64) Partial {
+    double residual = 0.0;
+    double dangling = 0.0;
+};
+
+// Power iteration with the random jump landing on node v with probability teleport[v]
+QVector<double> powerIteration(const CsrGraph& graph, const CsrGraph& reverse, const QVector<double>& teleport,
+                               ThreadPool& pool, double damping, double tolerance, int maxIterations,
+                               Convergence* convergence, QVector<QVector<double>>* trace)
+{
+    int n = graph.nodeCount;
+    if (convergence) *convergence = Convergence();
+    if (trace) trace->clear();
+    if (n == 0) return {};
+
+    QVector<double> inverseDegree(n);
+    for (int u = 0; u < n; ++u) inverseDegree[u] = graph.degree(u) > 0 ? 1.0 / graph.degree(u) : 0.0;
+
+    // contribution[u] = rank[u] / outdegree(u), kept next to the rank so each
+    // sweep reads one array per arc; dangling rank is summed separately
+    QVector<double> rank = teleport;
+    QVector<double> next(n);
+    QVector<double> contribution(n);
+    QVector<double> nextContribution(n);
+    double dangling = 0.0;
+    for (int u = 0; u < n; ++u) {
+        contribution[u] = rank[u] * inverseDegree[u];
+        if (graph.degree(u) == 0) dangling += rank[u];
+    }
+
+    QVector<int> blocks = rowBlocks(reverse, pool.threadCount() * BLOCKS_PER_THREAD);
+    std::vector<Partial> partials(pool.threadCount());
+    const int* offsets = reverse.offsets.constData();
+    const int* sources = reverse.targets.constData();
+
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        for (Partial& partial : partials) partial = Partial();
+        const double* in = contribution.constData();
+        double* out = next.data();
+        double* outContribution = nextContribution.data();
+        double jump = 1.0 - damping + damping * dangling; // Rank spread through the teleport vector
+
+        pool.parallelFor(blocks.size() - 1, 1, [&](int thread, int first, int last) {
+            double residual = 0.0;
+            double danglingPart = 0.0;
+            for (int block = first; block < last; ++block) {
+                for (int v = blocks[block]; v < blocks[block + 1]; ++v) {
+                    // Four accumulators break the add chain, so loads of
+                    // different arcs overlap (and become gathers where available)
+                    int arc = offsets[v];
+                    int end = offsets[v + 1];
+                    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+                    for (; arc + 4 <= end; arc += 4) {
+                        s0 += in[sources[arc]];
+                        s1 += in[sources[arc + 1]];
+                        s2 += in[sources[arc + 2]];
+                        s3 += in[sources[arc + 3]];
+                    }
+                    for (; arc < end; ++arc) s0 += in[sources[arc]];
+
+                    double value = damping * ((s0 + s1) + (s2 + s3)) + jump * teleport[v];
+                    residual += std::abs(value - rank[v]);
+                    out[v] = value;
+                    outContribution[v] = value * inverseDegree[v];
+                    if (inverseDegree[v] == 0.0) danglingPart += value;
+                }
+            }
+            partials[thread].residual += residual;
+            partials[thread].dangling += danglingPart;
+        });
+
+        double residual = 0.0;
+        dangling = 0.0;
+        for (const Partial& partial : partials) {
+            residual += partial.residual;
+            dangling += partial.dangling;
+        }
+        rank.swap(next);
+        contribution.swap(nextContribution);
+
+        if (trace) trace->append(rank);
+        if (convergence) {
+            convergence->iterations++;
+            convergence->arcsProcessed += reverse.arcCount();
+            convergence->residuals.append(residual);
+        }
+        if (residual < tolerance) {
+            if (convergence) convergence->converged = true;
+            break;
+        }
+    }
+    return rank;
+}
+} // namespace
+
+QVector<double> pageRank(const CsrGraph& graph, const CsrGraph& reverse, ThreadPool& pool, double damping,
+                         double tolerance, int maxIterations, Convergence* convergence, QVector<QVector<double>>* trace)
+{
+    QVector<double> teleport(graph.nodeCount, graph.nodeCount > 0 ? 1.0 / graph.nodeCount : 0.0);
+    return powerIteration(graph, reverse, teleport, pool, damping, tolerance, maxIterations, convergence, trace);
+}
+
+QVector<double> personalizedPageRank(const CsrGraph& graph, const CsrGraph& reverse, const QVector<int>& seeds,
+                                     ThreadPool& pool, double damping, double tolerance, int maxIterations,
+                                     Convergence* convergence, QVector<QVector<double>>* trace)
+{
+    QVector<double> teleport(graph.nodeCount, 0.0);
+    for (int seed : seeds) teleport[seed] += 1.0 / seeds.size();
+    return powerIteration(graph, reverse, teleport, pool, damping, tolerance, maxIterations, convergence, trace);
+}
+
+QVector<int> labelPropagation(const CsrGraph& graph, const CsrGraph& reverse, ThreadPool& pool, int maxIterations,
+                              Convergence* convergence, QVector<QVector<int>>* trace)
+{
+    int n = graph.nodeCount;
+    if (convergence) *convergence = Convergence();
+    if (trace) trace->clear();
+
+    // Greedy coloring in id order: no arc in either direction joins two nodes
+    // of one color, so a class can update in place while reading only other classes
+    QVector<int> color(n, -1);
+    QVector<int> usedBy; // usedBy[c] == u while coloring u if a neighbor has color c
+    int colors = 0;
+    for (int u = 0; u < n; ++u) {
+        for (const CsrGraph* side : {&graph, &reverse}) {
+            for (int arc = side->arcBegin(u); arc < side->arcEnd(u); ++arc) {
+                int c = color[side->targets[arc]];
+                if (c >= 0) usedBy[c] = u;
+            }
+        }
+        int c = 0;
+        while (c < colors && usedBy[c] == u) c++;
+        if (c == colors) {
+            usedBy.append(-1);
+            colors++;
+        }
+        color[u] = c;
+    }
+    QVector<int> classStart(colors + 1, 0);
+    for (int u = 0; u < n; ++u) classStart[color[u] + 1]++;
+    for (int c = 0; c < colors; ++c) classStart[c + 1] += classStart[c];
+    QVector<int> byClass(n);
+    QVector<int> cursor = classStart;
+    for (int u = 0; u < n; ++u) byClass[cursor[color[u]]++] = u;
+
+    QVector<int> label(n);
+    for (int u = 0; u < n; ++u) label[u] = u;
+
+    // Per-thread vote counts indexed by label, cleared through the labels a node touched
+    struct Votes {
+        std::vector<int> count;
+        std::vector<int> touched;
+    };
+    std::vector<Votes> votes(pool.threadCount());
+    for (Votes& v : votes) v.count.assign(n, 0);
+    std::vector<int> changedBy(pool.threadCount());
+    const int* offsets = reverse.offsets.constData();
+    const int* sources = reverse.targets.constData();
+    int* labels = label.data();
+
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        std::fill(changedBy.begin(), changedBy.end(), 0);
+
+        for (int c = 0; c < colors; ++c) {
+            const int* members = byClass.constData() + classStart[c];
+            pool.parallelFor(classStart[c + 1] - classStart[c], VOTE_GRAIN, [&](int thread, int begin, int end) {
+                Votes& local = votes[thread];
+                int changed = 0;
+                for (int i = begin; i < end; ++i) {
+                    int v = members[i];
+                    int current = labels[v];
+                    int best = current;
+                    int bestCount = 0;
+                    for (int arc = offsets[v]; arc < offsets[v + 1]; ++arc) {
+                        int candidate = labels[sources[arc]];
+                        int count = ++local.count[candidate];
+                        if (count == 1) local.touched.push_back(candidate);
+                        if (count > bestCount || (count == bestCount && candidate < best)) {
+                            best = candidate;
+                            bestCount = count;
+                        }
+                    }
+                    // The current label wins any tie it is part of
+                    if (local.count[current] == bestCount) best = current;
+                    for (int l : local.touched) local.count[l] = 0;
+                    local.touched.clear();
+                    if (best != current) {
+                        labels[v] = best;
+                        changed++;
+                    }
+                }
+                changedBy[thread] += changed;
+            });
+        }
+
+        int changed = 0;
+        for (int c : changedBy) changed += c;
+        if (trace) trace->append(label);
+        if (convergence) {
+            convergence->iterations++;
+            convergence->arcsProcessed += reverse.arcCount();
+            convergence->residuals.append(changed);
+        }
+        if (changed == 0) {
+            if (convergence) convergence->converged = true;
+            break;
+        }
+    }
+    return label;
+}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "csrgraph.h"
+#include <QVector>
+
+class ThreadPool;
+
+// Iterative whole-graph scores written as sparse matrix-vector products over
+// CsrGraph rows. Every iteration is one pull sweep: each node reads its
+// in-neighbors' values and writes only its own entry, so rows split across
+// threads without atomics. Rows are cut into blocks of about equal arc count,
+// which keeps the hubs of power-law graphs from stalling a single thread.
+namespace GraphAnalytics
+{
+const double DAMPING = 0.85;
+const double TOLERANCE = 1e-6; // L1 change per iteration at which PageRank stops
+const int MAX_ITERATIONS = 100;
+
+// How an iterative run went
+struct Convergence {
+    int iterations = 0;
+    bool converged = false;
+    long long arcsProcessed = 0; // Arcs read over all iterations
+    QVector<double> residuals;   // Per iteration: L1 change (PageRank) or nodes changed (labels)
+};
+
+// PageRank by power iteration. 'reverse' is graph.reversed(), or the graph
+// itself if undirected. Dangling nodes spread their rank uniformly. Scores sum
+// to 1. 'trace', if set, receives the scores after every iteration.
+QVector<double> pageRank(const CsrGraph& graph, const CsrGraph& reverse, ThreadPool& pool,
+                         double damping = DAMPING, double tolerance = TOLERANCE, int maxIterations = MAX_ITERATIONS,
+                         Convergence* convergence = nullptr, QVector<QVector<double>>* trace = nullptr);
+
+// PageRank whose random jumps (and dangling rank) return to the 'seeds' only:
+// relevance to the seeds rather than global importance
+QVector<double> personalizedPageRank(const CsrGraph& graph, const CsrGraph& reverse, const QVector<int>& seeds,
+                                     ThreadPool& pool, double damping = DAMPING, double tolerance = TOLERANCE,
+                                     int maxIterations = MAX_ITERATIONS, Convergence* convergence = nullptr,
+                                     QVector<QVector<double>>* trace = nullptr);
+
+// Community labels: every node starts with its own id and takes the most
+// frequent label among the nodes it has arcs from, keeping its own on a tie
+// (else the smallest). Plain synchronous rounds can flip-flop forever, so
+// rounds are semi-synchronous (Cordasco & Gargano): a greedy coloring splits
+// the nodes into classes with no arc inside, and the classes update one after
+// another, each in parallel and in place. Stops when a round changes nothing.
+QVector<int> labelPropagation(const CsrGraph& graph, const CsrGraph& reverse, ThreadPool& pool,
+                              int maxIterations = MAX_ITERATIONS, Convergence* convergence = nullptr,
+                              QVector<QVector<int>>* trace = nullptr);
+}
@@ -0,0 +1,213 @@
+#include "graphgenerators.h"
+#include "fastrng.h"
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+const int MIN_WEIGHT = 1;
+const int MAX_WEIGHT = 9;
+const int GRID_EDGE_PERCENT = 80;
+const int GRID_DIAGONAL_PERCENT = 30;
+
+namespace
+{
+void scatterNodes(CsrGraph& graph, FastRng& rng)
+{
+    for (int u = 0; u < graph.nodeCount; ++u) {
+        graph.xs[u] = rng.generateDouble() * GraphGenerators::LAYOUT_WIDTH;
+        graph.ys[u] = rng.generateDouble() * GraphGenerators::LAYOUT_HEIGHT;
+    }
+}
+
+int randomWeight(FastRng& rng)
+{
+    return rng.bounded(MIN_WEIGHT, MAX_WEIGHT + 1);
+}
+}
+
+CsrGraph GraphGenerators::grid(int nodeCount, unsigned seed)
+{
+    FastRng rng(seed);
+    QVector<GraphEdge> edges;
+    QVector<int> degree(nodeCount, 0);
+
+    double aspectRatio = LAYOUT_WIDTH / LAYOUT_HEIGHT;
+    int cols = std::max(1, (int)std::ceil(std::sqrt(nodeCount * aspectRatio)));
+    int rows = (nodeCount + cols - 1) / cols;
+
+    auto link = [&](int i, int j, int percent) {
+        if ((int)rng.bounded(100) < percent) {
+            edges.append({i, j, randomWeight(rng)});
+            degree[i]++;
+            degree[j]++;
+        }
+    };
+
+    // Each node looks only at its right, lower-left, lower and lower-right neighbors
+    for (int i = 0; i < nodeCount; ++i) {
+        int c = i % cols;
+        if (c + 1 < cols && i + 1 < nodeCount) link(i, i + 1, GRID_EDGE_PERCENT);
+        if (c > 0 && i + cols - 1 < nodeCount) link(i, i + cols - 1, GRID_DIAGONAL_PERCENT);
+        if (i + cols < nodeCount) link(i, i + cols, GRID_EDGE_PERCENT);
+        if (c + 1 < cols && i + cols + 1 < nodeCount) link(i, i + cols + 1, GRID_DIAGONAL_PERCENT);
+    }
+
+    // Ensure no node is isolated
+    for (int i = 0; i < nodeCount; ++i) {
+        if (degree[i] == 0) {
+            int neighbor = (i > 0) ? i - 1 : i + 1;
+            if (neighbor < nodeCount) {
+                edges.append({std::min(i, neighbor), std::max(i, neighbor), randomWeight(rng)});
+                degree[i]++;
+                degree[neighbor]++;
+            }
+        }
+    }
+
+    CsrGraph graph = CsrGraph::build(nodeCount, edges);
+    double hSpacing = LAYOUT_WIDTH / (cols + 1);
+    double vSpacing = LAYOUT_HEIGHT / (rows + 1);
+    for (int i = 0; i < nodeCount; ++i) {
+        graph.xs[i] = hSpacing * (i % cols + 1);
+        graph.ys[i] = vSpacing * (i / cols + 1);
+    }
+    return graph;
+}
+
+CsrGraph GraphGenerators::randomGeometric(int nodeCount, double radius, unsigned seed)
+{
+    FastRng rng(seed);
+    QVector<double> xs(nodeCount);
+    QVector<double> ys(nodeCount);
+    for (int u = 0; u < nodeCount; ++u) {
+        xs[u] = rng.generateDouble() * LAYOUT_WIDTH;
+        ys[u] = rng.generateDouble() * LAYOUT_HEIGHT;
+    }
+
+    // 1. Hash points into square cells at least 'radius' wide, so every
+    //    neighbor is in the same or an adjacent cell. Cells never get smaller
+    //    than one point's share of the area, which bounds the cell count by ~V.
+    double cellSize = std::max(radius, std::sqrt(LAYOUT_WIDTH * LAYOUT_HEIGHT / std::max(1, nodeCount)));
+    int cellsX = std::max(1, (int)(LAYOUT_WIDTH / cellSize));
+    int cellsY = std::max(1, (int)(LAYOUT_HEIGHT / cellSize));
+    auto cellOf = [&](int u) {
+        int cx = std::min(cellsX - 1, (int)(xs[u] / LAYOUT_WIDTH * cellsX));
+        int cy = std::min(cellsY - 1, (int)(ys[u] / LAYOUT_HEIGHT * cellsY));
+        return cy * cellsX + cx;
+    };
+
+    // 2. Counting sort the points by cell
+    QVector<int> cellStart(cellsX * cellsY + 1, 0);
+    for (int u = 0; u < nodeCount; ++u) cellStart[cellOf(u) + 1]++;
+    for (int cell = 0; cell < cellsX * cellsY; ++cell) cellStart[cell + 1] += cellStart[cell];
+    QVector<int> cellPoints(nodeCount);
+    QVector<int> cursor = cellStart;
+    for (int u = 0; u < nodeCount; ++u) cellPoints[cursor[cellOf(u)]++] = u;
+
+    // 3. Compare each cell with itself and its forward half-neighborhood,
+    //    so every close pair is found exactly once
+    QVector<GraphEdge> edges;
+    double radiusSquared = radius * radius;
+    auto tryLink = [&](int u, int v) {
+        double dx = xs[u] - xs[v];
+        double dy = ys[u] - ys[v];
+        double distSquared = dx * dx + dy * dy;
+        if (distSquared < radiusSquared) {
+            int weight = (int)std::ceil(MAX_WEIGHT * std::sqrt(distSquared) / radius);
+            edges.append({u, v, std::clamp(weight, MIN_WEIGHT, MAX_WEIGHT)});
+        }
+    };
+    const int forward[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+    for (int cy = 0; cy < cellsY; ++cy) {
+        for (int cx = 0; cx < cellsX; ++cx) {
+            int cell = cy * cellsX + cx;
+            for (int i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                int u = cellPoints[i];
+                for (int j = i + 1; j < cellStart[cell + 1]; ++j) tryLink(u, cellPoints[j]);
+
+                for (const auto& offset : forward) {
+                    int nx = cx + offset[0];
+                    int ny = cy + offset[1];
+                    if (nx < 0 || nx >= cellsX || ny >= cellsY) continue;
+                    int other = ny * cellsX + nx;
+                    for (int j = cellStart[other]; j < cellStart[other + 1]; ++j) tryLink(u, cellPoints[j]);
+                }
+            }
+        }
+    }
+
+    CsrGraph graph = CsrGraph::build(nodeCount, edges);
+    graph.xs = xs;
+    graph.ys = ys;
+    return graph;
+}
+
+CsrGraph GraphGenerators::erdosRenyi(int nodeCount, double edgeProbability, unsigned seed)
+{
+    FastRng rng(seed);
+    QVector<GraphEdge> edges;
+
+    // Walk the pairs (v, w), w < v, in order; the gap to the next chosen pair
+    // is geometrically distributed, so it is drawn directly instead of one coin per pair
+    if (edgeProbability > 0.0) {
+        double logSkip = std::log(1.0 - std::min(edgeProbability, 1.0));
+        double pairCount = (double)nodeCount * nodeCount;
+        long long v = 1;
+        long long w = -1;
+        while (v < nodeCount) {
+            double skip = std::floor(std::log(1.0 - rng.generateDouble()) / logSkip);
+            if (skip >= pairCount) break;
+            w += 1 + (long long)skip;
+            while (w >= v && v < nodeCount) {
+                w -= v;
+                v++;
+            }
+            if (v < nodeCount) edges.append({(int)w, (int)v, randomWeight(rng)});
+        }
+    }
+
+    CsrGraph graph = CsrGraph::build(nodeCount, edges);
+    scatterNodes(graph, rng);
+    return graph;
+}
+
+CsrGraph GraphGenerators::rmat(int scale, int edgeCount, unsigned seed, double a, double b, double c)
+{
+    FastRng rng(seed);
+    int nodeCount = 1 << scale;
+    double ab = a + b;
+    double abc = a + b + c;
+
+    QVector<GraphEdge> edges(edgeCount);
+    for (GraphEdge& e : edges) {
+        int u;
+        int v;
+        do {
+            u = 0;
+            v = 0;
+            for (int bit = scale - 1; bit >= 0; --bit) {
+                double r = rng.generateDouble();
+                if (r >= abc) { u |= 1 << bit; v |= 1 << bit; }
+                else if (r >= ab) u |= 1 << bit;
+                else if (r >= a) v |= 1 << bit;
+            }
+        } while (u == v);
+        e = {u, v, randomWeight(rng)};
+    }
+
+    CsrGraph graph = CsrGraph::build(nodeCount, edges);
+    scatterNodes(graph, rng);
+    return graph;
+}
+
+double GraphGenerators::radiusForDegree(int nodeCount, double averageDegree)
+{
+    // Expected degree is (V - 1) * pi * r^2 / area, ignoring the border
+    return std::sqrt(averageDegree * LAYOUT_WIDTH * LAYOUT_HEIGHT / (M_PI * std::max(1, nodeCount - 1)));
+}
+
+double GraphGenerators::probabilityForDegree(int nodeCount, double averageDegree)
+{
+    return std::min(1.0, averageDegree / std::max(1, nodeCount - 1));
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "csrgraph.h"
+
+// Seeded random graph generators. Each one runs in time linear in the nodes
+// plus the edges it emits (R-MAT adds a log V factor per edge), never looks
+// at all node pairs, and lays the nodes out inside LAYOUT_WIDTH x LAYOUT_HEIGHT.
+// Graphs are undirected with weights 1..9 unless noted.
+namespace GraphGenerators
+{
+const double LAYOUT_WIDTH = 1200.0;
+const double LAYOUT_HEIGHT = 700.0;
+
+// Nodes on a grid, each orthogonal neighbor linked with 80% probability and
+// each diagonal with 30%; isolated nodes are joined to an index neighbor
+CsrGraph grid(int nodeCount, unsigned seed);
+
+// Uniform random points, linked when closer than 'radius'. Candidate pairs come
+// from a spatial hash with radius-sized cells, so only adjacent cells are compared.
+// Weights grow with edge length (ceil(9 * length / radius)), which keeps
+// 9 * straight-line distance / radius a lower bound on path cost.
+CsrGraph randomGeometric(int nodeCount, double radius, unsigned seed);
+
+// G(n, p): every pair is an edge with probability p. Geometric skipping
+// (Batagelj & Brandes) jumps straight from one chosen pair to the next.
+CsrGraph erdosRenyi(int nodeCount, double edgeProbability, unsigned seed);
+
+// R-MAT power-law graph on 2^scale nodes: each edge picks a quadrant of the
+// adjacency matrix with probabilities a, b, c, 1-a-b-c, once per bit. No self-loops.
+CsrGraph rmat(int scale, int edgeCount, unsigned seed,
+              double a = 0.57, double b = 0.19, double c = 0.19);
+
+// Radius / probability that gives the requested average degree
+double radiusForDegree(int nodeCount, double averageDegree);
+double probabilityForDegree(int nodeCount, double averageDegree);
+}
@@ -0,0 +1,894 @@
+#include "graphkernels.h"
+#include "daryheap.h"
+#include "threadpool.h"
+#include "unionfind.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+QVector<int> GraphKernels::bfsLevels(const CsrGraph& graph, int source)
+{
+    QVector<int> level(graph.nodeCount, UNREACHABLE);
+    QVector<int> queue(graph.nodeCount); // Each node is enqueued at most once
+    int head = 0;
+    int tail = 0;
+
+    level[source] = 0;
+    queue[tail++] = source;
+
+    const int* targets = graph.targets.constData();
+    while (head < tail) {
+        int u = queue[head++];
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = targets[arc];
+            if (level[v] == UNREACHABLE) {
+                level[v] = level[u] + 1;
+                queue[tail++] = v;
+            }
+        }
+    }
+    return level;
+}
+
+const int CHUNKS_PER_THREAD = 4; // Small parallel ranges are still split for balance
+const int BFS_ALPHA = 14; // Go bottom-up once frontier arcs exceed unexplored arcs / ALPHA
+const int BFS_BETA = 24;  // Go back top-down once the frontier holds fewer than nodes / BETA
+const int BFS_TOP_DOWN_GRAIN = 64;       // Most frontier nodes per chunk
+const int BFS_BOTTOM_UP_GRAIN = 64 * 64; // Most nodes per chunk
+
+const int DELTA_NODE_GRAIN = 256;   // Most nodes per chunk in a delta-stepping phase
+const int DELTA_SPLIT_GRAIN = 4096; // Nodes per chunk when splitting light and heavy arcs
+const int MST_NODE_GRAIN = 4096;    // Nodes per chunk when collecting or relabeling
+const int MST_EDGE_GRAIN = 16384;   // Edges per chunk in a Boruvka round
+const int MST_SORT_MIN_RUN = 4096;  // Shorter inputs are sorted on one thread
+
+namespace
+{
+// Per-thread output of one BFS level, padded so threads never share a cache line
+struct alignas(64) LevelBuffer {
+    std::vector<int> next;
+    long long arcs = 0; // Arcs leaving the nodes in 'next'
+};
+
+// Per-thread buckets of a delta-stepping run, padded like LevelBuffer
+struct alignas(64) BucketWorker {
+    std::vector<std::vector<int>> buckets; // Cyclic: bucket i lives in slot i % size
+    std::vector<int> relaxed;              // Nodes this thread relaxed in the current phase
+    int maxWeight = 0;
+};
+
+// Per-thread list of indices, padded like LevelBuffer
+struct alignas(64) IndexBuffer {
+    std::vector<int> items;
+};
+
+// An edge for the MST kernels; 'id' is its CsrGraph edge id
+struct WeightedEdge {
+    int weight;
+    int id;
+    int from;
+    int to;
+};
+
+// out[j] = min(out[j], add + in[j]) across one tile row. The constant trip
+// count lets the compiler vectorize without a scalar tail.
+template<int Tile>
+void minPlusRow(int* __restrict out, const int* __restrict in, int add)
+{
+    for (int j = 0; j < Tile; ++j) out[j] = std::min(out[j], add + in[j]);
+}
+
+// Relaxes tile (row, col) through the pivots of tile column 'pivot'. The
+// tiles may be the same one (diagonal and cross phases); the pivot's own row
+// would then be both input and output, but it cannot change since dist[k][k]
+// is 0, so it is skipped.
+template<int Tile>
+void relaxTile(int* dist, int stride, int row, int col, int pivot)
+{
+    int* c = dist + (size_t)row * Tile * stride + col * Tile;
+    const int* a = dist + (size_t)row * Tile * stride + pivot * Tile;
+    const int* b = dist + (size_t)pivot * Tile * stride + col * Tile;
+    for (int k = 0; k < Tile; ++k) {
+        const int* pivotRow = b + (size_t)k * stride;
+        for (int i = 0; i < Tile; ++i) {
+            int* out = c + (size_t)i * stride;
+            if (out == pivotRow) continue;
+            minPlusRow<Tile>(out, pivotRow, a[(size_t)i * stride + k]);
+        }
+    }
+}
+
+template<int Tile>
+void floydWarshallTiles(int* dist, int stride, int n, ThreadPool& pool, QVector<GraphKernels::FloydPhase>* trace)
+{
+    using GraphKernels::FloydPhase;
+    int blocks = stride / Tile;
+    QVector<QPair<int, int>> tiles;
+
+    auto runPhase = [&](int pivot, FloydPhase::Kind kind) {
+        pool.parallelFor(tiles.size(), 1, [&](int, int begin, int end) {
+            for (int t = begin; t < end; ++t) relaxTile<Tile>(dist, stride, tiles[t].first, tiles[t].second, pivot);
+        });
+        if (!trace) return;
+        QVector<int> snapshot(n * n);
+        for (int i = 0; i < n; ++i) std::copy(dist + (size_t)i * stride, dist + (size_t)i * stride + n, snapshot.begin() + i * n);
+        trace->append({pivot, kind, tiles, snapshot});
+    };
+
+    for (int pivot = 0; pivot < blocks; ++pivot) {
+        tiles = {{pivot, pivot}};
+        runPhase(pivot, FloydPhase::DIAGONAL);
+
+        tiles.clear();
+        for (int other = 0; other < blocks; ++other) {
+            if (other == pivot) continue;
+            tiles.append({pivot, other});
+            tiles.append({other, pivot});
+        }
+        if (!tiles.isEmpty()) runPhase(pivot, FloydPhase::CROSS);
+
+        tiles.clear();
+        for (int row = 0; row < blocks; ++row) {
+            for (int col = 0; col < blocks; ++col) {
+                if (row != pivot && col != pivot) tiles.append({row, col});
+            }
+        }
+        if (!tiles.isEmpty()) runPhase(pivot, FloydPhase::REMAINDER);
+    }
+}
+
+bool lighter(const WeightedEdge& a, const WeightedEdge& b)
+{
+    return a.weight != b.weight ? a.weight < b.weight : a.id < b.id;
+}
+
+// Chunk size that gives every thread a few chunks of a small range, capped for large ones
+int chunkGrain(const ThreadPool& pool, int count, int maxGrain)
+{
+    return std::clamp(count / (pool.threadCount() * CHUNKS_PER_THREAD), 1, maxGrain);
+}
+
+// Every edge once, taken from the arc at its smaller endpoint (every arc if the
+// graph is directed). Self-loops never join a spanning tree and are dropped.
+std::vector<WeightedEdge> collectEdges(const CsrGraph& graph, ThreadPool& pool)
+{
+    struct alignas(64) EdgeBuffer {
+        std::vector<WeightedEdge> edges;
+    };
+    std::vector<EdgeBuffer> buffers(pool.threadCount());
+    pool.parallelFor(graph.nodeCount, MST_NODE_GRAIN, [&](int thread, int begin, int end) {
+        std::vector<WeightedEdge>& out = buffers[thread].edges;
+        for (int u = begin; u < end; ++u) {
+            for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+                int v = graph.targets[arc];
+                if (v == u || (!graph.directed && v < u)) continue;
+                out.push_back({graph.weights[arc], graph.edgeIds[arc], u, v});
+            }
+        }
+    });
+
+    std::vector<WeightedEdge> edges;
+    edges.reserve(graph.edgeCount);
+    for (const EdgeBuffer& buffer : buffers) edges.insert(edges.end(), buffer.edges.begin(), buffer.edges.end());
+    return edges;
+}
+
+// Sorts one run per thread in parallel, then merges neighboring runs pairwise
+void parallelSort(std::vector<WeightedEdge>& edges, ThreadPool& pool)
+{
+    int runs = pool.threadCount();
+    if (runs == 1 || (int)edges.size() < runs * MST_SORT_MIN_RUN) {
+        std::sort(edges.begin(), edges.end(), lighter);
+        return;
+    }
+
+    std::vector<size_t> bounds(runs + 1);
+    for (int run = 0; run <= runs; ++run) bounds[run] = edges.size() * run / runs;
+    auto at = [&](int run) { return edges.begin() + bounds[std::min(run, runs)]; };
+
+    pool.parallelFor(runs, 1, [&](int, int begin, int end) {
+        for (int run = begin; run < end; ++run) std::sort(at(run), at(run + 1), lighter);
+    });
+    for (int width = 1; width < runs; width *= 2) {
+        int merges = (runs + 2 * width - 1) / (2 * width);
+        pool.parallelFor(merges, 1, [&](int, int begin, int end) {
+            for (int merge = begin; merge < end; ++merge) {
+                int first = merge * 2 * width;
+                if (first + width < runs) std::inplace_merge(at(first), at(first + width), at(first + 2 * width), lighter);
+            }
+        });
+    }
+}
+}
+
+QVector<int> GraphKernels::directionOptimizingBfs(const CsrGraph& graph, const CsrGraph& reverse, int source,
+                                                  ThreadPool& pool, BfsTrace* trace)
+{
+    int n = graph.nodeCount;
+    QVector<int> level(n, UNREACHABLE);
+    int* levels = level.data();
+
+    int words = (n + 63) / 64;
+    std::vector<std::atomic<quint64>> visited(words);
+    for (std::atomic<quint64>& word : visited) word.store(0, std::memory_order_relaxed);
+    std::vector<quint64> inFrontier(words);
+
+    auto isVisited = [&](int v) { return (visited[v >> 6].load(std::memory_order_relaxed) >> (v & 63)) & 1; };
+    // True for exactly one caller per node
+    auto claim = [&](int v) {
+        quint64 bit = 1ULL << (v & 63);
+        return !(visited[v >> 6].fetch_or(bit, std::memory_order_relaxed) & bit);
+    };
+
+    if (trace) {
+        trace->discoveredBy.fill(-1, n);
+        trace->bottomUp.clear();
+        trace->discoveredBy[source] = 0;
+    }
+    int* discoveredBy = trace ? trace->discoveredBy.data() : nullptr;
+
+    std::vector<LevelBuffer> buffers(pool.threadCount());
+    std::vector<int> frontier{source};
+    claim(source);
+    levels[source] = 0;
+    long long frontierArcs = graph.degree(source);
+    long long unexploredArcs = graph.arcCount() - frontierArcs;
+    size_t previousSize = 0;
+    bool bottomUp = false;
+
+    for (int depth = 0; !frontier.empty(); ++depth) {
+        // Only switch while the frontier grows (or shrinks), so the tail of a
+        // long-diameter search does not flip back and forth every level
+        bool growing = frontier.size() > previousSize;
+        if (!bottomUp && growing && frontierArcs > unexploredArcs / BFS_ALPHA) bottomUp = true;
+        else if (bottomUp && !growing && (long long)frontier.size() < n / BFS_BETA) bottomUp = false;
+        previousSize = frontier.size();
+
+        for (LevelBuffer& buffer : buffers) {
+            buffer.next.clear();
+            buffer.arcs = 0;
+        }
+
+        if (!bottomUp) {
+            // Top-down: each frontier node claims its unvisited neighbors
+            pool.parallelFor((int)frontier.size(), chunkGrain(pool, (int)frontier.size(), BFS_TOP_DOWN_GRAIN), [&](int thread, int begin, int end) {
+                LevelBuffer& out = buffers[thread];
+                for (int i = begin; i < end; ++i) {
+                    int u = frontier[i];
+                    for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+                        int v = graph.targets[arc];
+                        if (isVisited(v) || !claim(v)) continue;
+                        levels[v] = depth + 1;
+                        out.next.push_back(v);
+                        out.arcs += graph.degree(v);
+                        if (discoveredBy) discoveredBy[v] = thread;
+                    }
+                }
+            });
+        } else {
+            // Bottom-up: each unvisited node stops at the first parent it finds in the frontier
+            std::fill(inFrontier.begin(), inFrontier.end(), 0);
+            for (int u : frontier) inFrontier[u >> 6] |= 1ULL << (u & 63);
+
+            pool.parallelFor(n, chunkGrain(pool, n, BFS_BOTTOM_UP_GRAIN), [&](int thread, int begin, int end) {
+                LevelBuffer& out = buffers[thread];
+                for (int v = begin; v < end; ++v) {
+                    if (isVisited(v)) continue;
+                    for (int arc = reverse.arcBegin(v); arc < reverse.arcEnd(v); ++arc) {
+                        int u = reverse.targets[arc];
+                        if (!((inFrontier[u >> 6] >> (u & 63)) & 1)) continue;
+                        claim(v);
+                        levels[v] = depth + 1;
+                        out.next.push_back(v);
+                        out.arcs += graph.degree(v);
+                        if (discoveredBy) discoveredBy[v] = thread;
+                        break;
+                    }
+                }
+            });
+        }
+
+        frontier.clear();
+        frontierArcs = 0;
+        for (LevelBuffer& buffer : buffers) {
+            frontier.insert(frontier.end(), buffer.next.begin(), buffer.next.end());
+            frontierArcs += buffer.arcs;
+        }
+        unexploredArcs -= frontierArcs;
+        if (trace && !frontier.empty()) trace->bottomUp.append(bottomUp);
+    }
+    return level;
+}
+
+QVector<int> GraphKernels::dfsOrder(const CsrGraph& graph, int source)
+{
+    QVector<int> order;
+    std::vector<char> visited(graph.nodeCount, 0);
+    std::vector<std::pair<int, int>> stack; // (node, next arc to try)
+
+    visited[source] = 1;
+    order.append(source);
+    stack.push_back({source, graph.arcBegin(source)});
+    while (!stack.empty()) {
+        auto& [u, arc] = stack.back();
+        if (arc == graph.arcEnd(u)) {
+            stack.pop_back();
+            continue;
+        }
+        int v = graph.targets[arc++];
+        if (visited[v]) continue;
+        visited[v] = 1;
+        order.append(v);
+        stack.push_back({v, graph.arcBegin(v)});
+    }
+    return order;
+}
+
+GraphKernels::Components GraphKernels::stronglyConnectedComponents(const CsrGraph& graph)
+{
+    int n = graph.nodeCount;
+    Components result;
+    result.component.fill(-1, n);
+
+    std::vector<int> index(n, -1); // DFS discovery number
+    std::vector<int> low(n);       // Smallest index reachable through the DFS subtree
+    std::vector<char> onStack(n, 0);
+    std::vector<int> open;         // Nodes whose component is not finished yet
+    std::vector<std::pair<int, int>> calls; // (node, next arc to try), the would-be recursion
+    int discovered = 0;
+
+    auto enter = [&](int u) {
+        index[u] = low[u] = discovered++;
+        open.push_back(u);
+        onStack[u] = 1;
+        calls.push_back({u, graph.arcBegin(u)});
+    };
+
+    for (int root = 0; root < n; ++root) {
+        if (index[root] != -1) continue;
+        enter(root);
+        while (!calls.empty()) {
+            auto& [u, arc] = calls.back();
+            if (arc < graph.arcEnd(u)) {
+                int v = graph.targets[arc++];
+                if (index[v] == -1) enter(v);
+                else if (onStack[v]) low[u] = std::min(low[u], index[v]);
+                continue;
+            }
+
+            int finished = u;
+            calls.pop_back();
+            if (!calls.empty()) {
+                int parent = calls.back().first;
+                low[parent] = std::min(low[parent], low[finished]);
+            }
+            if (low[finished] != index[finished]) continue;
+
+            // 'finished' is the root of a component: everything above it on the stack
+            int member;
+            do {
+                member = open.back();
+                open.pop_back();
+                onStack[member] = 0;
+                result.component[member] = result.count;
+            } while (member != finished);
+            result.count++;
+        }
+    }
+    return result;
+}
+
+GraphKernels::Components GraphKernels::connectedComponents(const CsrGraph& graph)
+{
+    UnionFind sets(graph.nodeCount);
+    for (int u = 0; u < graph.nodeCount; ++u) {
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) sets.unite(u, graph.targets[arc]);
+    }
+
+    Components result;
+    result.component.fill(-1, graph.nodeCount);
+    std::vector<int> idOfRoot(graph.nodeCount, -1);
+    for (int u = 0; u < graph.nodeCount; ++u) {
+        int root = sets.find(u);
+        if (idOfRoot[root] == -1) idOfRoot[root] = result.count++;
+        result.component[u] = idOfRoot[root];
+    }
+    return result;
+}
+
+CsrGraph GraphKernels::condensation(const CsrGraph& graph, const Components& components)
+{
+    QVector<GraphEdge> edges;
+    for (int u = 0; u < graph.nodeCount; ++u) {
+        int from = components.component[u];
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int to = components.component[graph.targets[arc]];
+            if (from == to || (!graph.directed && to < from)) continue;
+            edges.append({from, to, graph.weights[arc]});
+        }
+    }
+
+    // Lightest arc first within each (from, to) pair, then keep only that one
+    std::sort(edges.begin(), edges.end(), [](const GraphEdge& a, const GraphEdge& b) {
+        if (a.from != b.from) return a.from < b.from;
+        if (a.to != b.to) return a.to < b.to;
+        return a.weight < b.weight;
+    });
+    auto last = std::unique(edges.begin(), edges.end(), [](const GraphEdge& a, const GraphEdge& b) {
+        return a.from == b.from && a.to == b.to;
+    });
+    edges.erase(last, edges.end());
+
+    CsrGraph condensed = CsrGraph::build(components.count, edges, graph.directed);
+    QVector<int> members(components.count, 0);
+    for (int u = 0; u < graph.nodeCount; ++u) {
+        int c = components.component[u];
+        condensed.xs[c] += graph.xs[u];
+        condensed.ys[c] += graph.ys[u];
+        members[c]++;
+    }
+    for (int c = 0; c < components.count; ++c) {
+        condensed.xs[c] /= members[c];
+        condensed.ys[c] /= members[c];
+    }
+    return condensed;
+}
+
+long long GraphKernels::suggestedDelta(const CsrGraph& graph)
+{
+    if (graph.arcCount() == 0) return 1;
+    long long total = 0;
+    for (int weight : graph.weights) total += weight;
+    return std::max(1LL, total / graph.arcCount());
+}
+
+QVector<long long> GraphKernels::deltaStepping(const CsrGraph& graph, int source, long long delta,
+                                               ThreadPool& pool, DeltaSteppingTrace* trace)
+{
+    const long long INF = std::numeric_limits<long long>::max();
+    int n = graph.nodeCount;
+    delta = std::max(1LL, delta);
+    if (trace) trace->phases.clear();
+
+    std::vector<BucketWorker> workers(pool.threadCount());
+
+    // Copy the arcs with each node's light arcs first, so phases and the heavy
+    // pass each scan only their own arcs: [offsets[u], lightEnd[u]) is light
+    std::vector<int> targets(graph.arcCount());
+    std::vector<int> weights(graph.arcCount());
+    std::vector<int> lightEnd(n);
+    pool.parallelFor(n, DELTA_SPLIT_GRAIN, [&](int thread, int begin, int end) {
+        int maxWeight = workers[thread].maxWeight;
+        for (int u = begin; u < end; ++u) {
+            int light = graph.arcBegin(u);
+            int heavy = graph.arcEnd(u);
+            for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+                int weight = graph.weights[arc];
+                int slot = weight <= delta ? light++ : --heavy;
+                targets[slot] = graph.targets[arc];
+                weights[slot] = weight;
+                maxWeight = std::max(maxWeight, weight);
+            }
+            lightEnd[u] = light;
+        }
+        workers[thread].maxWeight = maxWeight;
+    });
+
+    // A node is queued at most maxWeight / delta + 1 buckets past the one being emptied
+    int maxWeight = 0;
+    for (const BucketWorker& worker : workers) maxWeight = std::max(maxWeight, worker.maxWeight);
+    int bucketSlots = (int)(maxWeight / delta) + 2;
+    for (BucketWorker& worker : workers) worker.buckets.resize(bucketSlots);
+
+    std::vector<std::atomic<long long>> dist(n);
+    std::vector<std::atomic<long long>> relaxedAt(n); // Distance a node's light arcs were last relaxed from
+    for (int node = 0; node < n; ++node) {
+        dist[node].store(INF, std::memory_order_relaxed);
+        relaxedAt[node].store(INF, std::memory_order_relaxed);
+    }
+
+    // Lowers dist[v] to 'candidate' if smaller, queueing v in the matching bucket
+    auto relax = [&](BucketWorker& worker, int v, long long candidate) {
+        long long current = dist[v].load(std::memory_order_relaxed);
+        while (candidate < current) {
+            if (dist[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                worker.buckets[(candidate / delta) % bucketSlots].push_back(v);
+                return;
+            }
+        }
+    };
+
+    dist[source].store(0, std::memory_order_relaxed);
+    workers[0].buckets[0].push_back(source);
+
+    std::vector<int> frontier;
+    std::vector<int> settled;
+    std::vector<char> isSettled(n, 0);
+
+    for (long long bucket = 0;; ++bucket) {
+        // Skip to the next non-empty bucket; a full empty cycle means every node is final
+        int skipped = 0;
+        auto slotEmpty = [&](int slot) {
+            for (const BucketWorker& worker : workers) {
+                if (!worker.buckets[slot].empty()) return false;
+            }
+            return true;
+        };
+        while (skipped < bucketSlots && slotEmpty((bucket + skipped) % bucketSlots)) skipped++;
+        if (skipped == bucketSlots) break;
+        bucket += skipped;
+        int slot = bucket % bucketSlots;
+
+        settled.clear();
+        while (true) {
+            frontier.clear();
+            for (BucketWorker& worker : workers) {
+                frontier.insert(frontier.end(), worker.buckets[slot].begin(), worker.buckets[slot].end());
+                worker.buckets[slot].clear();
+                worker.relaxed.clear();
+            }
+            if (frontier.empty()) break;
+
+            // Light phase. Entries are stale when the node has since moved to a
+            // lower bucket or was already relaxed from the same distance.
+            pool.parallelFor((int)frontier.size(), chunkGrain(pool, (int)frontier.size(), DELTA_NODE_GRAIN),
+                             [&](int thread, int begin, int end) {
+                BucketWorker& worker = workers[thread];
+                for (int i = begin; i < end; ++i) {
+                    int u = frontier[i];
+                    long long d = dist[u].load(std::memory_order_relaxed);
+                    if (d / delta != bucket || relaxedAt[u].exchange(d, std::memory_order_relaxed) == d) continue;
+                    worker.relaxed.push_back(u);
+                    for (int arc = graph.arcBegin(u); arc < lightEnd[u]; ++arc) {
+                        relax(worker, targets[arc], d + weights[arc]);
+                    }
+                }
+            });
+
+            QVector<int> phaseNodes;
+            for (const BucketWorker& worker : workers) {
+                for (int u : worker.relaxed) {
+                    if (trace) phaseNodes.append(u);
+                    if (!isSettled[u]) {
+                        isSettled[u] = 1;
+                        settled.push_back(u);
+                    }
+                }
+            }
+            if (trace && !phaseNodes.isEmpty()) trace->phases.append({bucket, phaseNodes});
+        }
+
+        // Heavy arcs leave the bucket, so one pass from the final distances is enough
+        pool.parallelFor((int)settled.size(), chunkGrain(pool, (int)settled.size(), DELTA_NODE_GRAIN),
+                         [&](int thread, int begin, int end) {
+            BucketWorker& worker = workers[thread];
+            for (int i = begin; i < end; ++i) {
+                int u = settled[i];
+                long long d = dist[u].load(std::memory_order_relaxed);
+                for (int arc = lightEnd[u]; arc < graph.arcEnd(u); ++arc) {
+                    relax(worker, targets[arc], d + weights[arc]);
+                }
+            }
+        });
+    }
+
+    QVector<long long> result(n);
+    for (int node = 0; node < n; ++node) {
+        long long d = dist[node].load(std::memory_order_relaxed);
+        result[node] = d == INF ? UNREACHABLE : d;
+    }
+    return result;
+}
+
+QVector<long long> GraphKernels::dijkstra(const CsrGraph& graph, int source)
+{
+    QVector<long long> dist(graph.nodeCount, UNREACHABLE);
+    QVector<bool> settled(graph.nodeCount, false);
+
+    using Entry = std::pair<long long, int>; // (distance, node), smallest first
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+    dist[source] = 0;
+    pq.push({0, source});
+
+    const int* targets = graph.targets.constData();
+    const int* weights = graph.weights.constData();
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        if (settled[u]) continue;
+        settled[u] = true;
+
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = targets[arc];
+            long long candidate = d + weights[arc];
+            if (dist[v] == UNREACHABLE || candidate < dist[v]) {
+                dist[v] = candidate;
+                pq.push({candidate, v});
+            }
+        }
+    }
+    return dist;
+}
+
+double GraphKernels::heuristicScale(const CsrGraph& graph)
+{
+    double scale = std::numeric_limits<double>::infinity();
+    for (int u = 0; u < graph.nodeCount; ++u) {
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = graph.targets[arc];
+            double length = std::hypot(graph.xs[u] - graph.xs[v], graph.ys[u] - graph.ys[v]);
+            if (length == 0.0) return 0.0;
+            scale = std::min(scale, graph.weights[arc] / length);
+        }
+    }
+    // Shave off rounding error so the estimate stays below the true distance
+    return std::isinf(scale) ? 0.0 : scale * (1.0 - 1e-9);
+}
+
+GraphKernels::PathSearch GraphKernels::dijkstraPath(const CsrGraph& graph, int source, int target)
+{
+    return aStar(graph, source, target, 0.0); // A zero heuristic is plain Dijkstra
+}
+
+GraphKernels::PathSearch GraphKernels::aStar(const CsrGraph& graph, int source, int target, double heuristicScale)
+{
+    PathSearch result;
+    QVector<long long> dist(graph.nodeCount, UNREACHABLE);
+    QVector<bool> settled(graph.nodeCount, false);
+    DaryHeap<double> open(graph.nodeCount); // Key: distance so far + estimate to target
+
+    double tx = graph.xs[target];
+    double ty = graph.ys[target];
+    auto estimate = [&](int v) {
+        return heuristicScale == 0.0 ? 0.0 : heuristicScale * std::hypot(graph.xs[v] - tx, graph.ys[v] - ty);
+    };
+
+    dist[source] = 0;
+    open.push(source, estimate(source));
+
+    const int* targets = graph.targets.constData();
+    const int* weights = graph.weights.constData();
+    while (!open.isEmpty()) {
+        int u = open.pop();
+        settled[u] = true;
+        result.settled++;
+        if (u == target) {
+            result.distance = dist[u];
+            break;
+        }
+
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = targets[arc];
+            if (settled[v]) continue;
+            long long candidate = dist[u] + weights[arc];
+            if (dist[v] == UNREACHABLE || candidate < dist[v]) {
+                dist[v] = candidate;
+                open.pushOrDecrease(v, candidate + estimate(v));
+            }
+        }
+    }
+    return result;
+}
+
+GraphKernels::PathSearch GraphKernels::bidirectionalDijkstra(const CsrGraph& graph, const CsrGraph& reverse, int source, int target)
+{
+    PathSearch result;
+    const CsrGraph* sides[2] = {&graph, &reverse};
+    QVector<long long> dist[2] = {QVector<long long>(graph.nodeCount, UNREACHABLE), QVector<long long>(graph.nodeCount, UNREACHABLE)};
+    DaryHeap<long long> open[2] = {DaryHeap<long long>(graph.nodeCount), DaryHeap<long long>(graph.nodeCount)};
+
+    dist[0][source] = 0;
+    dist[1][target] = 0;
+    open[0].push(source, 0);
+    open[1].push(target, 0);
+    long long best = std::numeric_limits<long long>::max(); // Shortest source-target path seen so far
+
+    while (!open[0].isEmpty() && !open[1].isEmpty()) {
+        // No unsettled node can lie on a path shorter than both frontiers combined
+        if (open[0].topKey() + open[1].topKey() >= best) break;
+
+        int side = open[0].topKey() <= open[1].topKey() ? 0 : 1;
+        const CsrGraph& g = *sides[side];
+        int u = open[side].pop();
+        result.settled++;
+
+        for (int arc = g.arcBegin(u); arc < g.arcEnd(u); ++arc) {
+            int v = g.targets[arc];
+            long long candidate = dist[side][u] + g.weights[arc];
+            if (dist[side][v] == UNREACHABLE || candidate < dist[side][v]) {
+                dist[side][v] = candidate;
+                open[side].pushOrDecrease(v, candidate);
+            }
+            if (dist[1 - side][v] != UNREACHABLE) best = std::min(best, candidate + dist[1 - side][v]);
+        }
+    }
+
+    if (source == target) best = 0;
+    if (best != std::numeric_limits<long long>::max()) result.distance = best;
+    return result;
+}
+
+long long GraphKernels::primMstWeight(const CsrGraph& graph, int source)
+{
+    QVector<bool> inTree(graph.nodeCount, false);
+    QVector<int> lightest(graph.nodeCount, std::numeric_limits<int>::max()); // Lightest known edge into each node
+
+    using Entry = std::pair<int, int>; // (edge weight, node), lightest first
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+    pq.push({0, source});
+
+    const int* targets = graph.targets.constData();
+    const int* weights = graph.weights.constData();
+    long long total = 0;
+    while (!pq.empty()) {
+        auto [w, u] = pq.top();
+        pq.pop();
+        if (inTree[u]) continue;
+        inTree[u] = true;
+        total += w;
+
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int v = targets[arc];
+            if (!inTree[v] && weights[arc] < lightest[v]) {
+                lightest[v] = weights[arc];
+                pq.push({weights[arc], v});
+            }
+        }
+    }
+    return total;
+}
+
+QVector<int> GraphKernels::weightMatrix(const CsrGraph& graph)
+{
+    int n = graph.nodeCount;
+    QVector<int> dist((size_t)n * n, NO_PATH);
+    for (int u = 0; u < n; ++u) {
+        dist[(size_t)u * n + u] = 0;
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+            int& entry = dist[(size_t)u * n + graph.targets[arc]];
+            entry = std::min(entry, graph.weights[arc]);
+        }
+    }
+    return dist;
+}
+
+void GraphKernels::floydWarshallNaive(QVector<int>& dist, int n)
+{
+    int* d = dist.data();
+    for (int k = 0; k < n; ++k) {
+        for (int i = 0; i < n; ++i) {
+            int dik = d[(size_t)i * n + k];
+            for (int j = 0; j < n; ++j) {
+                d[(size_t)i * n + j] = std::min(d[(size_t)i * n + j], dik + d[(size_t)k * n + j]);
+            }
+        }
+    }
+}
+
+void GraphKernels::floydWarshallBlocked(QVector<int>& dist, int n, ThreadPool& pool, int tileSize,
+                                        QVector<FloydPhase>* trace)
+{
+    if (tileSize != 8 && tileSize != 16 && tileSize != 32 && tileSize != 64) tileSize = FLOYD_TILE;
+    if (trace) trace->clear();
+    if (n == 0) return;
+
+    // Pad to whole tiles with unreachable nodes, which never shorten a path
+    int stride = (n + tileSize - 1) / tileSize * tileSize;
+    std::vector<int> padded((size_t)stride * stride, NO_PATH);
+    for (int i = 0; i < n; ++i) {
+        std::copy(dist.constBegin() + (size_t)i * n, dist.constBegin() + (size_t)(i + 1) * n, padded.begin() + (size_t)i * stride);
+    }
+    for (int i = n; i < stride; ++i) padded[(size_t)i * stride + i] = 0;
+
+    switch (tileSize) {
+    case 8: floydWarshallTiles<8>(padded.data(), stride, n, pool, trace); break;
+    case 16: floydWarshallTiles<16>(padded.data(), stride, n, pool, trace); break;
+    case 32: floydWarshallTiles<32>(padded.data(), stride, n, pool, trace); break;
+    default: floydWarshallTiles<64>(padded.data(), stride, n, pool, trace); break;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        std::copy(padded.begin() + (size_t)i * stride, padded.begin() + (size_t)i * stride + n, dist.begin() + (size_t)i * n);
+    }
+}
+
+GraphKernels::SpanningForest GraphKernels::kruskal(const CsrGraph& graph, ThreadPool& pool)
+{
+    std::vector<WeightedEdge> edges = collectEdges(graph, pool);
+    parallelSort(edges, pool);
+
+    SpanningForest forest;
+    UnionFind sets(graph.nodeCount);
+    for (const WeightedEdge& edge : edges) {
+        if (!sets.unite(edge.from, edge.to)) continue;
+        forest.edges.append(edge.id);
+        forest.weight += edge.weight;
+        if (sets.setCount() == 1) break;
+    }
+    forest.components = sets.setCount();
+    return forest;
+}
+
+GraphKernels::SpanningForest GraphKernels::boruvka(const CsrGraph& graph, ThreadPool& pool, QVector<int>* roundEnds)
+{
+    const quint64 NO_EDGE = std::numeric_limits<quint64>::max();
+    int n = graph.nodeCount;
+    std::vector<WeightedEdge> edges = collectEdges(graph, pool);
+    if (roundEnds) roundEnds->clear();
+
+    SpanningForest forest;
+    UnionFind sets(n);
+    std::vector<int> component(n); // Root of each node's set as of the current round
+    std::iota(component.begin(), component.end(), 0);
+    std::vector<int> roots = component;
+
+    // Per component, the lightest outgoing edge as (weight << 32 | edge id), so
+    // one atomic minimum compares weight first and breaks ties consistently.
+    // 'edges' comes in whatever order the threads collected it; ids do not.
+    std::vector<std::atomic<quint64>> lightest(n);
+    std::vector<int> indexOfId(graph.edgeCount, -1);
+    pool.parallelFor((int)edges.size(), MST_EDGE_GRAIN, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) indexOfId[edges[i].id] = i;
+    });
+    std::vector<int> live(edges.size()); // Edges between two different components
+    std::iota(live.begin(), live.end(), 0);
+    std::vector<IndexBuffer> buffers(pool.threadCount());
+
+    while (!live.empty()) {
+        pool.parallelFor((int)roots.size(), MST_NODE_GRAIN, [&](int, int begin, int end) {
+            for (int i = begin; i < end; ++i) lightest[roots[i]].store(NO_EDGE, std::memory_order_relaxed);
+        });
+
+        auto offer = [&](int root, quint64 key) {
+            quint64 current = lightest[root].load(std::memory_order_relaxed);
+            while (key < current && !lightest[root].compare_exchange_weak(current, key, std::memory_order_relaxed)) {}
+        };
+        pool.parallelFor((int)live.size(), MST_EDGE_GRAIN, [&](int, int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                const WeightedEdge& edge = edges[live[i]];
+                quint64 key = (quint64)(quint32)edge.weight << 32 | (quint32)edge.id;
+                offer(component[edge.from], key);
+                offer(component[edge.to], key);
+            }
+        });
+
+        // Two components that picked the same edge join only once
+        int accepted = forest.edges.size();
+        for (int root : roots) {
+            quint64 key = lightest[root].load(std::memory_order_relaxed);
+            if (key == NO_EDGE) continue;
+            const WeightedEdge& edge = edges[indexOfId[(quint32)key]];
+            if (sets.unite(edge.from, edge.to)) {
+                forest.edges.append(edge.id);
+                forest.weight += edge.weight;
+            }
+        }
+        if (forest.edges.size() == accepted) break;
+        if (roundEnds) roundEnds->append(forest.edges.size());
+
+        pool.parallelFor(n, MST_NODE_GRAIN, [&](int, int begin, int end) {
+            for (int v = begin; v < end; ++v) component[v] = sets.findRoot(component[v]);
+        });
+        roots.erase(std::remove_if(roots.begin(), roots.end(), [&](int root) { return component[root] != root; }), roots.end());
+
+        for (IndexBuffer& buffer : buffers) buffer.items.clear();
+        pool.parallelFor((int)live.size(), MST_EDGE_GRAIN, [&](int thread, int begin, int end) {
+            std::vector<int>& out = buffers[thread].items;
+            for (int i = begin; i < end; ++i) {
+                const WeightedEdge& edge = edges[live[i]];
+                if (component[edge.from] != component[edge.to]) out.push_back(live[i]);
+            }
+        });
+        live.clear();
+        for (const IndexBuffer& buffer : buffers) live.insert(live.end(), buffer.items.begin(), buffer.items.end());
+    }
+
+    forest.components = sets.setCount();
+    return forest;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "csrgraph.h"
+#include <QPair>
+#include <QVector>
+#include <limits>
+
+class ThreadPool;
+
+// Native graph algorithms over CsrGraph: no history, flat per-node arrays,
+// sized for graphs with millions of nodes.
+namespace GraphKernels
+{
+const int UNREACHABLE = -1;
+
+// Result of a point-to-point search
+struct PathSearch {
+    long long distance = UNREACHABLE;
+    int settled = 0; // Nodes removed from the queue, the size of the search space
+};
+
+// Hop count from 'source' for every node (UNREACHABLE if not reached)
+QVector<int> bfsLevels(const CsrGraph& graph, int source);
+
+// What each thread did during directionOptimizingBfs(), for visualization
+struct BfsTrace {
+    QVector<int> discoveredBy; // Thread that reached each node; -1 if unreached
+    QVector<bool> bottomUp;    // Per level: true if it was found by a bottom-up sweep
+};
+
+// Parallel BFS that switches per level between top-down (frontier nodes claim
+// unvisited neighbors through an atomic bitmap) and bottom-up (every unvisited
+// node looks for a parent in the frontier) when the frontier gets large
+// (Beamer et al.). 'reverse' is graph.reversed(), or the graph itself if undirected.
+// Returns the same levels as bfsLevels().
+QVector<int> directionOptimizingBfs(const CsrGraph& graph, const CsrGraph& reverse, int source,
+                                    ThreadPool& pool, BfsTrace* trace = nullptr);
+
+// Nodes reachable from 'source' in depth-first preorder, taking arcs in CSR
+// order like a recursive DFS would. Uses an explicit stack, so chains of
+// millions of nodes cannot overflow the call stack.
+QVector<int> dfsOrder(const CsrGraph& graph, int source);
+
+// A partition of the nodes: component[u] is in [0, count)
+struct Components {
+    QVector<int> component;
+    int count = 0;
+};
+
+// Tarjan's algorithm on an explicit stack. Components are numbered in the order
+// they complete, which is a reverse topological order of the condensation.
+// On an undirected graph these are the connected components.
+Components stronglyConnectedComponents(const CsrGraph& graph);
+
+// Union-find over every arc, ignoring direction (weakly connected components
+// of a directed graph). Numbered in order of each component's smallest node.
+Components connectedComponents(const CsrGraph& graph);
+
+// One node per component, placed at the centroid of its members, and one arc
+// per pair of components joined by an arc, keeping the lightest weight. Edge
+// directions follow the graph; the condensation of SCCs is a DAG.
+CsrGraph condensation(const CsrGraph& graph, const Components& components);
+
+// Shortest weighted distance from 'source' for every node (UNREACHABLE if not reached)
+QVector<long long> dijkstra(const CsrGraph& graph, int source);
+
+// Buckets emptied by deltaStepping(), for visualization
+struct DeltaSteppingTrace {
+    struct Phase {
+        long long bucket;
+        QVector<int> nodes; // Nodes whose light arcs were relaxed in this phase
+    };
+    QVector<Phase> phases;
+};
+
+// Starting point for deltaStepping(): the mean arc weight, at least 1
+long long suggestedDelta(const CsrGraph& graph);
+
+// Parallel single-source shortest paths (Meyer & Sanders). Nodes wait in
+// buckets of width 'delta' by tentative distance. The lowest bucket is emptied
+// in parallel phases that relax its light arcs (weight <= delta), which may
+// refill it; then the heavy arcs of everything it settled are relaxed once.
+// delta = 1 behaves like Dial's algorithm, a huge delta like Bellman-Ford.
+// Returns the same distances as dijkstra().
+QVector<long long> deltaStepping(const CsrGraph& graph, int source, long long delta,
+                                 ThreadPool& pool, DeltaSteppingTrace* trace = nullptr);
+
+// Largest s for which s * straight-line distance never overestimates a path's
+// weight: the smallest weight / length ratio over all arcs (0 if an arc has no length)
+double heuristicScale(const CsrGraph& graph);
+
+// Point-to-point searches on an indexed 4-ary heap; each stops once 'target' is settled
+PathSearch dijkstraPath(const CsrGraph& graph, int source, int target);
+PathSearch aStar(const CsrGraph& graph, int source, int target, double heuristicScale);
+
+// Searches forward from 'source' on 'graph' and backward from 'target' on
+// 'reverse' (graph.reversed()), stopping when the two frontiers prove the best meeting point
+PathSearch bidirectionalDijkstra(const CsrGraph& graph, const CsrGraph& reverse, int source, int target);
+
+// --- All-pairs shortest paths ---
+// Distance matrices are row-major V x V. NO_PATH is half of INT_MAX, so the
+// sum of two entries never overflows.
+const int NO_PATH = std::numeric_limits<int>::max() / 2;
+const int FLOYD_TILE = 64; // Tile edge of floydWarshallBlocked(); one tile is 16 KB
+
+// Lightest direct arc between each pair, 0 on the diagonal, NO_PATH elsewhere
+QVector<int> weightMatrix(const CsrGraph& graph);
+
+// Textbook Floyd-Warshall: for each pivot k, every (i, j) pair, in place
+void floydWarshallNaive(QVector<int>& dist, int n);
+
+// One phase of floydWarshallBlocked(), for visualization
+struct FloydPhase {
+    enum Kind { DIAGONAL, CROSS, REMAINDER };
+    int pivotBlock; // Pivots [pivotBlock * tileSize, (pivotBlock + 1) * tileSize)
+    Kind kind;
+    QVector<QPair<int, int>> tiles; // (tile row, tile column) updated in this phase
+    QVector<int> dist;              // The matrix after the phase
+};
+
+// Floyd-Warshall in cache-sized tiles (Venkataraman et al.). For each block of
+// pivots: the diagonal tile, then the tiles in its row and column, then all
+// the rest; the tiles of one phase are independent and run in parallel. The
+// min-plus row update has a fixed trip count, so it compiles to SIMD min/add.
+// tileSize is 8, 16, 32 or 64 (anything else uses FLOYD_TILE).
+void floydWarshallBlocked(QVector<int>& dist, int n, ThreadPool& pool, int tileSize = FLOYD_TILE,
+                          QVector<FloydPhase>* trace = nullptr);
+
+// Total weight of the minimum spanning tree of the component containing 'source'
+long long primMstWeight(const CsrGraph& graph, int source);
+
+// Minimum spanning forest over every component (arc directions are ignored)
+struct SpanningForest {
+    QVector<int> edges;   // Edge ids in the order they were accepted
+    long long weight = 0; // Exact sum of the accepted edges' weights
+    int components = 0;   // Trees in the forest, 1 if the graph is connected
+};
+
+// Kruskal: edges sorted by weight in parallel runs that are then merged,
+// accepted in order unless a union-find says they close a cycle
+SpanningForest kruskal(const CsrGraph& graph, ThreadPool& pool);
+
+// Boruvka: every round, each component picks its lightest outgoing edge in
+// parallel (ties broken by edge id, so no cycles and the same forest on every
+// run whatever the thread timing), the picks are joined and edges inside a
+// component dropped. At most log2(V) rounds. If 'roundEnds' is set it
+// receives, per round, the number of forest edges accepted so far.
+SpanningForest boruvka(const CsrGraph& graph, ThreadPool& pool, QVector<int>* roundEnds = nullptr);
+}
@@ -0,0 +1,432 @@
+#include "graphloader.h"
+#include "graphgenerators.h"
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <QtMath>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+const qint64 MIN_CHUNK_BYTES = 1 << 20; // Smaller files are parsed on one thread
+const double LAYOUT_MARGIN = 0.95;      // Fraction of the layout box the nodes may cover
+
+namespace
+{
+// Hand-rolled integer tokenizer over a [p, end) byte range; never allocates
+struct Tokenizer {
+    const char* p;
+    const char* end;
+
+    void skipBlanks()
+    {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    }
+
+    bool atLineEnd()
+    {
+        skipBlanks();
+        return p >= end || *p == '\n';
+    }
+
+    void skipLine()
+    {
+        const char* newline = (const char*)std::memchr(p, '\n', end - p);
+        p = newline ? newline + 1 : end;
+    }
+
+    void skipWord()
+    {
+        skipBlanks();
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') ++p;
+    }
+
+    bool readInt(long long& value)
+    {
+        skipBlanks();
+        bool negative = p < end && *p == '-';
+        if (negative) ++p;
+        if (p >= end || (unsigned)(*p - '0') > 9) return false;
+
+        long long result = 0;
+        while (p < end && (unsigned)(*p - '0') <= 9) {
+            result = result * 10 + (*p++ - '0');
+            if (result > INT_MAX) return false;
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    // An edge weight: a non-negative integer ending at a blank or the line
+    // end, so "-3" and "0.5" are malformed rather than read as -3 and 0
+    bool readWeight(long long& value)
+    {
+        if (!readInt(value) || value < 0) return false;
+        return p >= end || *p == ' ' || *p == '\t' || *p == '\r' || *p == '\n';
+    }
+};
+
+// One line-aligned slice of the file and what its thread parsed out of it
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    QVector<GraphEdge> edges;
+    int maxNode = -1;
+    const char* errorAt = nullptr; // Start of the first malformed line
+
+    long long headerNodes = -1; // DIMACS "p" line
+    int firstNode = 0;          // METIS: node id of the chunk's first line
+    int lineCount = 0;          // METIS: node lines in the chunk
+};
+
+QVector<Chunk> splitChunks(const char* data, qint64 size)
+{
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    int count = (int)std::clamp<qint64>(size / MIN_CHUNK_BYTES, 1, threads);
+
+    QVector<Chunk> chunks(count);
+    const char* end = data + size;
+    const char* start = data;
+    for (int i = 0; i < count; ++i) {
+        const char* stop = (i == count - 1) ? end : data + size * (i + 1) / count;
+        if (stop < start) stop = start;
+        if (stop < end) {
+            const char* newline = (const char*)std::memchr(stop, '\n', end - stop);
+            stop = newline ? newline + 1 : end;
+        }
+        chunks[i].begin = start;
+        chunks[i].end = stop;
+        start = stop;
+    }
+    return chunks;
+}
+
+// Runs 'parse' on every chunk, one thread each
+template<typename Parse>
+void forEachChunk(QVector<Chunk>& chunks, Parse parse)
+{
+    std::vector<std::thread> workers;
+    for (int i = 1; i < chunks.size(); ++i) {
+        workers.emplace_back([&chunks, &parse, i] { parse(chunks[i]); });
+    }
+    parse(chunks[0]);
+    for (std::thread& worker : workers) worker.join();
+}
+
+void addEdge(Chunk& chunk, long long from, long long to, long long weight)
+{
+    chunk.edges.append({(int)from, (int)to, (int)weight});
+    chunk.maxNode = std::max(chunk.maxNode, (int)std::max(from, to));
+}
+
+// --- Per-format chunk parsers ---
+
+void parseEdgeList(Chunk& chunk)
+{
+    Tokenizer t{chunk.begin, chunk.end};
+    while (t.p < t.end) {
+        t.skipBlanks();
+        if (t.p >= t.end) break;
+        if (*t.p == '\n') { ++t.p; continue; }
+        if (*t.p == '#' || *t.p == '%') { t.skipLine(); continue; }
+
+        const char* line = t.p;
+        long long u, v;
+        long long weight = 1;
+        if (!t.readInt(u) || !t.readInt(v) || u < 0 || v < 0
+            || (!t.atLineEnd() && !t.readWeight(weight))) {
+            chunk.errorAt = line;
+            return;
+        }
+        addEdge(chunk, u, v, weight);
+        t.skipLine(); // Extra columns (timestamps etc.) are ignored
+    }
+}
+
+void parseDimacs(Chunk& chunk)
+{
+    Tokenizer t{chunk.begin, chunk.end};
+    while (t.p < t.end) {
+        t.skipBlanks();
+        if (t.p >= t.end) break;
+        const char* line = t.p;
+        char kind = *t.p;
+
+        if (kind == '\n') { ++t.p; continue; }
+        if (kind == 'c') { t.skipLine(); continue; }
+
+        ++t.p;
+        if (kind == 'p') {
+            long long arcs;
+            t.skipWord(); // Problem type, "sp"
+            if (!t.readInt(chunk.headerNodes) || !t.readInt(arcs)) {
+                chunk.errorAt = line;
+                return;
+            }
+        } else if (kind == 'a') {
+            long long u, v, weight;
+            if (!t.readInt(u) || !t.readInt(v) || !t.readWeight(weight) || u < 1 || v < 1) {
+                chunk.errorAt = line;
+                return;
+            }
+            addEdge(chunk, u - 1, v - 1, weight);
+        } else {
+            chunk.errorAt = line;
+            return;
+        }
+        t.skipLine();
+    }
+}
+
+struct MetisHeader {
+    long long nodeCount = 0;
+    bool vertexSizes = false;
+    bool edgeWeights = false;
+    long long vertexWeights = 0; // Numbers to skip at the start of each line
+};
+
+// Node lines are every line except '%' comments, empty lines included
+int countMetisLines(const char* begin, const char* end)
+{
+    int count = 0;
+    const char* p = begin;
+    while (p < end) {
+        const char* newline = (const char*)std::memchr(p, '\n', end - p);
+        if (*p != '%') count++;
+        p = newline ? newline + 1 : end;
+    }
+    return count;
+}
+
+void parseMetis(Chunk& chunk, const MetisHeader& header)
+{
+    Tokenizer t{chunk.begin, chunk.end};
+    int u = chunk.firstNode;
+    while (t.p < t.end) {
+        if (*t.p == '%') { t.skipLine(); continue; }
+
+        const char* line = t.p;
+        if (u >= header.nodeCount) {
+            chunk.errorAt = line;
+            return;
+        }
+
+        long long skipped;
+        int leading = (header.vertexSizes ? 1 : 0) + (int)header.vertexWeights;
+        for (int i = 0; i < leading; ++i) {
+            if (!t.readInt(skipped)) {
+                chunk.errorAt = line;
+                return;
+            }
+        }
+
+        while (!t.atLineEnd()) {
+            long long v;
+            long long weight = 1;
+            if (!t.readInt(v) || v < 1 || v > header.nodeCount
+                || (header.edgeWeights && !t.readWeight(weight))) {
+                chunk.errorAt = line;
+                return;
+            }
+            // Each undirected edge is listed by both endpoints; keep one copy
+            if (v - 1 > u) addEdge(chunk, u, v - 1, weight);
+        }
+        t.skipLine();
+        u++;
+    }
+}
+
+bool readMetisHeader(Tokenizer& t, MetisHeader& header)
+{
+    while (t.p < t.end && *t.p == '%') t.skipLine();
+
+    long long edges;
+    long long format = 0;
+    if (!t.readInt(header.nodeCount) || !t.readInt(edges) || header.nodeCount < 0) return false;
+    if (!t.atLineEnd()) {
+        if (!t.readInt(format)) return false;
+        header.vertexSizes = (format / 100) % 10 == 1;
+        header.vertexWeights = (format / 10) % 10 == 1 ? 1 : 0;
+        header.edgeWeights = format % 10 == 1;
+        if (header.vertexWeights && !t.atLineEnd() && !t.readInt(header.vertexWeights)) return false;
+    }
+    t.skipLine();
+    return true;
+}
+
+QString lineError(const char* data, const char* at, GraphLoader::Format format)
+{
+    long long line = 1 + std::count(data, at, '\n');
+    QString name = format == GraphLoader::Format::Dimacs ? "DIMACS"
+                   : format == GraphLoader::Format::Metis ? "METIS" : "edge list";
+    return "Line " + QString::number(line) + ": malformed " + name + " entry";
+}
+
+// Sunflower spiral: even density, deterministic, O(V)
+void layoutSpiral(CsrGraph& graph)
+{
+    const double goldenAngle = M_PI * (3.0 - std::sqrt(5.0));
+    double halfWidth = GraphGenerators::LAYOUT_WIDTH / 2.0;
+    double halfHeight = GraphGenerators::LAYOUT_HEIGHT / 2.0;
+    for (int u = 0; u < graph.nodeCount; ++u) {
+        double r = LAYOUT_MARGIN * std::sqrt((u + 0.5) / graph.nodeCount);
+        double theta = u * goldenAngle;
+        graph.xs[u] = halfWidth + r * halfWidth * std::cos(theta);
+        graph.ys[u] = halfHeight + r * halfHeight * std::sin(theta);
+    }
+}
+
+// Reads "v id x y" lines from a DIMACS .co file and fits them to the layout box
+bool loadDimacsCoordinates(const QString& path, CsrGraph& graph)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly)) return false;
+    QByteArray contents = file.readAll();
+
+    QVector<bool> placed(graph.nodeCount, false);
+    Tokenizer t{contents.constData(), contents.constData() + contents.size()};
+    while (t.p < t.end) {
+        t.skipBlanks();
+        if (t.p < t.end && *t.p == 'v') {
+            ++t.p;
+            long long id, x, y;
+            if (!t.readInt(id) || !t.readInt(x) || !t.readInt(y)) return false;
+            if (id < 1 || id > graph.nodeCount) return false;
+            graph.xs[id - 1] = x;
+            graph.ys[id - 1] = -y; // Latitude grows northwards, screen y downwards
+            placed[id - 1] = true;
+        }
+        t.skipLine();
+    }
+    if (std::count(placed.begin(), placed.end(), false) > 0 || graph.nodeCount == 0) return false;
+
+    auto [minX, maxX] = std::minmax_element(graph.xs.begin(), graph.xs.end());
+    auto [minY, maxY] = std::minmax_element(graph.ys.begin(), graph.ys.end());
+    double spanX = std::max(1.0, *maxX - *minX);
+    double spanY = std::max(1.0, *maxY - *minY);
+    double scale = LAYOUT_MARGIN * std::min(GraphGenerators::LAYOUT_WIDTH / spanX, GraphGenerators::LAYOUT_HEIGHT / spanY);
+    double offsetX = (GraphGenerators::LAYOUT_WIDTH - spanX * scale) / 2.0 - *minX * scale;
+    double offsetY = (GraphGenerators::LAYOUT_HEIGHT - spanY * scale) / 2.0 - *minY * scale;
+    for (int u = 0; u < graph.nodeCount; ++u) {
+        graph.xs[u] = graph.xs[u] * scale + offsetX;
+        graph.ys[u] = graph.ys[u] * scale + offsetY;
+    }
+    return true;
+}
+}
+
+GraphLoader::Format GraphLoader::detectFormat(const QString& path)
+{
+    QString suffix = QFileInfo(path).suffix().toLower();
+    if (suffix == "gr") return Format::Dimacs;
+    if (suffix == "graph" || suffix == "metis") return Format::Metis;
+    return Format::EdgeList;
+}
+
+bool GraphLoader::load(const QString& path, CsrGraph& graph, QString* error)
+{
+    return load(path, detectFormat(path), graph, error);
+}
+
+bool GraphLoader::load(const QString& path, Format format, CsrGraph& graph, QString* error)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly)) {
+        if (error) *error = "Cannot open " + path + ": " + file.errorString();
+        return false;
+    }
+
+    // Map the file instead of copying it; empty files cannot be mapped
+    qint64 size = file.size();
+    uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    QByteArray contents;
+    const char* data;
+    if (mapped) {
+        data = (const char*)mapped;
+    } else {
+        contents = file.readAll();
+        data = contents.constData();
+        size = contents.size();
+    }
+
+    bool ok = parse(data, size, format, graph, error);
+    if (mapped) file.unmap(mapped);
+
+    if (ok && format == Format::Dimacs) {
+        QFileInfo info(path);
+        QString coordinates = info.path() + "/" + info.completeBaseName() + ".co";
+        if (QFile::exists(coordinates) && !loadDimacsCoordinates(coordinates, graph)) layoutSpiral(graph);
+    }
+    return ok;
+}
+
+bool GraphLoader::parse(const char* data, qint64 size, Format format, CsrGraph& graph, QString* error)
+{
+    const char* end = data + size;
+    MetisHeader header;
+    const char* body = data;
+
+    if (format == Format::Metis) {
+        Tokenizer t{data, end};
+        if (!readMetisHeader(t, header)) {
+            if (error) *error = lineError(data, t.p, format);
+            return false;
+        }
+        body = t.p;
+    }
+
+    QVector<Chunk> chunks = splitChunks(body, end - body);
+
+    // 1. Tokenize every chunk in parallel
+    if (format == Format::EdgeList) {
+        forEachChunk(chunks, parseEdgeList);
+    } else if (format == Format::Dimacs) {
+        forEachChunk(chunks, parseDimacs);
+    } else {
+        // A METIS line's node id is its line number, so count lines per chunk first
+        forEachChunk(chunks, [](Chunk& chunk) { chunk.lineCount = countMetisLines(chunk.begin, chunk.end); });
+        for (int i = 1; i < chunks.size(); ++i) chunks[i].firstNode = chunks[i - 1].firstNode + chunks[i - 1].lineCount;
+        forEachChunk(chunks, [&header](Chunk& chunk) { parseMetis(chunk, header); });
+    }
+
+    // 2. Check the results in file order, so the first error reported is the earliest
+    long long nodeCount = 0;
+    long long edgeCount = 0;
+    for (const Chunk& chunk : chunks) {
+        if (chunk.errorAt) {
+            if (error) *error = lineError(data, chunk.errorAt, format);
+            return false;
+        }
+        nodeCount = std::max(nodeCount, (long long)chunk.maxNode + 1);
+        edgeCount += chunk.edges.size();
+    }
+
+    if (format == Format::Dimacs) {
+        long long declared = -1;
+        for (const Chunk& chunk : chunks) declared = std::max(declared, chunk.headerNodes);
+        if (declared < 0 || nodeCount > declared) {
+            if (error) *error = declared < 0 ? QString("Missing DIMACS problem line") : QString("DIMACS arc endpoint exceeds node count");
+            return false;
+        }
+        nodeCount = declared;
+    } else if (format == Format::Metis) {
+        nodeCount = header.nodeCount;
+    }
+
+    if (nodeCount > INT_MAX || edgeCount > INT_MAX / 2) {
+        if (error) *error = "Graph too large";
+        return false;
+    }
+
+    // 3. Pack into CSR, each chunk scattering its own edges
+    QVector<QVector<GraphEdge>> parts;
+    parts.reserve(chunks.size());
+    for (Chunk& chunk : chunks) parts.append(std::move(chunk.edges));
+
+    graph = CsrGraph::buildParallel((int)nodeCount, parts, format == Format::Dimacs);
+    layoutSpiral(graph);
+    return true;
+}
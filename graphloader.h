@@ -0,0 +1,33 @@
+#pragma once
+
+#include "csrgraph.h"
+#include <QString>
+
+// Loads graph files straight into CsrGraph. The file is memory-mapped, split
+// into line-aligned chunks and each chunk is tokenized on its own thread, so
+// large files parse at close to disk speed.
+//
+// Supported formats:
+//  - EdgeList: "u v [weight]" per line, 0-based ids, '#' or '%' comments; undirected
+//  - Dimacs:   9th DIMACS challenge .gr ("p sp n m", "a u v w"), 1-based; directed.
+//              A matching .co file next to it ("v id x y") supplies node positions.
+//  - Metis:    header "n m [fmt [ncon]]", then line i lists the neighbors of node i
+//              (1-based), with weights after each neighbor when fmt ends in 1; undirected
+//
+// Weights must be non-negative integers, as every kernel assumes; a negative or
+// fractional weight makes its line malformed. Nodes without coordinates are
+// laid out on a sunflower spiral.
+namespace GraphLoader
+{
+enum class Format { EdgeList, Dimacs, Metis };
+
+// By suffix: .gr -> Dimacs, .graph / .metis -> Metis, anything else -> EdgeList
+Format detectFormat(const QString& path);
+
+// Return false and fill 'error' (if given) when the file is missing or malformed
+bool load(const QString& path, CsrGraph& graph, QString* error = nullptr);
+bool load(const QString& path, Format format, CsrGraph& graph, QString* error = nullptr);
+
+// Parses an in-memory buffer; load() calls this on the mapped file
+bool parse(const char* data, qint64 size, Format format, CsrGraph& graph, QString* error = nullptr);
+}
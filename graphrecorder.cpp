@@ -0,0 +1,155 @@
+#include "graphrecorder.h"
+#include "threadpool.h"
+
+const QColor PATH_EDGE_COLOR = QColor(255, 165, 0);
+const int TOPOLOGY_GRAIN = 4096; // Nodes per chunk when building a topology
+
+QSharedPointer<const GraphTopology> buildTopology(const CsrGraph& graph, const QStringList& labels)
+{
+    GraphTopology* topology = new GraphTopology;
+    topology->nodes.resize(graph.nodeCount);
+    topology->edges.resize(graph.edgeCount);
+    bool named = labels.size() == graph.nodeCount;
+    bool labeled = (long long)graph.nodeCount + graph.edgeCount <= MAX_LABELED_ELEMENTS;
+
+    // Each node fills its own entry and the edges it is the first end of
+    NodeState* nodes = topology->nodes.data();
+    EdgeState* edges = topology->edges.data();
+    ThreadPool::global().parallelFor(graph.nodeCount, TOPOLOGY_GRAIN, [&](int, int begin, int end) {
+        for (int u = begin; u < end; ++u) {
+            NodeState& ns = nodes[u];
+            ns.id = u;
+            ns.position = graph.position(u);
+            if (named) ns.label = labels[u];
+            else if (labeled) ns.label = QString::number(u);
+
+            for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc) {
+                int v = graph.targets[arc];
+                if (u <= v || graph.directed) { // Self-loops too: both their arcs sit at u
+                    EdgeState& es = edges[graph.edgeIds[arc]];
+                    es.fromId = u;
+                    es.toId = v;
+                    if (labeled) es.weightLabel = QString::number(graph.weights[arc]);
+                }
+            }
+        }
+    });
+    return QSharedPointer<const GraphTopology>(topology);
+}
+
+// --- GraphRecorder ---
+
+GraphRecorder::GraphRecorder(QSharedPointer<const GraphTopology> topology)
+    : m_topology(topology),
+    m_changes(new QVector<GraphChange>)
+{
+    m_nodeColors.reserve(topology->nodes.size());
+    for (const NodeState& ns : topology->nodes) m_nodeColors.append(ns.color);
+    m_edgeColors.reserve(topology->edges.size());
+    for (const EdgeState& es : topology->edges) m_edgeColors.append(es.color);
+}
+
+void GraphRecorder::setNodeColor(int node, QColor color)
+{
+    if (m_nodeColors[node] == color) return;
+    m_changes->append({node, false, -1, color, m_nodeColors[node]});
+    m_nodeColors[node] = color;
+}
+
+void GraphRecorder::setEdgeColor(int edge, QColor color)
+{
+    if (m_edgeColors[edge] == color) return;
+    m_changes->append({edge, true, -1, color, m_edgeColors[edge]});
+    m_edgeColors[edge] = color;
+}
+
+void GraphRecorder::setEdgeShape(int edge, int from, int to, const QString& weightLabel, QColor color)
+{
+    EdgeEdit edit = {from, to, weightLabel, -1, -1, QString()};
+    auto latest = m_shapes.constFind(edge);
+    if (latest != m_shapes.constEnd()) {
+        const EdgeEdit& current = m_edits->at(*latest);
+        edit.previousFrom = current.fromId;
+        edit.previousTo = current.toId;
+        edit.previousLabel = current.weightLabel;
+    } else if (edge < m_topology->edges.size()) {
+        const EdgeState& es = m_topology->edges[edge];
+        edit.previousFrom = es.fromId;
+        edit.previousTo = es.toId;
+        edit.previousLabel = es.weightLabel;
+    }
+
+    if (!m_edits) m_edits.reset(new QVector<EdgeEdit>);
+    while (m_edgeColors.size() <= edge) m_edgeColors.append(EdgeState().color);
+    m_shapes.insert(edge, m_edits->size());
+    m_changes->append({edge, true, (int)m_edits->size(), color, m_edgeColors[edge]});
+    m_edits->append(edit);
+    m_edgeColors[edge] = color;
+}
+
+void GraphRecorder::record(QList<QVariant>& history, const QString& message)
+{
+    GraphStep step;
+    step.statusMessage = message;
+    step.topology = m_topology;
+    step.changes = m_changes;
+    step.changeCount = m_changes->size();
+    step.edits = m_edits;
+    history.append(QVariant::fromValue(step));
+}
+
+// --- TraversalPainter ---
+
+TraversalPainter::TraversalPainter(const CsrGraph& graph, GraphRecorder& recorder)
+    : m_graph(graph),
+    m_recorder(recorder),
+    m_visited(graph.nodeCount, UNVISITED),
+    m_frontier(graph.nodeCount, false),
+    m_pathEdges(graph.edgeCount, false),
+    m_current(-1)
+{}
+
+void TraversalPainter::visit(int node, bool backward)
+{
+    if (m_visited[node] != UNVISITED) return;
+    m_visited[node] = backward ? BACKWARD : FORWARD;
+    repaintNode(node);
+
+    // Edges to already visited neighbors now join two visited nodes
+    for (int arc = m_graph.arcBegin(node); arc < m_graph.arcEnd(node); ++arc) {
+        int edge = m_graph.edgeIds[arc];
+        if (m_visited[m_graph.targets[arc]] != UNVISITED && !m_pathEdges[edge]) {
+            m_recorder.setEdgeColor(edge, Qt::lightGray);
+        }
+    }
+}
+
+void TraversalPainter::setFrontier(int node, bool inFrontier)
+{
+    m_frontier[node] = inFrontier;
+    repaintNode(node);
+}
+
+void TraversalPainter::setCurrent(int node)
+{
+    int previous = m_current;
+    m_current = node;
+    if (previous >= 0) repaintNode(previous);
+    if (node >= 0) repaintNode(node);
+}
+
+void TraversalPainter::markPathEdge(int edge)
+{
+    m_pathEdges[edge] = true;
+    m_recorder.setEdgeColor(edge, PATH_EDGE_COLOR);
+}
+
+void TraversalPainter::repaintNode(int node)
+{
+    QColor color = Qt::white;
+    if (node == m_current) color = Qt::red;
+    else if (m_frontier[node]) color = Qt::yellow;
+    else if (m_visited[node] == FORWARD) color = Qt::green;
+    else if (m_visited[node] == BACKWARD) color = Qt::cyan;
+    m_recorder.setNodeColor(node, color);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "datastructures.h"
+#include "csrgraph.h"
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+// Builds the shared topology for a CSR graph: node i is nodes[i], edge id e is
+// edges[e]. Labels and weight strings are formatted here, once per graph, in
+// parallel; nodes are labeled by id unless 'labels' has one entry per node.
+// Past MAX_LABELED_ELEMENTS nodes plus edges, ids and weights are left
+// unlabeled: they only show far zoomed in, and formatting them would take
+// longer than loading the graph.
+const int MAX_LABELED_ELEMENTS = 1 << 20;
+QSharedPointer<const GraphTopology> buildTopology(const CsrGraph& graph, const QStringList& labels = {});
+
+// Records delta-encoded GraphSteps for one run. Every step shares the topology,
+// and a color change is only logged when it differs from the current color.
+class GraphRecorder
+{
+public:
+    explicit GraphRecorder(QSharedPointer<const GraphTopology> topology);
+
+    void setNodeColor(int node, QColor color);
+    void setEdgeColor(int edge, QColor color);
+    QColor nodeColor(int node) const { return m_nodeColors[node]; }
+    QColor edgeColor(int edge) const { return edge < m_edgeColors.size() ? m_edgeColors[edge] : EdgeState().color; }
+
+    // Appends a step showing every change made so far
+    void record(QList<QVariant>& history, const QString& message);
+
+    // Edge 'edge' now runs from 'from' to 'to' with 'weightLabel' and 'color';
+    // from -1 retires the id. Ids past the topology's extend the run, and the
+    // topology itself stays shared by every step.
+    void setEdgeShape(int edge, int from, int to, const QString& weightLabel, QColor color);
+
+private:
+    QSharedPointer<const GraphTopology> m_topology;
+    QSharedPointer<QVector<GraphChange>> m_changes;
+    QSharedPointer<QVector<EdgeEdit>> m_edits; // Created by the first setEdgeShape()
+    QHash<int, int> m_shapes;                  // Edge id -> its latest entry in m_edits
+    QVector<QColor> m_nodeColors;
+    QVector<QColor> m_edgeColors;
+};
+
+// Turns traversal state into colors, the same rules for every graph algorithm:
+// nodes are current (red) > frontier (yellow) > visited (green, or cyan when
+// reached by the backward half of a bidirectional search) > white, and
+// edges are path (orange) > between two visited nodes (gray) > white.
+// Each state change repaints only the node and its incident edges.
+class TraversalPainter
+{
+public:
+    TraversalPainter(const CsrGraph& graph, GraphRecorder& recorder);
+
+    void visit(int node, bool backward = false);
+    bool isVisited(int node) const { return m_visited[node] != UNVISITED; }
+    void setFrontier(int node, bool inFrontier);
+    void setCurrent(int node); // -1 clears the current node
+    void markPathEdge(int edge);
+
+private:
+    const CsrGraph& m_graph;
+    GraphRecorder& m_recorder;
+    enum Visit : char { UNVISITED, FORWARD, BACKWARD };
+
+    QVector<char> m_visited; // Visit per node
+    QVector<bool> m_frontier;
+    QVector<bool> m_pathEdges;
+    int m_current;
+
+    void repaintNode(int node);
+};
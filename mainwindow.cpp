@@ -6,6 +6,7 @@
 #include <QComboBox>
 #include <QPushButton>
 #include <QSlider>
+#include <QSpinBox>
 #include <QLabel>
 #include <QTextEdit>
 #include <QHBoxLayout>
@@ -13,12 +14,14 @@
 #include <QWidget>
 #include <QGroupBox>
 #include <QScrollBar>
+#include <QFileDialog>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
     qRegisterMetaType<GraphStep>("GraphStep");
     qRegisterMetaType<SortingStep>("SortingStep");
+    qRegisterMetaType<MatrixStep>("MatrixStep");
 
     m_controller = new VisualizerController(this);
     m_canvas = new AlgorithmCanvas(this);
@@ -39,12 +42,34 @@ void MainWindow::setupUI()
     m_algBox = new QComboBox;
     m_algBox->addItems({
         "Bubble Sort", "Insertion Sort", "Selection Sort", "Quick Sort", "Merge Sort",
-        "BST Insert", "BST Remove", "AVL Insert", "AVL Remove",
-        "Graph Generate", "Graph BFS", "Graph DFS", "Graph Dijkstra", "Graph Prim's MST",
-        "Maze Generate"
+        "Binary Search", "Branchless Binary Search", "Interpolation Search", "Eytzinger Search", "van Emde Boas Search",
+        "BST Insert", "BST Remove", "BST Find", "AVL Insert", "AVL Remove", "AVL Find",
+        "BST Bulk Load", "BST Batch", "AVL Bulk Load", "AVL Batch", "AVL Bulk Load (1M keys)",
+        "B-Tree Insert", "B-Tree Remove", "B-Tree Find", "B-Tree Range Scan",
+        "Red-Black Insert", "Red-Black Remove", "Red-Black Find", "Treap Insert", "Treap Remove", "Treap Find",
+        "Splay Insert", "Splay Remove", "Splay Find",
+        "Compare: AVL vs Red-Black vs Treap",
+        "Graph Generate", "Graph BFS", "Graph Parallel BFS", "Graph DFS",
+        "Graph Strongly Connected Components", "Graph Connected Components", "Graph Dijkstra", "Graph A*",
+        "Graph Bidirectional Dijkstra", "Graph Contraction Hierarchy", "Graph Delta-Stepping", "Graph Prim's MST",
+        "Graph Kruskal's MST", "Graph Boruvka's MST", "Graph Floyd-Warshall", "Graph Distance Table",
+        "Graph Max Flow (Dinic)", "Graph Max Flow (Push-Relabel)",
+        "Graph PageRank", "Graph Personalized PageRank", "Graph Label Propagation", "Graph Force Layout",
+        "Graph Insert Edge", "Graph Delete Edge", "Graph Reweight Edge",
+        "Maze Generate", "Maze Eller (Streaming)",
+        "Benchmark: B-Tree vs AVL", "Benchmark: Balancing Schemes",
+        "Benchmark: Access Patterns", "Benchmark: Search Layouts", "Benchmark: CSR Graph",
+        "Benchmark: Graph Generators", "Benchmark: Graph Loader",
+        "Benchmark: Shortest Paths", "Benchmark: Parallel BFS",
+        "Benchmark: Delta-Stepping", "Benchmark: Spanning Trees",
+        "Benchmark: Components", "Benchmark: Floyd-Warshall", "Benchmark: Contraction Hierarchy",
+        "Benchmark: Dynamic Updates", "Benchmark: Batch Queries",
+        "Benchmark: Max Flow", "Benchmark: PageRank", "Benchmark: Force Layout",
+        "Benchmark: Maze History", "Benchmark: Eller Maze"
     });
 
     m_shuffleButton = new QPushButton("Shuffle Data");
+    m_loadGraphButton = new QPushButton("Load Graph...");
     m_startButton = new QPushButton("Start");
     m_pauseButton = new QPushButton("Pause");
     m_stopButton = new QPushButton("Stop");
@@ -56,15 +81,33 @@ void MainWindow::setupUI()
     m_speedSlider->setRange(1, 100);
     m_speedSlider->setValue(80);
 
+    // Odd sizes put walls on both borders; the default fits the window at a readable cell size
+    m_mazeSizeLabel = new QLabel("Maze size:");
+    m_mazeWidthBox = new QSpinBox;
+    m_mazeHeightBox = new QSpinBox;
+    for (QSpinBox* box : {m_mazeWidthBox, m_mazeHeightBox}) {
+        box->setRange(5, 20001);
+        box->setSingleStep(2);
+    }
+    m_mazeWidthBox->setValue(41);
+    m_mazeHeightBox->setValue(25);
+    m_saveMazeButton = new QPushButton("Save Maze...");
+
     QHBoxLayout* controlLayout = new QHBoxLayout;
     controlLayout->addWidget(m_algBox);
     controlLayout->addWidget(m_shuffleButton);
+    controlLayout->addWidget(m_loadGraphButton);
     controlLayout->addSpacing(20);
     controlLayout->addWidget(m_startButton);
     controlLayout->addWidget(m_pauseButton);
     controlLayout->addWidget(m_stopButton);
     controlLayout->addWidget(m_prevButton);
     controlLayout->addWidget(m_nextButton);
+    controlLayout->addSpacing(20);
+    controlLayout->addWidget(m_mazeSizeLabel);
+    controlLayout->addWidget(m_mazeWidthBox);
+    controlLayout->addWidget(m_mazeHeightBox);
+    controlLayout->addWidget(m_saveMazeButton);
     controlLayout->addStretch();
 
     controlLayout->addWidget(m_speedLabel);
@@ -117,6 +160,31 @@ void MainWindow::connectSignals()
         // m_controller->onStart(); <--- REMOVED THIS
     });
 
+    connect(m_loadGraphButton, &QPushButton::clicked, this, [this](){
+        QString path = QFileDialog::getOpenFileName(this, "Load Graph", QString(),
+                                                    "Graphs (*.gr *.graph *.metis *.txt *.el *.edges);;All Files (*)");
+        if (path.isEmpty()) return;
+        m_logDisplay->clear();
+        m_controller->onGraphFileSelected(path);
+    });
+
+    // A new size takes effect right away when a maze is on screen
+    auto applyMazeSize = [this]() {
+        m_controller->onMazeSizeChanged(m_mazeWidthBox->value(), m_mazeHeightBox->value());
+        if (m_algBox->currentText().startsWith("Maze")) {
+            m_logDisplay->clear();
+            m_controller->onAlgorithmSelected(m_algBox->currentText());
+        }
+    };
+    connect(m_mazeWidthBox, &QSpinBox::editingFinished, this, applyMazeSize);
+    connect(m_mazeHeightBox, &QSpinBox::editingFinished, this, applyMazeSize);
+
+    connect(m_saveMazeButton, &QPushButton::clicked, this, [this](){
+        QString path = QFileDialog::getSaveFileName(this, "Save Maze", QString(), "PBM Images (*.pbm)");
+        if (path.isEmpty()) return;
+        m_controller->onMazeSaveRequested(path);
+    });
+
     // Clear logs on stop
     connect(m_stopButton, &QPushButton::clicked, m_logDisplay, &QTextEdit::clear);
 
@@ -124,7 +192,14 @@ void MainWindow::connectSignals()
     connect(m_controller, &VisualizerController::requestRedraw, this, &MainWindow::updateLogFromStep);
     connect(m_controller, &VisualizerController::logMessage, this, &MainWindow::appendLog);
 
+    // One benchmark at a time: picking another entry or reshuffling would start one more
+    connect(m_controller, &VisualizerController::benchmarkRunning, this, [this](bool running){
+        m_algBox->setEnabled(!running);
+        m_shuffleButton->setEnabled(!running);
+    });
+
     m_controller->onSpeedChanged(m_speedSlider->value());
+    m_controller->onMazeSizeChanged(m_mazeWidthBox->value(), m_mazeHeightBox->value());
 }
 
 void MainWindow::onAlgorithmChanged(const QString& algName)
@@ -135,6 +210,12 @@ void MainWindow::onAlgorithmChanged(const QString& algName)
         m_shuffleButton->setText("Shuffle Data");
     }
 
+    bool maze = algName.startsWith("Maze");
+    m_mazeSizeLabel->setVisible(maze);
+    m_mazeWidthBox->setVisible(maze);
+    m_mazeHeightBox->setVisible(maze);
+    m_saveMazeButton->setVisible(maze);
+
     m_logDisplay->clear();
     m_controller->onAlgorithmSelected(algName);
 }
@@ -154,6 +235,9 @@ void MainWindow::updateLogFromStep(const QVariant& step)
     else if (step.canConvert<GraphStep>()) {
         message = step.value<GraphStep>().statusMessage;
     }
+    else if (step.canConvert<MatrixStep>()) {
+        message = step.value<MatrixStep>().statusMessage;
+    }
 
     if (!message.isEmpty()) {
         m_logDisplay->append(message);
@@ -6,6 +6,7 @@
 class QComboBox;
 class QPushButton;
 class QSlider;
+class QSpinBox;
 class QLabel;
 class QTextEdit;
 class AlgorithmCanvas;
@@ -33,6 +34,7 @@ private:
 
     QComboBox* m_algBox;
     QPushButton* m_shuffleButton;
+    QPushButton* m_loadGraphButton;
     QPushButton* m_startButton;
     QPushButton* m_pauseButton;
     QPushButton* m_stopButton;
@@ -42,5 +44,10 @@ private:
     QSlider* m_speedSlider;
     QLabel* m_speedLabel;
 
+    QLabel* m_mazeSizeLabel;
+    QSpinBox* m_mazeWidthBox;
+    QSpinBox* m_mazeHeightBox;
+    QPushButton* m_saveMazeButton;
+
     QTextEdit* m_logDisplay;
 };
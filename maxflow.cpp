@@ -0,0 +1,336 @@
+#include "maxflow.h"
+#include <algorithm>
+#include <vector>
+
+FlowNetwork FlowNetwork::build(const CsrGraph& graph)
+{
+    FlowNetwork network;
+    int n = graph.nodeCount;
+    network.nodeCount = n;
+    QVector<GraphEdge> edges = graph.edgeList();
+
+    // Counting sort of the arc pairs by tail, as CsrGraph::build() does
+    network.offsets.fill(0, n + 1);
+    for (const GraphEdge& e : edges) {
+        network.offsets[e.from + 1]++;
+        network.offsets[e.to + 1]++;
+    }
+    for (int u = 0; u < n; ++u) network.offsets[u + 1] += network.offsets[u];
+
+    int arcCount = network.offsets[n];
+    network.heads.resize(arcCount);
+    network.twins.resize(arcCount);
+    network.capacities.resize(arcCount);
+    network.edgeIds.resize(arcCount);
+    network.forwardArc.resize(edges.size());
+
+    QVector<int> cursor = network.offsets;
+    for (int id = 0; id < edges.size(); ++id) {
+        const GraphEdge& e = edges[id];
+        int forward = cursor[e.from]++;
+        int backward = cursor[e.to]++;
+        network.heads[forward] = e.to;
+        network.heads[backward] = e.from;
+        network.twins[forward] = backward;
+        network.twins[backward] = forward;
+        network.capacities[forward] = e.weight;
+        network.capacities[backward] = graph.directed ? 0 : e.weight;
+        network.edgeIds[forward] = id;
+        network.edgeIds[backward] = id;
+        network.forwardArc[id] = forward;
+    }
+    return network;
+}
+
+namespace MaxFlow
+{
+namespace
+{
+// Flow per input edge and the nodes reachable from the source through arcs
+// with residual capacity left
+void finish(const FlowNetwork& network, const QVector<int>& residual, int source, Result& result)
+{
+    result.edgeFlow.resize(network.forwardArc.size());
+    for (int edge = 0; edge < network.forwardArc.size(); ++edge) {
+        int arc = network.forwardArc[edge];
+        result.edgeFlow[edge] = network.capacities[arc] - residual[arc];
+    }
+
+    result.sourceSide.fill(false, network.nodeCount);
+    QVector<int> queue;
+    queue.reserve(network.nodeCount);
+    result.sourceSide[source] = true;
+    queue.append(source);
+    for (int head = 0; head < queue.size(); ++head) {
+        int u = queue[head];
+        for (int arc = network.arcBegin(u); arc < network.arcEnd(u); ++arc) {
+            int v = network.heads[arc];
+            if (residual[arc] > 0 && !result.sourceSide[v]) {
+                result.sourceSide[v] = true;
+                queue.append(v);
+            }
+        }
+    }
+}
+} // namespace
+
+Result dinic(const FlowNetwork& network, int source, int sink, DinicTrace* trace)
+{
+    Result result;
+    int n = network.nodeCount;
+    QVector<int> residual = network.capacities;
+    if (trace) trace->phases.clear();
+    if (source == sink) {
+        finish(network, residual, source, result);
+        return result;
+    }
+
+    QVector<int> level(n);
+    QVector<int> current(n);
+    QVector<int> queue;
+    queue.reserve(n);
+    std::vector<int> path; // Arcs from the source to the node the DFS stands on
+
+    while (true) {
+        // 1. Level graph: BFS over residual arcs, no deeper than the sink
+        level.fill(-1);
+        queue.clear();
+        level[source] = 0;
+        queue.append(source);
+        for (int head = 0; head < queue.size(); ++head) {
+            int u = queue[head];
+            if (level[sink] >= 0 && level[u] >= level[sink]) break;
+            for (int arc = network.arcBegin(u); arc < network.arcEnd(u); ++arc) {
+                int v = network.heads[arc];
+                if (residual[arc] > 0 && level[v] < 0) {
+                    level[v] = level[u] + 1;
+                    queue.append(v);
+                }
+            }
+        }
+        if (level[sink] < 0) break;
+
+        result.phases++;
+        if (trace) trace->phases.append({level, {}});
+        for (int u = 0; u < n; ++u) current[u] = network.arcBegin(u);
+
+        // 2. Blocking flow: advance along admissible arcs, augment at the sink,
+        //    retreat from dead ends, which leave the level graph for this phase
+        path.clear();
+        int u = source;
+        while (true) {
+            if (u == sink) {
+                int amount = residual[path[0]];
+                for (int arc : path) amount = std::min(amount, residual[arc]);
+                int retreat = -1; // First arc the path saturates
+                for (int i = 0; i < (int)path.size(); ++i) {
+                    int arc = path[i];
+                    residual[arc] -= amount;
+                    residual[network.twins[arc]] += amount;
+                    if (residual[arc] == 0 && retreat < 0) retreat = i;
+                }
+                result.value += amount;
+                result.augmentations++;
+                if (trace) {
+                    DinicTrace::Path traced = {{}, amount};
+                    for (int arc : path) traced.edges.append(network.edgeIds[arc]);
+                    trace->phases.last().paths.append(traced);
+                }
+                path.resize(retreat);
+                u = retreat == 0 ? source : network.heads[path.back()];
+                continue;
+            }
+
+            int& arc = current[u];
+            int end = network.arcEnd(u);
+            while (arc < end && (residual[arc] == 0 || level[network.heads[arc]] != level[u] + 1)) ++arc;
+            if (arc < end) {
+                path.push_back(arc);
+                u = network.heads[arc];
+                continue;
+            }
+
+            if (u == source) break;
+            level[u] = -1;
+            u = network.tail(path.back());
+            path.pop_back();
+            current[u]++;
+        }
+    }
+
+    finish(network, residual, source, result);
+    return result;
+}
+
+Result pushRelabel(const FlowNetwork& network, int source, int sink, Selection selection, PushRelabelTrace* trace)
+{
+    Result result;
+    int n = network.nodeCount;
+    QVector<int> residual = network.capacities;
+    if (trace) trace->pulses.clear();
+    if (source == sink) {
+        finish(network, residual, source, result);
+        return result;
+    }
+
+    const int UNLABELED = 2 * n; // Neither end reachable: never pushed to
+    QVector<long long> excess(n, 0);
+    QVector<int> label(n, 0);
+    QVector<int> current(n);
+    QVector<int> queue;
+    queue.reserve(n);
+
+    // Exact labels: residual distance to the sink, or to the source plus n
+    auto globalRelabel = [&]() {
+        label.fill(UNLABELED);
+        label[sink] = 0;
+        label[source] = n;
+        for (int root : {sink, source}) {
+            queue.clear();
+            queue.append(root);
+            for (int head = 0; head < queue.size(); ++head) {
+                int w = queue[head];
+                for (int arc = network.arcBegin(w); arc < network.arcEnd(w); ++arc) {
+                    int v = network.heads[arc];
+                    if (label[v] == UNLABELED && residual[network.twins[arc]] > 0) {
+                        label[v] = label[w] + 1;
+                        queue.append(v);
+                    }
+                }
+            }
+        }
+        for (int u = 0; u < n; ++u) current[u] = network.arcBegin(u);
+        result.globalRelabels++;
+    };
+
+    // Active nodes: a ring buffer for FIFO, buckets by label for highest-label.
+    // Each active node is held once; the node being discharged is held by neither.
+    QVector<int> ring(n);
+    int ringHead = 0;
+    int ringSize = 0;
+    std::vector<std::vector<int>> buckets(selection == HIGHEST_LABEL ? 2 * n : 0);
+    int highest = 0;
+    int activeCount = 0;
+
+    auto activate = [&](int v) {
+        activeCount++;
+        if (selection == FIFO) {
+            ring[(ringHead + ringSize++) % n] = v;
+        } else {
+            buckets[label[v]].push_back(v);
+            highest = std::max(highest, label[v]);
+        }
+    };
+    auto nextActive = [&]() {
+        activeCount--;
+        if (selection == FIFO) {
+            int u = ring[ringHead];
+            ringHead = (ringHead + 1) % n;
+            ringSize--;
+            return u;
+        }
+        while (buckets[highest].empty()) highest--;
+        int u = buckets[highest].back();
+        buckets[highest].pop_back();
+        return u;
+    };
+    // Labels changed under the buckets; FIFO order does not depend on them
+    auto rebucket = [&]() {
+        if (selection == FIFO) return;
+        for (std::vector<int>& bucket : buckets) bucket.clear();
+        highest = 0;
+        activeCount = 0;
+        for (int u = 0; u < n; ++u) {
+            if (excess[u] > 0 && u != source && u != sink) activate(u);
+        }
+    };
+
+    // Trace bookkeeping: edges whose flow changed during the current pulse
+    QVector<bool> edgeChanged(trace ? network.forwardArc.size() : 0, false);
+    QVector<int> changedEdges;
+    PushRelabelTrace::Pulse pulse;
+    int pulseLeft = 0;
+
+    auto push = [&](int arc, int amount) {
+        int v = network.heads[arc];
+        residual[arc] -= amount;
+        residual[network.twins[arc]] += amount;
+        excess[network.tail(arc)] -= amount;
+        if (excess[v] == 0 && v != source && v != sink) activate(v);
+        excess[v] += amount;
+        result.pushes++;
+        if (trace && !edgeChanged[network.edgeIds[arc]]) {
+            edgeChanged[network.edgeIds[arc]] = true;
+            changedEdges.append(network.edgeIds[arc]);
+        }
+    };
+
+    // Saturate every arc out of the source, then label from the sink
+    for (int arc = network.arcBegin(source); arc < network.arcEnd(source); ++arc) {
+        if (residual[arc] > 0) push(arc, residual[arc]);
+    }
+    globalRelabel();
+    rebucket();
+
+    long long relabelsSinceGlobal = 0;
+    while (activeCount > 0) {
+        if (trace && pulseLeft == 0) pulseLeft = activeCount;
+
+        // Discharge: push until the excess is gone, relabeling when no arc is admissible
+        int u = nextActive();
+        int end = network.arcEnd(u);
+        while (excess[u] > 0) {
+            int& arc = current[u];
+            if (arc == end) {
+                int lowest = UNLABELED;
+                for (int a = network.arcBegin(u); a < end; ++a) {
+                    if (residual[a] > 0) lowest = std::min(lowest, label[network.heads[a]]);
+                }
+                label[u] = lowest + 1;
+                arc = network.arcBegin(u);
+                result.relabels++;
+                relabelsSinceGlobal++;
+                if (trace) pulse.relabels++;
+                continue;
+            }
+            int v = network.heads[arc];
+            if (residual[arc] > 0 && label[u] == label[v] + 1) {
+                push(arc, (int)std::min<long long>(excess[u], residual[arc]));
+                if (residual[arc] > 0) break; // Excess used up, the arc stays current
+            }
+            ++arc;
+        }
+
+        bool relabelAll = relabelsSinceGlobal >= n;
+        if (relabelAll) {
+            globalRelabel();
+            rebucket();
+            relabelsSinceGlobal = 0;
+        }
+
+        if (trace) {
+            pulse.discharged.append(u);
+            pulse.globalRelabel = pulse.globalRelabel || relabelAll;
+            if (--pulseLeft == 0 || activeCount == 0) {
+                for (int v = 0; v < n; ++v) {
+                    if (excess[v] > 0 && v != source && v != sink) pulse.active.append(v);
+                }
+                for (int edge : changedEdges) {
+                    int forward = network.forwardArc[edge];
+                    pulse.changedFlows.append({edge, network.capacities[forward] - residual[forward]});
+                    edgeChanged[edge] = false;
+                }
+                changedEdges.clear();
+                pulse.sinkExcess = excess[sink];
+                trace->pulses.append(pulse);
+                pulse = PushRelabelTrace::Pulse();
+                pulseLeft = 0;
+            }
+        }
+    }
+
+    result.value = excess[sink];
+    finish(network, residual, source, result);
+    return result;
+}
+}
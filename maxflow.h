@@ -0,0 +1,91 @@
+#pragma once
+
+#include "csrgraph.h"
+#include <QPair>
+#include <QVector>
+
+// Residual network of a CsrGraph in CSR form, edge weights as capacities.
+// Every input edge becomes an arc and its twin in the other direction; the
+// twin has capacity 0 on a directed graph and the full weight on an undirected
+// one, so flow can cross an undirected edge either way. Self-loops are kept
+// but never carry flow.
+struct FlowNetwork {
+    int nodeCount = 0;
+    QVector<int> offsets;    // nodeCount + 1 entries
+    QVector<int> heads;
+    QVector<int> twins;      // Index of the arc in the other direction
+    QVector<int> capacities;
+    QVector<int> edgeIds;    // Input edge of each arc, shared by its twin
+    QVector<int> forwardArc; // Per input edge: the arc from its 'from' to its 'to' node
+
+    static FlowNetwork build(const CsrGraph& graph);
+
+    int arcBegin(int u) const { return offsets[u]; }
+    int arcEnd(int u) const { return offsets[u + 1]; }
+    int arcCount() const { return heads.size(); }
+    int tail(int arc) const { return heads[twins[arc]]; }
+};
+
+// Maximum flow from a source to a sink. Both algorithms return the same flow
+// value and a minimum cut; the flows themselves may differ.
+namespace MaxFlow
+{
+struct Result {
+    long long value = 0;
+    QVector<int> edgeFlow;    // Per input edge as CsrGraph::edgeList() has it; negative if it runs from 'to' to 'from'
+    QVector<bool> sourceSide; // Nodes still reachable from the source: the minimum cut
+    int phases = 0;           // Dinic: level graphs built
+    long long augmentations = 0;
+    long long pushes = 0;
+    long long relabels = 0;
+    int globalRelabels = 0;
+};
+
+// What dinic() did in each phase, for visualization
+struct DinicTrace {
+    struct Path {
+        QVector<int> edges; // Input edge ids from source to sink
+        int amount;
+    };
+    struct Phase {
+        QVector<int> level; // BFS distance from the source in the residual network; -1 if unreached
+        QVector<Path> paths;
+    };
+    QVector<Phase> phases;
+};
+
+// Dinic: BFS from the source builds the level graph of residual arcs that go
+// one level deeper, then a blocking flow fills it by iterative DFS with a
+// current-arc pointer per node, so each arc is skipped at most once per phase.
+// Repeats until the sink is unreachable; at most V phases.
+Result dinic(const FlowNetwork& network, int source, int sink, DinicTrace* trace = nullptr);
+
+// Which active node push-relabel discharges next
+enum Selection {
+    FIFO,         // Oldest active node first; O(V^3)
+    HIGHEST_LABEL // Highest label first; O(V^2 sqrt(E))
+};
+
+// Active nodes and flow changes of push-relabel, for visualization. A pulse
+// discharges as many nodes as were active when it began.
+struct PushRelabelTrace {
+    struct Pulse {
+        QVector<int> discharged;
+        QVector<int> active;                   // Active nodes once the pulse is over
+        QVector<QPair<int, int>> changedFlows; // (edge id, flow) of edges whose flow changed
+        int relabels = 0;
+        bool globalRelabel = false;            // Labels were recomputed after the pulse
+        long long sinkExcess = 0;
+    };
+    QVector<Pulse> pulses;
+};
+
+// Goldberg-Tarjan push-relabel. The source saturates its arcs, then active
+// nodes (with excess) push along admissible arcs to a node one label lower
+// and are relabeled when they have none. Global relabeling sets every label
+// to the exact residual distance to the sink (or to the source plus V, for
+// excess on its way back) by a reverse BFS, at the start and again after every
+// V relabels. Runs until no node is active, so the result is a flow, not just a preflow.
+Result pushRelabel(const FlowNetwork& network, int source, int sink, Selection selection,
+                   PushRelabelTrace* trace = nullptr);
+}
@@ -1,86 +1,172 @@
 #include "maze.h"
-#include <QRandomGenerator>
-#include <algorithm> // std::shuffle
+#include "fastrng.h"
+#include <algorithm>
+#include <vector>
+
+// Changes between keyframes: at least one grid's worth, so keyframes never
+// take more memory than the log itself
+const int MIN_KEYFRAME_INTERVAL = 4096;
+
+long long MazeTrace::memoryBytes() const
+{
+    long long bytes = (long long)changes.size() * sizeof(MazeChange);
+    for (const QByteArray& keyframe : keyframes) bytes += keyframe.size();
+    return bytes;
+}
 
 Maze::Maze() {}
 
-QList<QVariant> Maze::generateRecursiveBacktracker(int width, int height)
+void Maze::reset(int width, int height)
 {
     m_width = width;
     m_height = height;
+    m_cells = QByteArray(width * height, (char)CellType::WALL);
 
-    // Initialize grid with WALLS
-    m_grid.clear();
-    m_grid.resize(height);
-    for(int y=0; y<height; ++y) {
-        m_grid[y].resize(width);
-        m_grid[y].fill(CellType::WALL);
-    }
-
-    QList<QVariant> history;
-    history.append(QVariant::fromValue(createSnapshot("Initializing Maze Grid...")));
-
-    // Start carving from (1, 1)
-    // We use odd coordinates for cells to ensure walls exist between them
-    carve(1, 1, history);
+    m_trace.reset(new MazeTrace);
+    m_trace->width = width;
+    m_trace->height = height;
+    m_trace->keyframeInterval = std::max(MIN_KEYFRAME_INTERVAL, width * height);
+    m_trace->keyframes.append(m_cells);
+}
 
-    // Final cleanup: Remove the "Head" markers (VISITED) and make them normal PATHS
-    // (In this implementation, carve sets them to PATH immediately after recursion,
-    // so we just need a final 'Done' snapshot)
-    history.append(QVariant::fromValue(createSnapshot("Maze Generation Complete!")));
+void Maze::setCell(int x, int y, CellType type)
+{
+    int index = y * m_width + x;
+    if (!m_logging) {
+        m_cells.data()[index] = (char)type;
+        return;
+    }
+    quint8 previous = (quint8)m_cells[index];
+    if (previous == type) return;
 
-    return history;
+    QVector<MazeChange>& changes = m_trace->changes;
+    changes.append({index, (quint8)type, previous});
+    m_cells[index] = (char)type;
+    if (changes.size() == m_trace->keyframes.size() * m_trace->keyframeInterval) m_trace->keyframes.append(m_cells);
 }
 
-void Maze::carve(int x, int y, QList<QVariant>& history)
+void Maze::record(QList<QVariant>& history, const QString& message)
 {
-    m_grid[y][x] = CellType::VISITED; // Mark as "Head" (Processing)
-    history.append(QVariant::fromValue(createSnapshot("Carving at (" + QString::number(x) + "," + QString::number(y) + ")")));
+    MazeStep step;
+    step.trace = m_trace;
+    step.changeCount = m_trace->changes.size();
+    step.statusMessage = message;
+    history.append(QVariant::fromValue(step));
+}
 
-    // Directions: Up, Down, Left, Right
-    // dx, dy pairs
-    QVector<QPair<int, int>> dirs = { {0, -2}, {0, 2}, {-2, 0}, {2, 0} };
+QList<QVariant> Maze::generateRecursiveBacktracker(int width, int height, unsigned seed)
+{
+    // Initialize grid with WALLS
+    reset(width, height);
+    m_logging = (long long)width * height <= MAX_TRACED_CELLS;
+    if (!m_logging) m_trace->keyframes.clear(); // The finished grid becomes the only keyframe
 
-    // Randomize directions
-    for (int i = 0; i < dirs.size(); ++i) {
-        int j = QRandomGenerator::global()->bounded(dirs.size());
-        qSwap(dirs[i], dirs[j]);
+    QList<QVariant> history;
+    if (width < 3 || height < 3) {
+        record(history, "Maze too small to carve");
+        return history;
     }
 
-    for (const auto& dir : dirs) {
-        int dx = dir.first;
-        int dy = dir.second;
-
-        int nx = x + dx;
-        int ny = y + dy;
-
-        // Check bounds and if unvisited (WALL)
-        // We check 1 step away (wall) and 2 steps away (target cell)
-        if (nx > 0 && nx < m_width - 1 && ny > 0 && ny < m_height - 1 && m_grid[ny][nx] == CellType::WALL) {
-
-            // Remove wall between current and next
-            m_grid[y + dy/2][x + dx/2] = CellType::PATH;
+    // Every carved cell is entered once and left once; record about every
+    // 'stride'th of those events so long runs stay within MAX_STEPS
+    long long events = 2LL * ((width - 1) / 2) * ((height - 1) / 2);
+    long long stride = std::max(1LL, (events + MAX_STEPS - 1) / MAX_STEPS);
+    long long eventCount = 0;
+    auto event = [&](const char* action, int x, int y) {
+        if (m_logging && ++eventCount % stride == 0) {
+            record(history, QString(action) + " (" + QString::number(x) + "," + QString::number(y) + ")");
+        }
+    };
+    if (m_logging) record(history, "Initializing Maze Grid...");
+
+    // Directions: Up, Down, Left, Right. Cells sit on odd coordinates, so a
+    // move skips the wall between two cells.
+    const int dx[4] = {0, 0, -2, 2};
+    const int dy[4] = {-2, 2, 0, 0};
+    FastRng rng(seed);
+
+    // The path from (1, 1) to the head, as the direction of each move; the
+    // head walks back along it when it has no unvisited neighbour left
+    std::vector<quint8> path;
+    int x = 1, y = 1;
+    setCell(x, y, CellType::VISITED); // Mark as "Head" (Processing)
+    event("Carving at", x, y);
+
+    while (true) {
+        // Unvisited (WALL) cells two steps away, in bounds
+        int options[4];
+        int count = 0;
+        for (int d = 0; d < 4; ++d) {
+            int nx = x + dx[d], ny = y + dy[d];
+            if (nx > 0 && nx < m_width - 1 && ny > 0 && ny < m_height - 1 && cell(nx, ny) == CellType::WALL) {
+                options[count++] = d;
+            }
+        }
 
-            // Mark next as visited (Head)
-            // Note: We temporarily mark the 'wall' we just broke as VISITED for visual flair
-            m_grid[y + dy/2][x + dx/2] = CellType::VISITED;
+        if (count > 0) {
+            int d = options[count == 1 ? 0 : rng.bounded((quint32)count)];
+            // Remove wall between current and next, marked as visited (Head)
+            // for visual flair until we backtrack through it
+            setCell(x + dx[d] / 2, y + dy[d] / 2, CellType::VISITED);
+            x += dx[d];
+            y += dy[d];
+            path.push_back((quint8)d);
+            setCell(x, y, CellType::VISITED);
+            event("Carving at", x, y);
+            continue;
+        }
 
-            carve(nx, ny, history);
+        // We are done with this cell, set it to normal PATH
+        setCell(x, y, CellType::PATH);
+        event("Backtracking from", x, y);
+        if (path.empty()) break;
+
+        // Backtracking: Set the path behind us to normal PATH (clearing the red head)
+        int d = path.back();
+        path.pop_back();
+        setCell(x - dx[d] / 2, y - dy[d] / 2, CellType::PATH);
+        x -= dx[d];
+        y -= dy[d];
+    }
 
-            // Backtracking: Set the path behind us to normal PATH (clearing the red head)
-            m_grid[y + dy/2][x + dx/2] = CellType::PATH;
-        }
+    if (!m_logging) {
+        m_trace->keyframes.append(m_cells);
+        record(history, "Maze Generation Complete! (" + QString::number((long long)width * height)
+                            + " cells: too large to animate)");
+        return history;
     }
+    record(history, "Maze Generation Complete!");
+
+    return history;
+}
 
-    // We are done with this cell, set it to normal PATH
-    m_grid[y][x] = CellType::PATH;
-    history.append(QVariant::fromValue(createSnapshot("Backtracking from (" + QString::number(x) + "," + QString::number(y) + ")")));
+void Maze::startEller(int width, int height, unsigned seed)
+{
+    m_eller.reset(new EllerMaze(width, seed));
+    m_window.clear();
+    m_windowHeight = std::max(height, 1);
 }
 
-MazeStep Maze::createSnapshot(const QString& message)
+QVariant Maze::ellerFrame(int cellRows)
 {
     MazeStep step;
-    step.grid = m_grid; // Deep copy the grid
-    step.statusMessage = message;
-    return step;
+    if (!m_eller) return QVariant::fromValue(step);
+
+    for (int i = 0; i < cellRows; ++i) m_eller->nextRows(m_window);
+    int width = m_eller->width();
+    int windowBytes = m_windowHeight * width;
+    if (m_window.size() > windowBytes) m_window.remove(0, m_window.size() - windowBytes);
+
+    // A fresh single-keyframe trace per frame: the rows it shows never change
+    QSharedPointer<MazeTrace> trace(new MazeTrace);
+    trace->width = width;
+    trace->height = m_window.size() / width;
+    trace->keyframes.append(m_window);
+    step.trace = trace;
+
+    long long bottom = m_eller->rowsGenerated();
+    step.statusMessage = "Eller's algorithm: rows " + QString::number(bottom - trace->height) + "-"
+                         + QString::number(bottom - 1) + " | " + QString::number(m_eller->memoryBytes())
+                         + " bytes of row state";
+    return QVariant::fromValue(step);
 }
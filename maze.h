@@ -1,21 +1,49 @@
 #pragma once
 
 #include "datastructures.h"
+#include "ellermaze.h"
+#include <QByteArray>
 #include <QList>
+#include <QSharedPointer>
 #include <QVariant>
 #include <QVector>
 
 class Maze
 {
 public:
+    // Mazes with more cells than this are generated without a change log and
+    // come back as a single step showing the finished maze
+    static const int MAX_TRACED_CELLS = 1 << 22;
+    // Steps kept for an animated run; larger mazes record every few events
+    static const int MAX_STEPS = 100000;
+
     Maze();
-    QList<QVariant> generateRecursiveBacktracker(int width, int height);
+
+    // Depth-first carving from (1, 1) with an explicit stack, so any size
+    // fits; the same seed always gives the same maze
+    QList<QVariant> generateRecursiveBacktracker(int width, int height, unsigned seed);
+
+    // --- Eller's algorithm ---
+    // Streamed rather than recorded up front, and endless: startEller() begins
+    // a maze 'width' columns wide, and each ellerFrame() adds 'cellRows' more
+    // rows of cells and returns one step showing the last 'height' grid rows.
+    // Older rows are dropped, so memory stays O(width * height).
+    void startEller(int width, int height, unsigned seed);
+    QVariant ellerFrame(int cellRows);
 
 private:
     int m_width;
     int m_height;
-    QVector<QVector<int>> m_grid;
+    QByteArray m_cells;                // Row-major CellType per cell
+    QSharedPointer<MazeTrace> m_trace; // Change log of the current run, shared by its steps
+    bool m_logging = true;             // Whether setCell() logs changes in m_trace
+
+    QSharedPointer<EllerMaze> m_eller; // Streamed maze in progress
+    QByteArray m_window;               // Its last rows, row-major
+    int m_windowHeight = 0;
 
-    void carve(int x, int y, QList<QVariant>& history);
-    MazeStep createSnapshot(const QString& message);
+    void reset(int width, int height); // All walls, and a new trace
+    quint8 cell(int x, int y) const { return (quint8)m_cells[y * m_width + x]; }
+    void setCell(int x, int y, CellType type); // Logs the change, and a keyframe when one is due
+    void record(QList<QVariant>& history, const QString& message);
 };
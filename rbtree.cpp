@@ -0,0 +1,352 @@
+#include "rbtree.h"
+
+// Node colors on the canvas (black nodes are drawn dark gray so they stay visible)
+const QColor RB_RED = QColor(200, 40, 40);
+const QColor RB_BLACK = QColor(60, 60, 60);
+
+RedBlackTree::RedBlackTree() : m_root(nullptr), m_nextNodeId(0) {}
+
+RedBlackTree::~RedBlackTree()
+{
+    clear();
+}
+
+void RedBlackTree::clear()
+{
+    TreeView::destroy(m_root);
+    m_root = nullptr;
+    m_nextNodeId = 0;
+}
+
+// --- Public Methods ---
+
+QList<QVariant> RedBlackTree::insert(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    record(&history, "Inserting " + QString::number(value));
+
+    insertKey(value, &history);
+
+    record(&history, "Inserted " + QString::number(value) + ". " + TreeView::statsText(m_stats));
+    return history;
+}
+
+QList<QVariant> RedBlackTree::remove(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    record(&history, "Attempting to remove " + QString::number(value));
+
+    if (removeKey(value, &history)) {
+        record(&history, "Removed " + QString::number(value) + ". " + TreeView::statsText(m_stats));
+    } else {
+        record(&history, "Value " + QString::number(value) + " not found.");
+    }
+    return history;
+}
+
+QList<QVariant> RedBlackTree::find(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    record(&history, "Searching for " + QString::number(value));
+
+    const TreeNode* node = m_root;
+    while (node) {
+        m_stats.comparisons++;
+        m_stats.pathLength++;
+        if (value == node->value) break;
+        record(&history, "Comparing with " + QString::number(node->value), node);
+        node = (value < node->value) ? node->left : node->right;
+    }
+
+    QString summary = "Path length: " + QString::number(m_stats.pathLength);
+    if (node) record(&history, "Found " + QString::number(value) + ". " + summary, node, Qt::green);
+    else record(&history, "Value " + QString::number(value) + " not found. " + summary);
+    return history;
+}
+
+bool RedBlackTree::insertSilent(int value)
+{
+    return insertKey(value, nullptr);
+}
+
+bool RedBlackTree::removeSilent(int value)
+{
+    return removeKey(value, nullptr);
+}
+
+bool RedBlackTree::contains(int value) const
+{
+    const TreeNode* node = m_root;
+    while (node) {
+        if (value < node->value) node = node->left;
+        else if (value > node->value) node = node->right;
+        else return true;
+    }
+    return false;
+}
+
+bool RedBlackTree::findSilent(int value)
+{
+    return TreeView::search(m_root, value, m_stats) != nullptr;
+}
+
+// --- Insertion ---
+
+bool RedBlackTree::insertKey(int value, QList<QVariant>* history)
+{
+    // 1. Standard BST descent
+    TreeNode* parent = nullptr;
+    TreeNode* node = m_root;
+    while (node) {
+        m_stats.comparisons++;
+        if (history) record(history, "Comparing with " + QString::number(node->value), node);
+        parent = node;
+        if (value < node->value) node = node->left;
+        else if (value > node->value) node = node->right;
+        else {
+            if (history) record(history, "Value " + QString::number(value) + " already exists.", node, Qt::red);
+            return false;
+        }
+    }
+
+    TreeNode* z = new TreeNode(value, m_nextNodeId++);
+    z->parent = parent;
+    if (!parent) m_root = z;
+    else if (value < parent->value) parent->left = z;
+    else parent->right = z;
+    if (history) record(history, "Found spot. Inserted " + QString::number(value) + " as a red node", z, Qt::green);
+
+    // 2. Restore the red-black properties
+    insertFixup(z, history);
+    return true;
+}
+
+void RedBlackTree::insertFixup(RedBlackTree::TreeNode* z, QList<QVariant>* history)
+{
+    while (isRed(z->parent)) {
+        TreeNode* p = z->parent;
+        TreeNode* g = p->parent; // Exists, since a red parent is never the root
+        bool parentIsLeft = (p == g->left);
+        TreeNode* uncle = parentIsLeft ? g->right : g->left;
+
+        // Case 1: Red uncle -> push the blackness down from the grandparent
+        if (isRed(uncle)) {
+            p->red = false;
+            uncle->red = false;
+            g->red = true;
+            m_stats.recolors += 3;
+            if (history) record(history, "Red uncle " + QString::number(uncle->value) + ". Recoloring parent, uncle and grandparent", g, Qt::cyan);
+            z = g;
+            continue;
+        }
+
+        // Case 2: Zig-zag -> rotate into a straight line first
+        if (parentIsLeft && z == p->right) {
+            if (history) record(history, "Left-Right case. Performing Left rotation on " + QString::number(p->value), p, Qt::cyan);
+            rotateLeft(p);
+            z = p;
+            p = z->parent;
+        } else if (!parentIsLeft && z == p->left) {
+            if (history) record(history, "Right-Left case. Performing Right rotation on " + QString::number(p->value), p, Qt::cyan);
+            rotateRight(p);
+            z = p;
+            p = z->parent;
+        }
+
+        // Case 3: Straight line -> recolor and rotate the grandparent
+        p->red = false;
+        g->red = true;
+        m_stats.recolors += 2;
+        if (history) record(history, "Recoloring and rotating at grandparent " + QString::number(g->value), g, Qt::cyan);
+        if (parentIsLeft) rotateRight(g);
+        else rotateLeft(g);
+        if (history) record(history, "After rotation", p, Qt::green);
+    }
+
+    if (m_root->red) {
+        m_root->red = false;
+        m_stats.recolors++;
+        if (history) record(history, "Recoloring root black", m_root, Qt::cyan);
+    }
+}
+
+// --- Removal ---
+
+bool RedBlackTree::removeKey(int value, QList<QVariant>* history)
+{
+    // 1. Find the node
+    TreeNode* z = m_root;
+    while (z && z->value != value) {
+        m_stats.comparisons++;
+        if (history) record(history, "Comparing with " + QString::number(z->value), z);
+        z = (value < z->value) ? z->left : z->right;
+    }
+    if (!z) return false;
+
+    m_stats.comparisons++;
+    if (history) record(history, "Found node " + QString::number(value), z, Qt::red);
+
+    // 2. Unlink it. 'removedRed' tracks the color that actually left the tree,
+    // and x is the (possibly null) node that took its place.
+    bool removedRed = z->red;
+    TreeNode* x = nullptr;
+    TreeNode* xParent = nullptr;
+
+    if (!z->left) {
+        x = z->right;
+        xParent = z->parent;
+        transplant(z, z->right);
+    } else if (!z->right) {
+        x = z->left;
+        xParent = z->parent;
+        transplant(z, z->left);
+    } else {
+        // Two children: the inorder successor takes z's place and color
+        TreeNode* y = z->right;
+        while (y->left) y = y->left;
+        if (history) record(history, "Node has two children. Successor: " + QString::number(y->value), y, Qt::green);
+
+        removedRed = y->red;
+        x = y->right;
+        if (y->parent == z) {
+            xParent = y;
+        } else {
+            xParent = y->parent;
+            transplant(y, y->right);
+            y->right = z->right;
+            y->right->parent = y;
+        }
+        transplant(z, y);
+        y->left = z->left;
+        y->left->parent = y;
+        if (y->red != z->red) m_stats.recolors++;
+        y->red = z->red;
+    }
+    delete z;
+
+    // 3. Removing a black node leaves a "double black" to resolve
+    if (!removedRed) {
+        if (history) record(history, "Removed a black node. Fixing double black", xParent, Qt::cyan);
+        removeFixup(x, xParent, history);
+    }
+    return true;
+}
+
+void RedBlackTree::removeFixup(RedBlackTree::TreeNode* x, RedBlackTree::TreeNode* parent, QList<QVariant>* history)
+{
+    while (x != m_root && !isRed(x)) {
+        bool isLeft = (x == parent->left);
+        TreeNode* w = isLeft ? parent->right : parent->left; // Sibling, never null here
+
+        // Case 1: Red sibling -> rotate so the sibling becomes black
+        if (isRed(w)) {
+            w->red = false;
+            parent->red = true;
+            m_stats.recolors += 2;
+            if (history) record(history, "Red sibling " + QString::number(w->value) + ". Recolor and rotate at parent", parent, Qt::cyan);
+            if (isLeft) rotateLeft(parent);
+            else rotateRight(parent);
+            w = isLeft ? parent->right : parent->left;
+        }
+
+        TreeNode* nearChild = isLeft ? w->left : w->right;
+        TreeNode* farChild = isLeft ? w->right : w->left;
+
+        // Case 2: Black sibling with black children -> move the double black up
+        if (!isRed(nearChild) && !isRed(farChild)) {
+            w->red = true;
+            m_stats.recolors++;
+            if (history) record(history, "Black sibling with black children. Recoloring " + QString::number(w->value) + " red", w, Qt::cyan);
+            x = parent;
+            parent = x->parent;
+            continue;
+        }
+
+        // Case 3: Near child red -> rotate it into the far position
+        if (!isRed(farChild)) {
+            nearChild->red = false;
+            w->red = true;
+            m_stats.recolors += 2;
+            if (history) record(history, "Sibling's near child is red. Rotating sibling " + QString::number(w->value), w, Qt::cyan);
+            if (isLeft) rotateRight(w);
+            else rotateLeft(w);
+            w = isLeft ? parent->right : parent->left;
+            farChild = isLeft ? w->right : w->left;
+        }
+
+        // Case 4: Far child red -> final rotation at the parent
+        w->red = parent->red;
+        parent->red = false;
+        farChild->red = false;
+        m_stats.recolors += 2;
+        if (history) record(history, "Sibling's far child is red. Rotating at parent " + QString::number(parent->value), parent, Qt::cyan);
+        if (isLeft) rotateLeft(parent);
+        else rotateRight(parent);
+        x = m_root;
+        parent = nullptr;
+    }
+
+    if (x && x->red) {
+        x->red = false;
+        m_stats.recolors++;
+    }
+}
+
+void RedBlackTree::transplant(RedBlackTree::TreeNode* u, RedBlackTree::TreeNode* v)
+{
+    if (!u->parent) m_root = v;
+    else if (u == u->parent->left) u->parent->left = v;
+    else u->parent->right = v;
+    if (v) v->parent = u->parent;
+}
+
+// --- Rotations ---
+
+void RedBlackTree::rotateLeft(RedBlackTree::TreeNode* x)
+{
+    m_stats.rotations++;
+    TreeNode* y = x->right;
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+    transplant(x, y);
+    y->left = x;
+    x->parent = y;
+}
+
+void RedBlackTree::rotateRight(RedBlackTree::TreeNode* y)
+{
+    m_stats.rotations++;
+    TreeNode* x = y->left;
+    y->left = x->right;
+    if (x->right) x->right->parent = y;
+    transplant(y, x);
+    x->right = y;
+    y->parent = x;
+}
+
+// --- Visualization Helpers ---
+
+void RedBlackTree::record(QList<QVariant>* history, const QString& message, const RedBlackTree::TreeNode* highlight, QColor color)
+{
+    // Callers test 'history' first, so silent runs never build the message strings
+    if (!history) return;
+    GraphStep step = createSnapshot(message);
+    if (highlight) TreeView::highlightNode(step, highlight->id, color);
+    history->append(QVariant::fromValue(step));
+}
+
+GraphStep RedBlackTree::createSnapshot(const QString& message)
+{
+    TreeView::updatePositions(m_root);
+
+    GraphStep step;
+    step.statusMessage = message;
+    TreeView::populateSnapshot(m_root, step, [](const TreeNode* node, NodeState& ns) {
+        ns.color = node->red ? RB_RED : RB_BLACK;
+        ns.textColor = Qt::white;
+    });
+    return step;
+}
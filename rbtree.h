@@ -0,0 +1,65 @@
+#pragma once
+
+#include "datastructures.h"
+#include "treeview.h"
+#include <QList>
+#include <QVariant>
+
+class RedBlackTree
+{
+public:
+    RedBlackTree();
+    ~RedBlackTree();
+
+    // Public methods that generate and return a step-by-step history
+    QList<QVariant> insert(int value);
+    QList<QVariant> remove(int value);
+    QList<QVariant> find(int value);
+    void clear(); // Resets the tree
+
+    // Native operations (no history), used for benchmarking
+    bool insertSilent(int value);
+    bool removeSilent(int value);
+    bool contains(int value) const;
+    bool findSilent(int value); // Like contains(), but counts comparisons and path length
+
+    // Counters accumulate until reset; insert/remove reset them first
+    const TreeStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = TreeStats(); }
+
+private:
+    // --- Core Tree Structure ---
+    struct TreeNode {
+        int value;
+        TreeNode *left;
+        TreeNode *right;
+        TreeNode *parent;
+        bool red;
+
+        int id;         // Unique ID for visualization
+        QPointF pos;    // Position on canvas
+        int level;      // Tree level (0 for root)
+
+        TreeNode(int v, int i)
+            : value(v), left(nullptr), right(nullptr), parent(nullptr), red(true), // New nodes start red
+            id(i), pos(), level(0) {}
+    };
+
+    TreeNode* m_root;
+    int m_nextNodeId;
+    TreeStats m_stats;
+
+    // --- Algorithm Helpers (history may be null, in which case nothing is recorded) ---
+    bool insertKey(int value, QList<QVariant>* history);
+    bool removeKey(int value, QList<QVariant>* history);
+    void insertFixup(TreeNode* z, QList<QVariant>* history);
+    void removeFixup(TreeNode* x, TreeNode* parent, QList<QVariant>* history);
+    void transplant(TreeNode* u, TreeNode* v);
+    void rotateLeft(TreeNode* x);
+    void rotateRight(TreeNode* y);
+    static bool isRed(const TreeNode* node) { return node && node->red; }
+
+    // --- Visualization Helpers ---
+    void record(QList<QVariant>* history, const QString& message, const TreeNode* highlight = nullptr, QColor color = Qt::yellow);
+    GraphStep createSnapshot(const QString& message);
+};
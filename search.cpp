@@ -0,0 +1,181 @@
+#include "search.h"
+
+// --- Private Helpers ---
+namespace Searching
+{
+int fillEytzinger(const QVector<int>& sorted, QVector<int>& layout, int next, int k)
+{
+    if (k < layout.size()) {
+        next = fillEytzinger(sorted, layout, next, 2 * k);     // Left subtree first (in-order)
+        layout[k] = sorted[next++];
+        next = fillEytzinger(sorted, layout, next, 2 * k + 1);
+    }
+    return next;
+}
+
+// Fills the split tables for the subtree with its root at 'depth' and 'height' levels
+void splitVeb(VebLayout& veb, int depth, int height)
+{
+    if (height <= 1) return;
+    int topHeight = height / 2;
+    int bottomHeight = height - topHeight;
+    int bottomDepth = depth + topHeight;
+
+    veb.topDepth[bottomDepth] = depth;
+    veb.topSize[bottomDepth] = (1 << topHeight) - 1;
+    veb.bottomSize[bottomDepth] = (1 << bottomHeight) - 1;
+
+    splitVeb(veb, depth, topHeight);
+    splitVeb(veb, bottomDepth, bottomHeight);
+}
+
+// Walks the complete tree in BFS numbering and stores each node's in-order key at its vEB slot
+void fillVeb(const QVector<int>& sorted, VebLayout& veb, int* pos, int bfsIndex, int depth)
+{
+    if (depth == veb.height) return;
+    pos[depth] = (depth == 0) ? 0 : pos[veb.topDepth[depth]] + veb.topSize[depth] + (bfsIndex & veb.topSize[depth]) * veb.bottomSize[depth];
+
+    // In-order rank of this node in a complete tree of 'height' levels
+    long long offset = bfsIndex - (1LL << depth);
+    long long rank = (2 * offset + 1) * (1LL << (veb.height - 1 - depth)) - 1;
+    veb.keys[pos[depth]] = (rank < sorted.size()) ? sorted[rank] : sorted.last();
+
+    fillVeb(sorted, veb, pos, 2 * bfsIndex, depth + 1);
+    fillVeb(sorted, veb, pos, 2 * bfsIndex + 1, depth + 1);
+}
+
+// Records one access: the current index in yellow, every earlier access in blue
+void recordProbe(QList<QVariant>& history, const QVector<int>& data, QList<int>& accessed, int index)
+{
+    history.append(QVariant::fromValue(SortingStep{data,
+        "Access [" + QString::number(index) + "] = " + QString::number(data[index]),
+        {index}, accessed
+    }));
+    if (!accessed.contains(index)) accessed.append(index);
+}
+
+void recordResult(QList<QVariant>& history, const QVector<int>& data, const QList<int>& accessed, int index, int target)
+{
+    QString accesses = QString::number(accessed.size()) + " distinct accesses";
+    if (index >= 0) {
+        history.append(QVariant::fromValue(SortingStep{data,
+            "Found " + QString::number(target) + " at index " + QString::number(index) + " after " + accesses,
+            {}, accessed, {}, {index}
+        }));
+    } else {
+        history.append(QVariant::fromValue(SortingStep{data,
+            QString::number(target) + " not found after " + accesses, {}, accessed
+        }));
+    }
+}
+}
+
+// --- Layouts ---
+
+QVector<int> Searching::eytzingerLayout(const QVector<int>& sorted)
+{
+    QVector<int> layout(sorted.size() + 1, 0);
+    fillEytzinger(sorted, layout, 0, 1);
+    return layout;
+}
+
+Searching::VebLayout Searching::vebLayout(const QVector<int>& sorted)
+{
+    VebLayout veb;
+    if (sorted.isEmpty()) return veb;
+
+    while ((1LL << veb.height) - 1 < sorted.size()) veb.height++;
+    veb.keys.resize((1 << veb.height) - 1);
+    veb.topDepth.fill(0, veb.height);
+    veb.topSize.fill(0, veb.height);
+    veb.bottomSize.fill(0, veb.height);
+
+    splitVeb(veb, 0, veb.height);
+    int pos[32];
+    fillVeb(sorted, veb, pos, 1, 0);
+    return veb;
+}
+
+// --- Visualizations ---
+
+QList<QVariant> Searching::binarySearch(QVector<int> data, int target)
+{
+    QList<QVariant> history;
+    history.append(QVariant::fromValue(SortingStep{data, "Binary search for " + QString::number(target)}));
+
+    QList<int> accessed;
+    int index = binaryFind(data.constData(), data.size(), target, [&](int i) {
+        recordProbe(history, data, accessed, i);
+    });
+
+    recordResult(history, data, accessed, index, target);
+    return history;
+}
+
+QList<QVariant> Searching::branchlessBinarySearch(QVector<int> data, int target)
+{
+    QList<QVariant> history;
+    history.append(QVariant::fromValue(SortingStep{data,
+        "Branchless binary search for " + QString::number(target) + ": always log2(n) halvings, no early exit"}));
+
+    QList<int> accessed;
+    int index = branchlessFind(data.constData(), data.size(), target, [&](int i) {
+        recordProbe(history, data, accessed, i);
+    });
+
+    recordResult(history, data, accessed, index, target);
+    return history;
+}
+
+QList<QVariant> Searching::interpolationSearch(QVector<int> data, int target)
+{
+    QList<QVariant> history;
+    history.append(QVariant::fromValue(SortingStep{data, "Interpolation search for " + QString::number(target)}));
+
+    QList<int> accessed;
+    int index = interpolationFind(data.constData(), data.size(), target, [&](int i) {
+        recordProbe(history, data, accessed, i);
+    });
+
+    recordResult(history, data, accessed, index, target);
+    return history;
+}
+
+QList<QVariant> Searching::eytzingerSearch(QVector<int> data, int target)
+{
+    QList<QVariant> history;
+    history.append(QVariant::fromValue(SortingStep{data, "Sorted array"}));
+
+    // The bars show slots 1..n, so bar i is slot i + 1
+    QVector<int> layout = eytzingerLayout(data);
+    QVector<int> bars = layout.mid(1);
+    history.append(QVariant::fromValue(SortingStep{bars,
+        "Eytzinger layout: the root first, then each tree level left to right. Searching for " + QString::number(target)}));
+
+    QList<int> accessed;
+    int slot = eytzingerFind(layout.constData(), data.size(), target, [&](int k) {
+        recordProbe(history, bars, accessed, k - 1);
+    });
+
+    recordResult(history, bars, accessed, slot >= 0 ? slot - 1 : -1, target);
+    return history;
+}
+
+QList<QVariant> Searching::vebSearch(QVector<int> data, int target)
+{
+    QList<QVariant> history;
+    history.append(QVariant::fromValue(SortingStep{data, "Sorted array"}));
+
+    VebLayout veb = vebLayout(data);
+    history.append(QVariant::fromValue(SortingStep{veb.keys,
+        "van Emde Boas layout (height " + QString::number(veb.height) + "): each top and bottom tree is contiguous. Searching for "
+        + QString::number(target)}));
+
+    QList<int> accessed;
+    int slot = vebFind(veb, target, [&](int i) {
+        recordProbe(history, veb.keys, accessed, i);
+    });
+
+    recordResult(history, veb.keys, accessed, slot, target);
+    return history;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "datastructures.h"
+#include <QList>
+#include <QVariant>
+#include <QVector>
+
+// Searching a sorted array, either in place or re-laid out for the cache.
+// Every search kernel calls probe(index) for each element it reads, so the same
+// code drives the visualizations, the access counters and the native benchmark
+// (where the probe is an empty lambda and compiles away).
+namespace Searching
+{
+// --- Layouts ---
+
+// Eytzinger (BFS) order: slot 1 is the root, slots 2k and 2k+1 are the children
+// of slot k. Slot 0 is unused. The top levels of the tree share cache lines.
+QVector<int> eytzingerLayout(const QVector<int>& sorted);
+
+// van Emde Boas order: the complete BST is split at half its height into a top
+// tree and its bottom trees, each stored contiguously and laid out the same way
+// recursively. Missing leaves are padded with the largest key.
+struct VebLayout {
+    QVector<int> keys;
+    int height = 0;
+    // Per depth d > 0, for the split in which d is the root depth of the bottom trees:
+    QVector<int> topDepth;   // Depth of the enclosing top tree's root
+    QVector<int> topSize;    // Nodes in that top tree (2^k - 1, also the bottom-tree index mask)
+    QVector<int> bottomSize; // Nodes in each bottom tree
+};
+VebLayout vebLayout(const QVector<int>& sorted);
+
+// --- Search Kernels (return the index of 'target' in their layout, or -1) ---
+
+inline void prefetch(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    Q_UNUSED(address);
+#endif
+}
+
+inline int trailingOnes(unsigned value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(~value);
+#else
+    int count = 0;
+    while (value & 1) {
+        value >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+template <typename Probe>
+int binaryFind(const int* data, int n, int target, Probe probe)
+{
+    int low = 0;
+    int high = n - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        probe(mid);
+        if (data[mid] == target) return mid;
+        if (data[mid] < target) low = mid + 1;
+        else high = mid - 1;
+    }
+    return -1;
+}
+
+// Fixed number of halvings with a conditional move instead of a branch
+template <typename Probe>
+int branchlessFind(const int* data, int n, int target, Probe probe)
+{
+    if (n == 0) return -1;
+    const int* base = data;
+    int length = n;
+    while (length > 1) {
+        int half = length / 2;
+        probe(base - data + half);
+        base = (base[half] < target) ? base + half : base;
+        length -= half;
+    }
+    probe(base - data);
+    int index = (base - data) + (*base < target);
+    if (index < n && index != base - data) probe(index);
+    return (index < n && data[index] == target) ? index : -1;
+}
+
+// Guesses the position from the key values; O(log log n) probes on uniform keys
+template <typename Probe>
+int interpolationFind(const int* data, int n, int target, Probe probe)
+{
+    int low = 0;
+    int high = n - 1;
+    while (low <= high) {
+        probe(low);
+        probe(high);
+        if (target < data[low] || target > data[high]) return -1;
+
+        int mid = low;
+        if (data[high] != data[low]) {
+            mid = low + (int)(((long long)target - data[low]) * (high - low) / ((long long)data[high] - data[low]));
+        }
+        probe(mid);
+        if (data[mid] == target) return mid;
+        if (data[mid] < target) low = mid + 1;
+        else high = mid - 1;
+    }
+    return -1;
+}
+
+// 'layout' comes from eytzingerLayout(), so it holds n + 1 slots
+template <typename Probe>
+int eytzingerFind(const int* layout, int n, int target, Probe probe)
+{
+    int k = 1;
+    while (k <= n) {
+        prefetch(layout + 16 * k); // Four levels ahead: the 16 descendants share a cache line
+        probe(k);
+        k = 2 * k + (layout[k] < target);
+    }
+    // Undo the trailing right turns; k is then the first slot with a key >= target
+    k >>= trailingOnes(k) + 1;
+
+    if (k == 0) return -1;
+    probe(k);
+    return (layout[k] == target) ? k : -1;
+}
+
+// Walks all 'height' levels without an early exit, remembering the last key >= target
+template <typename Probe>
+int vebFind(const VebLayout& veb, int target, Probe probe)
+{
+    const int* keys = veb.keys.constData();
+    int pos[32]; // Slot of the node visited at each depth
+    int bfsIndex = 1;
+    int candidate = -1;
+    for (int d = 0; d < veb.height; ++d) {
+        pos[d] = (d == 0) ? 0 : pos[veb.topDepth[d]] + veb.topSize[d] + (bfsIndex & veb.topSize[d]) * veb.bottomSize[d];
+        probe(pos[d]);
+        bool goRight = keys[pos[d]] < target;
+        candidate = goRight ? candidate : pos[d];
+        bfsIndex = 2 * bfsIndex + goRight;
+    }
+    return (candidate >= 0 && keys[candidate] == target) ? candidate : -1;
+}
+
+// --- Visualizations (input must be sorted; every access is marked on the bars) ---
+QList<QVariant> binarySearch(QVector<int> data, int target);
+QList<QVariant> branchlessBinarySearch(QVector<int> data, int target);
+QList<QVariant> interpolationSearch(QVector<int> data, int target);
+QList<QVariant> eytzingerSearch(QVector<int> data, int target);
+QList<QVariant> vebSearch(QVector<int> data, int target);
+}
@@ -0,0 +1,139 @@
+#include "spatialindex.h"
+#include <algorithm>
+#include <cmath>
+
+const int NODES_PER_CELL = 8;
+const int MAX_GRID_CELLS = 1 << 22;
+const int MAX_EDGE_CELLS = 16; // Edges overlapping more cells go on the long-edge list
+
+int SpatialIndex::column(double x) const
+{
+    return std::clamp((int)((x - m_bounds.left()) / m_cellSize), 0, m_columns - 1);
+}
+
+int SpatialIndex::row(double y) const
+{
+    return std::clamp((int)((y - m_bounds.top()) / m_cellSize), 0, m_rows - 1);
+}
+
+void SpatialIndex::build(const GraphTopology& topology)
+{
+    int n = topology.nodes.size();
+    m_positions.resize(n);
+    m_segments.resize(topology.edges.size());
+    m_longEdges.clear();
+    m_seen.fill(0, topology.edges.size());
+    m_stamp = 0;
+
+    double minX = 0.0, minY = 0.0, maxX = 0.0, maxY = 0.0;
+    for (int u = 0; u < n; ++u) {
+        QPointF p = topology.nodes[u].position;
+        m_positions[u] = p;
+        if (u == 0 || p.x() < minX) minX = p.x();
+        if (u == 0 || p.x() > maxX) maxX = p.x();
+        if (u == 0 || p.y() < minY) minY = p.y();
+        if (u == 0 || p.y() > maxY) maxY = p.y();
+    }
+    for (int e = 0; e < topology.edges.size(); ++e) {
+        m_segments[e] = {topology.edges[e].fromId, topology.edges[e].toId};
+    }
+    m_bounds = QRectF(minX, minY, maxX - minX, maxY - minY);
+
+    // Square cells holding about NODES_PER_CELL nodes each on an even spread
+    double width = std::max(maxX - minX, 1.0);
+    double height = std::max(maxY - minY, 1.0);
+    int cells = std::clamp(n / NODES_PER_CELL, 1, MAX_GRID_CELLS);
+    m_cellSize = std::sqrt(width * height / cells);
+    m_columns = std::min((int)(width / m_cellSize) + 1, MAX_GRID_CELLS);
+    m_rows = std::min((int)(height / m_cellSize) + 1, MAX_GRID_CELLS / m_columns);
+    cells = m_columns * m_rows;
+
+    // Counting sort of the nodes by cell
+    QVector<int> nodeCell(n);
+    m_nodeStart.fill(0, cells + 1);
+    for (int u = 0; u < n; ++u) {
+        nodeCell[u] = row(m_positions[u].y()) * m_columns + column(m_positions[u].x());
+        m_nodeStart[nodeCell[u] + 1]++;
+    }
+    for (int c = 0; c < cells; ++c) m_nodeStart[c + 1] += m_nodeStart[c];
+    m_nodes.resize(n);
+    QVector<int> cursor = m_nodeStart;
+    for (int u = 0; u < n; ++u) m_nodes[cursor[nodeCell[u]]++] = u;
+
+    // Edges into every cell their bounding box overlaps: count, then scatter
+    m_edgeStart.fill(0, cells + 1);
+    auto forEachCell = [&](int e, auto visit) {
+        if (m_segments[e].from < 0 || m_segments[e].to < 0) return true; // Unused id: in no cell
+        QPointF a = m_positions[m_segments[e].from];
+        QPointF b = m_positions[m_segments[e].to];
+        int c0 = column(std::min(a.x(), b.x())), c1 = column(std::max(a.x(), b.x()));
+        int r0 = row(std::min(a.y(), b.y())), r1 = row(std::max(a.y(), b.y()));
+        if ((c1 - c0 + 1) * (r1 - r0 + 1) > MAX_EDGE_CELLS) return false;
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) visit(r * m_columns + c);
+        }
+        return true;
+    };
+    for (int e = 0; e < m_segments.size(); ++e) {
+        if (!forEachCell(e, [&](int cell) { m_edgeStart[cell + 1]++; })) m_longEdges.append(e);
+    }
+    for (int c = 0; c < cells; ++c) m_edgeStart[c + 1] += m_edgeStart[c];
+    m_edges.resize(m_edgeStart[cells]);
+    cursor = m_edgeStart;
+    for (int e = 0; e < m_segments.size(); ++e) {
+        forEachCell(e, [&](int cell) { m_edges[cursor[cell]++] = e; });
+    }
+}
+
+void SpatialIndex::query(const QRectF& rect, QVector<int>& nodes, QVector<int>& edges) const
+{
+    nodes.clear();
+    edges.clear();
+    if (m_positions.isEmpty()) return;
+
+    // Everything in view: no need to walk the grid
+    if (rect.left() <= m_bounds.left() && rect.right() >= m_bounds.right()
+        && rect.top() <= m_bounds.top() && rect.bottom() >= m_bounds.bottom()) {
+        nodes.resize(m_positions.size());
+        for (int u = 0; u < nodes.size(); ++u) nodes[u] = u;
+        edges.resize(m_segments.size());
+        for (int e = 0; e < edges.size(); ++e) edges[e] = e;
+        return;
+    }
+    if (rect.right() < m_bounds.left() || rect.left() > m_bounds.right()
+        || rect.bottom() < m_bounds.top() || rect.top() > m_bounds.bottom()) return;
+
+    if (++m_stamp == 0) { // Wrapped: old stamps could match again
+        m_seen.fill(0);
+        m_stamp = 1;
+    }
+    auto overlaps = [&](int e) {
+        QPointF a = m_positions[m_segments[e].from];
+        QPointF b = m_positions[m_segments[e].to];
+        return std::max(a.x(), b.x()) >= rect.left() && std::min(a.x(), b.x()) <= rect.right()
+               && std::max(a.y(), b.y()) >= rect.top() && std::min(a.y(), b.y()) <= rect.bottom();
+    };
+
+    int c0 = column(rect.left()), c1 = column(rect.right());
+    int r0 = row(rect.top()), r1 = row(rect.bottom());
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            int cell = r * m_columns + c;
+            for (int i = m_nodeStart[cell]; i < m_nodeStart[cell + 1]; ++i) {
+                QPointF p = m_positions[m_nodes[i]];
+                if (p.x() >= rect.left() && p.x() <= rect.right() && p.y() >= rect.top() && p.y() <= rect.bottom()) {
+                    nodes.append(m_nodes[i]);
+                }
+            }
+            for (int i = m_edgeStart[cell]; i < m_edgeStart[cell + 1]; ++i) {
+                int e = m_edges[i];
+                if (m_seen[e] == m_stamp) continue;
+                m_seen[e] = m_stamp;
+                if (overlaps(e)) edges.append(e);
+            }
+        }
+    }
+    for (int e : m_longEdges) {
+        if (overlaps(e)) edges.append(e);
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "datastructures.h"
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+// Uniform grid over the node positions and edge bounding boxes of a graph
+// topology, so a zoomed-in view only touches the cells it can see. Each cell
+// lists its nodes and every edge whose bounding box overlaps it, packed CSR
+// style; an edge spanning more than a few cells goes on a side list that every
+// query scans instead of being copied into all of them.
+class SpatialIndex
+{
+public:
+    // O(V + E); positions and endpoints are copied, the topology is not kept
+    void build(const GraphTopology& topology);
+
+    // Nodes positioned in 'rect' and edges whose bounding box overlaps it,
+    // each listed once, in no particular order
+    void query(const QRectF& rect, QVector<int>& nodes, QVector<int>& edges) const;
+
+    QRectF bounds() const { return m_bounds; }
+
+private:
+    struct Segment {
+        int from;
+        int to;
+    };
+
+    QVector<QPointF> m_positions;
+    QVector<Segment> m_segments;
+    QRectF m_bounds; // Of every node position
+
+    double m_cellSize = 1.0;
+    int m_columns = 0;
+    int m_rows = 0;
+    QVector<int> m_nodeStart; // Per cell, nodes are m_nodes[m_nodeStart[c], m_nodeStart[c + 1])
+    QVector<int> m_nodes;
+    QVector<int> m_edgeStart; // Same for edges
+    QVector<int> m_edges;
+    QVector<int> m_longEdges;
+
+    // An edge overlapping several cells is found once per query: it is taken
+    // only if its stamp is not yet the query's
+    mutable QVector<unsigned> m_seen;
+    mutable unsigned m_stamp = 0;
+
+    int column(double x) const;
+    int row(double y) const;
+};
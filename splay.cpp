@@ -0,0 +1,242 @@
+#include "splay.h"
+
+SplayTree::SplayTree() : m_root(nullptr), m_nextNodeId(0) {}
+
+SplayTree::~SplayTree()
+{
+    clear();
+}
+
+void SplayTree::clear()
+{
+    TreeView::destroy(m_root);
+    m_root = nullptr;
+    m_nextNodeId = 0;
+}
+
+// --- Public Methods ---
+
+QList<QVariant> SplayTree::insert(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    record(&history, "Inserting " + QString::number(value));
+
+    insertKey(value, &history);
+
+    record(&history, "Inserted " + QString::number(value) + ". " + TreeView::statsText(m_stats));
+    return history;
+}
+
+QList<QVariant> SplayTree::remove(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    record(&history, "Attempting to remove " + QString::number(value));
+
+    if (removeKey(value, &history)) {
+        record(&history, "Removed " + QString::number(value) + ". " + TreeView::statsText(m_stats));
+    } else {
+        record(&history, "Value " + QString::number(value) + " not found.");
+    }
+    return history;
+}
+
+QList<QVariant> SplayTree::find(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    record(&history, "Searching for " + QString::number(value));
+
+    bool found = findKey(value, &history);
+
+    QString summary = "Path length: " + QString::number(m_stats.pathLength) + ", Rotations: " + QString::number(m_stats.rotations);
+    if (found) record(&history, "Found " + QString::number(value) + ". " + summary, m_root, Qt::green);
+    else record(&history, "Value " + QString::number(value) + " not found. " + summary);
+    return history;
+}
+
+bool SplayTree::insertSilent(int value)
+{
+    return insertKey(value, nullptr);
+}
+
+bool SplayTree::removeSilent(int value)
+{
+    return removeKey(value, nullptr);
+}
+
+bool SplayTree::findSilent(int value)
+{
+    return findKey(value, nullptr);
+}
+
+bool SplayTree::contains(int value) const
+{
+    const TreeNode* node = m_root;
+    while (node) {
+        if (value < node->value) node = node->left;
+        else if (value > node->value) node = node->right;
+        else return true;
+    }
+    return false;
+}
+
+// --- Algorithm Helpers ---
+
+SplayTree::TreeNode* SplayTree::descend(int value, int& visited, QList<QVariant>* history)
+{
+    visited = 0;
+    TreeNode* node = m_root;
+    while (node) {
+        m_stats.comparisons++;
+        visited++;
+        if (value == node->value) return node;
+        if (history) record(history, "Comparing with " + QString::number(node->value), node);
+
+        TreeNode* next = (value < node->value) ? node->left : node->right;
+        if (!next) return node;
+        node = next;
+    }
+    return nullptr; // Empty tree
+}
+
+bool SplayTree::insertKey(int value, QList<QVariant>* history)
+{
+    int visited = 0;
+    TreeNode* last = descend(value, visited, history);
+
+    if (last && last->value == value) {
+        if (history) record(history, "Value " + QString::number(value) + " already exists.", last, Qt::red);
+        splay(last, history);
+        return false;
+    }
+
+    TreeNode* z = new TreeNode(value, m_nextNodeId++);
+    z->parent = last;
+    if (!last) m_root = z;
+    else if (value < last->value) last->left = z;
+    else last->right = z;
+    if (history) record(history, "Found spot. Inserted " + QString::number(value), z, Qt::green);
+
+    splay(z, history);
+    return true;
+}
+
+bool SplayTree::removeKey(int value, QList<QVariant>* history)
+{
+    int visited = 0;
+    TreeNode* last = descend(value, visited, history);
+    if (!last) return false;
+
+    // Even a miss splays the last node visited, which pays for the search
+    splay(last, history);
+    if (last->value != value) return false;
+
+    // 1. The node is now the root: detach its two subtrees
+    TreeNode* leftTree = m_root->left;
+    TreeNode* rightTree = m_root->right;
+    delete m_root;
+    if (leftTree) leftTree->parent = nullptr;
+    if (rightTree) rightTree->parent = nullptr;
+
+    if (!leftTree) {
+        m_root = rightTree;
+        return true;
+    }
+
+    // 2. Splay the maximum of the left subtree to its root; it has no right
+    // child afterwards, so the right subtree hangs off it directly.
+    m_root = leftTree;
+    TreeNode* maxNode = leftTree;
+    while (maxNode->right) maxNode = maxNode->right;
+    splay(maxNode, nullptr);
+    maxNode->right = rightTree;
+    if (rightTree) rightTree->parent = maxNode;
+
+    if (history) record(history, "Joined subtrees under predecessor " + QString::number(maxNode->value), maxNode, Qt::cyan);
+    return true;
+}
+
+bool SplayTree::findKey(int value, QList<QVariant>* history)
+{
+    int visited = 0;
+    TreeNode* last = descend(value, visited, history);
+    m_stats.pathLength += visited;
+    if (!last) return false;
+
+    bool found = (last->value == value);
+    splay(last, history);
+    return found;
+}
+
+// --- Splaying ---
+
+void SplayTree::splay(SplayTree::TreeNode* x, QList<QVariant>* history)
+{
+    while (x->parent) {
+        TreeNode* p = x->parent;
+        TreeNode* g = p->parent;
+
+        if (!g) {
+            // Zig: parent is the root
+            if (history) record(history, "Zig: rotating " + QString::number(x->value) + " above the root", x, Qt::cyan);
+            rotate(x);
+        } else if ((x == p->left) == (p == g->left)) {
+            // Zig-zig: rotate the parent first, which halves the depth of the whole path
+            if (history) record(history, "Zig-zig: rotating " + QString::number(p->value) + " then " + QString::number(x->value), x, Qt::cyan);
+            rotate(p);
+            rotate(x);
+        } else {
+            // Zig-zag: rotate x twice
+            if (history) record(history, "Zig-zag: rotating " + QString::number(x->value) + " twice", x, Qt::cyan);
+            rotate(x);
+            rotate(x);
+        }
+    }
+    if (history) record(history, "Splayed " + QString::number(x->value) + " to the root", x, Qt::green);
+}
+
+void SplayTree::rotate(SplayTree::TreeNode* x)
+{
+    m_stats.rotations++;
+    TreeNode* p = x->parent;
+    TreeNode* g = p->parent;
+
+    if (x == p->left) {
+        p->left = x->right;
+        if (x->right) x->right->parent = p;
+        x->right = p;
+    } else {
+        p->right = x->left;
+        if (x->left) x->left->parent = p;
+        x->left = p;
+    }
+    p->parent = x;
+    x->parent = g;
+
+    if (!g) m_root = x;
+    else if (g->left == p) g->left = x;
+    else g->right = x;
+}
+
+// --- Visualization Helpers ---
+
+void SplayTree::record(QList<QVariant>* history, const QString& message, const SplayTree::TreeNode* highlight, QColor color)
+{
+    // Callers test 'history' first, so silent runs never build the message strings
+    if (!history) return;
+    GraphStep step = createSnapshot(message);
+    if (highlight) TreeView::highlightNode(step, highlight->id, color);
+    history->append(QVariant::fromValue(step));
+}
+
+GraphStep SplayTree::createSnapshot(const QString& message)
+{
+    TreeView::updatePositions(m_root);
+
+    GraphStep step;
+    step.statusMessage = message;
+    TreeView::populateSnapshot(m_root, step);
+    return step;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "datastructures.h"
+#include "treeview.h"
+#include <QList>
+#include <QVariant>
+
+// Self-adjusting BST: every access splays the touched node up to the root,
+// so recently and frequently used keys stay near the top of the tree.
+class SplayTree
+{
+public:
+    SplayTree();
+    ~SplayTree();
+
+    // Public methods that generate and return a step-by-step history
+    QList<QVariant> insert(int value);
+    QList<QVariant> remove(int value);
+    QList<QVariant> find(int value);
+    void clear(); // Resets the tree
+
+    // Native operations (no history), used for benchmarking
+    bool insertSilent(int value);
+    bool removeSilent(int value);
+    bool findSilent(int value); // Splays, and counts comparisons and path length
+    bool contains(int value) const; // Read-only lookup, does not splay
+
+    // Counters accumulate until reset; insert/remove/find reset them first
+    const TreeStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = TreeStats(); }
+
+private:
+    // --- Core Tree Structure ---
+    struct TreeNode {
+        int value;
+        TreeNode *left;
+        TreeNode *right;
+        TreeNode *parent;
+
+        int id;         // Unique ID for visualization
+        QPointF pos;    // Position on canvas
+        int level;      // Tree level (0 for root)
+
+        TreeNode(int v, int i)
+            : value(v), left(nullptr), right(nullptr), parent(nullptr),
+            id(i), pos(), level(0) {}
+    };
+
+    TreeNode* m_root;
+    int m_nextNodeId;
+    TreeStats m_stats;
+
+    // --- Algorithm Helpers (history may be null, in which case nothing is recorded) ---
+    TreeNode* descend(int value, int& visited, QList<QVariant>* history); // Match, or the last node visited
+    bool insertKey(int value, QList<QVariant>* history);
+    bool removeKey(int value, QList<QVariant>* history);
+    bool findKey(int value, QList<QVariant>* history);
+    void splay(TreeNode* x, QList<QVariant>* history);
+    void rotate(TreeNode* x); // Rotates x above its parent
+
+    // --- Visualization Helpers ---
+    void record(QList<QVariant>* history, const QString& message, const TreeNode* highlight = nullptr, QColor color = Qt::yellow);
+    GraphStep createSnapshot(const QString& message);
+};
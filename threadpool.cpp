@@ -0,0 +1,154 @@
+#include "threadpool.h"
+#include <algorithm>
+#include <atomic>
+
+ThreadPool::ThreadPool(int threadCount)
+{
+    if (threadCount <= 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (int thread = 1; thread < threadCount; ++thread) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, thread);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) worker.join();
+}
+
+ThreadPool& ThreadPool::global()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::parallelFor(int count, int grain, const std::function<void(int, int, int)>& body)
+{
+    if (count <= 0) return;
+    grain = std::max(1, grain);
+
+    // Serial fallback: nothing to share
+    if (m_workers.empty() || count <= grain) {
+        body(0, 0, count);
+        return;
+    }
+
+    std::atomic<int> next{0};
+    runOnAll([&](int thread) {
+        while (true) {
+            int begin = next.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= count) return;
+            body(thread, begin, std::min(begin + grain, count));
+        }
+    });
+}
+
+namespace
+{
+// One thread's remaining share [begin, end), packed into one word so the
+// owner taking from the front and a thief cutting off the back can both CAS it
+struct alignas(64) StealRange {
+    std::atomic<unsigned long long> bounds{0};
+
+    static unsigned long long pack(unsigned begin, unsigned end) { return (unsigned long long)end << 32 | begin; }
+    static unsigned begin(unsigned long long bounds) { return (unsigned)bounds; }
+    static unsigned end(unsigned long long bounds) { return (unsigned)(bounds >> 32); }
+};
+} // namespace
+
+int ThreadPool::parallelForStealing(int count, const std::function<void(int, int)>& body)
+{
+    if (count <= 0) return 0;
+    if (m_workers.empty() || count == 1) {
+        for (int index = 0; index < count; ++index) body(0, index);
+        return 0;
+    }
+
+    int threads = threadCount();
+    std::vector<StealRange> ranges(threads);
+    for (int thread = 0; thread < threads; ++thread) {
+        ranges[thread].bounds.store(StealRange::pack((long long)count * thread / threads, (long long)count * (thread + 1) / threads),
+                                    std::memory_order_relaxed);
+    }
+    std::atomic<int> steals{0};
+
+    runOnAll([&](int thread) {
+        std::atomic<unsigned long long>& own = ranges[thread].bounds;
+        while (true) {
+            // Take the next index of the own share
+            unsigned long long bounds = own.load(std::memory_order_relaxed);
+            unsigned begin = StealRange::begin(bounds);
+            unsigned end = StealRange::end(bounds);
+            if (begin < end) {
+                if (own.compare_exchange_weak(bounds, StealRange::pack(begin + 1, end), std::memory_order_relaxed)) body(thread, begin);
+                continue;
+            }
+
+            // Out of work: cut the back half off the largest share left
+            int victim = -1;
+            unsigned largest = 0;
+            for (int other = 0; other < threads; ++other) {
+                unsigned long long otherBounds = ranges[other].bounds.load(std::memory_order_relaxed);
+                unsigned left = StealRange::end(otherBounds) - std::min(StealRange::begin(otherBounds), StealRange::end(otherBounds));
+                if (left > largest) {
+                    largest = left;
+                    victim = other;
+                }
+            }
+            if (victim < 0) return; // Items still running elsewhere are already claimed
+
+            unsigned long long victimBounds = ranges[victim].bounds.load(std::memory_order_relaxed);
+            unsigned victimBegin = StealRange::begin(victimBounds);
+            unsigned victimEnd = StealRange::end(victimBounds);
+            if (victimBegin >= victimEnd) continue;
+            unsigned middle = victimBegin + (victimEnd - victimBegin) / 2;
+            if (ranges[victim].bounds.compare_exchange_strong(victimBounds, StealRange::pack(victimBegin, middle), std::memory_order_relaxed)) {
+                own.store(StealRange::pack(middle, victimEnd), std::memory_order_relaxed); // Nobody steals from an empty share
+                steals.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    return steals.load();
+}
+
+void ThreadPool::runOnAll(const std::function<void(int)>& work)
+{
+    std::lock_guard<std::mutex> job(m_jobMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_work = &work;
+        m_busy = (int)m_workers.size();
+        m_job++;
+    }
+    m_wake.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_work = nullptr;
+}
+
+void ThreadPool::workerLoop(int thread)
+{
+    unsigned seenJob = 0;
+    while (true) {
+        const std::function<void(int)>* work;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_job != seenJob; });
+            if (m_stopping) return;
+            seenJob = m_job;
+            work = m_work;
+        }
+
+        (*work)(thread);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busy == 0) m_done.notify_one();
+    }
+}
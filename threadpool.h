@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. The calling thread
+// takes part as thread 0, so a pool of one thread runs everything inline
+// and needs no synchronization at all. One job runs at a time: callers on
+// different threads take turns, and a loop body must not call parallelFor()
+// itself.
+class ThreadPool
+{
+public:
+    // threadCount <= 0 means one thread per hardware core
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int threadCount() const { return (int)m_workers.size() + 1; }
+
+    // Calls body(thread, begin, end) on chunks of at most 'grain' indices until
+    // [0, count) is covered, and returns once every chunk is done. Threads claim
+    // chunks from a shared counter, so uneven chunks balance themselves.
+    // Ranges of a single chunk run inline on the caller.
+    void parallelFor(int count, int grain, const std::function<void(int thread, int begin, int end)>& body);
+
+    // Calls body(thread, index) once per index in [0, count). Each thread starts
+    // on its own contiguous share and, once that is used up, steals the back
+    // half of the largest share left, so neighboring indices mostly stay on one
+    // thread while uneven items still balance. Returns the number of steals.
+    int parallelForStealing(int count, const std::function<void(int thread, int index)>& body);
+
+    // Shared pool sized to the machine
+    static ThreadPool& global();
+
+private:
+    std::vector<std::thread> m_workers;
+    std::mutex m_jobMutex; // Held by the caller for a whole job
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+
+    // Current job, guarded by m_mutex
+    const std::function<void(int)>* m_work = nullptr;
+    int m_busy = 0;         // Workers still inside the current job
+    unsigned m_job = 0;     // Incremented per job so workers wake exactly once
+    bool m_stopping = false;
+
+    void workerLoop(int thread);
+    void runOnAll(const std::function<void(int thread)>& work); // Once per thread, the caller as thread 0
+};
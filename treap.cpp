@@ -0,0 +1,210 @@
+#include "treap.h"
+
+Treap::Treap(unsigned seed) : m_root(nullptr), m_nextNodeId(0), m_rng(seed) {}
+
+Treap::~Treap()
+{
+    clear();
+}
+
+void Treap::clear()
+{
+    TreeView::destroy(m_root);
+    m_root = nullptr;
+    m_nextNodeId = 0;
+}
+
+// --- Public Methods ---
+
+QList<QVariant> Treap::insert(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    record(&history, "Inserting " + QString::number(value));
+
+    bool inserted = false;
+    m_root = insertRecursive(m_root, value, inserted, &history);
+
+    record(&history, "Inserted " + QString::number(value) + ". " + TreeView::statsText(m_stats));
+    return history;
+}
+
+QList<QVariant> Treap::remove(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    record(&history, "Attempting to remove " + QString::number(value));
+
+    bool removed = false;
+    m_root = removeRecursive(m_root, value, removed, &history);
+
+    if (removed) {
+        record(&history, "Removed " + QString::number(value) + ". " + TreeView::statsText(m_stats));
+    } else {
+        record(&history, "Value " + QString::number(value) + " not found.");
+    }
+    return history;
+}
+
+QList<QVariant> Treap::find(int value)
+{
+    resetStats();
+    QList<QVariant> history;
+    record(&history, "Searching for " + QString::number(value));
+
+    const TreeNode* node = m_root;
+    while (node) {
+        m_stats.comparisons++;
+        m_stats.pathLength++;
+        if (value == node->value) break;
+        record(&history, "Comparing with " + QString::number(node->value), node);
+        node = (value < node->value) ? node->left : node->right;
+    }
+
+    QString summary = "Path length: " + QString::number(m_stats.pathLength);
+    if (node) record(&history, "Found " + QString::number(value) + ". " + summary, node, Qt::green);
+    else record(&history, "Value " + QString::number(value) + " not found. " + summary);
+    return history;
+}
+
+bool Treap::insertSilent(int value)
+{
+    bool inserted = false;
+    m_root = insertRecursive(m_root, value, inserted, nullptr);
+    return inserted;
+}
+
+bool Treap::removeSilent(int value)
+{
+    bool removed = false;
+    m_root = removeRecursive(m_root, value, removed, nullptr);
+    return removed;
+}
+
+bool Treap::contains(int value) const
+{
+    const TreeNode* node = m_root;
+    while (node) {
+        if (value < node->value) node = node->left;
+        else if (value > node->value) node = node->right;
+        else return true;
+    }
+    return false;
+}
+
+bool Treap::findSilent(int value)
+{
+    return TreeView::search(m_root, value, m_stats) != nullptr;
+}
+
+// --- Recursive Algorithm Helpers ---
+
+Treap::TreeNode* Treap::insertRecursive(Treap::TreeNode* node, int value, bool& inserted, QList<QVariant>* history)
+{
+    if (node == nullptr) {
+        inserted = true;
+        TreeNode* newNode = new TreeNode(value, m_rng(), m_nextNodeId++);
+        return newNode;
+    }
+
+    m_stats.comparisons++;
+    if (history) record(history, "Comparing with " + QString::number(node->value), node);
+
+    if (value < node->value) {
+        node->left = insertRecursive(node->left, value, inserted, history);
+        // Restore heap order on the way back up
+        if (node->left->priority > node->priority) {
+            if (history) record(history, "Child " + QString::number(node->left->value) + " has higher priority. Performing Right rotation on "
+                   + QString::number(node->value), node->left, Qt::cyan);
+            node = rotateRight(node);
+        }
+    } else if (value > node->value) {
+        node->right = insertRecursive(node->right, value, inserted, history);
+        if (node->right->priority > node->priority) {
+            if (history) record(history, "Child " + QString::number(node->right->value) + " has higher priority. Performing Left rotation on "
+                   + QString::number(node->value), node->right, Qt::cyan);
+            node = rotateLeft(node);
+        }
+    } else {
+        if (history) record(history, "Value " + QString::number(value) + " already exists.", node, Qt::red);
+    }
+    return node;
+}
+
+Treap::TreeNode* Treap::removeRecursive(Treap::TreeNode* node, int value, bool& removed, QList<QVariant>* history)
+{
+    if (node == nullptr) {
+        return nullptr;
+    }
+
+    m_stats.comparisons++;
+    if (value < node->value) {
+        if (history) record(history, "Comparing with " + QString::number(node->value), node);
+        node->left = removeRecursive(node->left, value, removed, history);
+        return node;
+    }
+    if (value > node->value) {
+        if (history) record(history, "Comparing with " + QString::number(node->value), node);
+        node->right = removeRecursive(node->right, value, removed, history);
+        return node;
+    }
+
+    // Found: a leaf or single-child node is spliced out directly
+    if (!node->left || !node->right) {
+        if (history) record(history, "Removing node " + QString::number(value), node, Qt::red);
+        TreeNode* child = node->left ? node->left : node->right;
+        delete node;
+        removed = true;
+        return child;
+    }
+
+    // Otherwise rotate the higher-priority child up and keep sinking the node
+    if (history) record(history, "Sinking " + QString::number(value) + " below its higher-priority child", node, Qt::red);
+    if (node->left->priority > node->right->priority) {
+        node = rotateRight(node);
+        node->right = removeRecursive(node->right, value, removed, history);
+    } else {
+        node = rotateLeft(node);
+        node->left = removeRecursive(node->left, value, removed, history);
+    }
+    return node;
+}
+
+Treap::TreeNode* Treap::rotateRight(Treap::TreeNode* y)
+{
+    m_stats.rotations++;
+    TreeNode* x = y->left;
+    y->left = x->right;
+    x->right = y;
+    return x;
+}
+
+Treap::TreeNode* Treap::rotateLeft(Treap::TreeNode* x)
+{
+    m_stats.rotations++;
+    TreeNode* y = x->right;
+    x->right = y->left;
+    y->left = x;
+    return y;
+}
+
+// --- Visualization Helpers ---
+
+void Treap::record(QList<QVariant>* history, const QString& message, const Treap::TreeNode* highlight, QColor color)
+{
+    // Callers test 'history' first, so silent runs never build the message strings
+    if (!history) return;
+    GraphStep step = createSnapshot(message);
+    if (highlight) TreeView::highlightNode(step, highlight->id, color);
+    history->append(QVariant::fromValue(step));
+}
+
+GraphStep Treap::createSnapshot(const QString& message)
+{
+    TreeView::updatePositions(m_root);
+
+    GraphStep step;
+    step.statusMessage = message;
+    TreeView::populateSnapshot(m_root, step);
+    return step;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "datastructures.h"
+#include "treeview.h"
+#include <QList>
+#include <QVariant>
+#include <random>
+
+// Randomized BST: keys are in BST order, random priorities are in max-heap order.
+class Treap
+{
+public:
+    explicit Treap(unsigned seed = 5489u);
+    ~Treap();
+
+    // Public methods that generate and return a step-by-step history
+    QList<QVariant> insert(int value);
+    QList<QVariant> remove(int value);
+    QList<QVariant> find(int value);
+    void clear(); // Resets the tree
+
+    // Native operations (no history), used for benchmarking
+    bool insertSilent(int value);
+    bool removeSilent(int value);
+    bool contains(int value) const;
+    bool findSilent(int value); // Like contains(), but counts comparisons and path length
+
+    // Counters accumulate until reset; insert/remove reset them first
+    const TreeStats& stats() const { return m_stats; }
+    void resetStats() { m_stats = TreeStats(); }
+
+private:
+    // --- Core Tree Structure ---
+    struct TreeNode {
+        int value;
+        TreeNode *left;
+        TreeNode *right;
+        unsigned priority;
+
+        int id;         // Unique ID for visualization
+        QPointF pos;    // Position on canvas
+        int level;      // Tree level (0 for root)
+
+        TreeNode(int v, unsigned p, int i)
+            : value(v), left(nullptr), right(nullptr), priority(p),
+            id(i), pos(), level(0) {}
+    };
+
+    TreeNode* m_root;
+    int m_nextNodeId;
+    TreeStats m_stats;
+    std::mt19937 m_rng;
+
+    // --- Recursive Algorithm Helpers (history may be null, in which case nothing is recorded) ---
+    TreeNode* insertRecursive(TreeNode* node, int value, bool& inserted, QList<QVariant>* history);
+    TreeNode* removeRecursive(TreeNode* node, int value, bool& removed, QList<QVariant>* history);
+    TreeNode* rotateRight(TreeNode* y);
+    TreeNode* rotateLeft(TreeNode* x);
+
+    // --- Visualization Helpers ---
+    void record(QList<QVariant>* history, const QString& message, const TreeNode* highlight = nullptr, QColor color = Qt::yellow);
+    GraphStep createSnapshot(const QString& message);
+};
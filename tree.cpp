@@ -76,6 +76,88 @@ QList<QVariant> BST::remove(int value)
     return history;
 }
 
+QList<QVariant> BST::find(int value)
+{
+    QList<QVariant> history;
+    history.append(QVariant::fromValue(createSnapshot("Searching for " + QString::number(value))));
+
+    int pathLength = 0;
+    TreeNode* node = m_root;
+    while (node) {
+        pathLength++;
+        if (value == node->value) break;
+
+        GraphStep step = createSnapshot("Comparing with " + QString::number(node->value));
+        highlightNode(step, node->id, Qt::yellow);
+        history.append(QVariant::fromValue(step));
+        node = (value < node->value) ? node->left : node->right;
+    }
+
+    QString summary = "Path length: " + QString::number(pathLength);
+    if (node) {
+        GraphStep step = createSnapshot("Found " + QString::number(value) + ". " + summary);
+        highlightNode(step, node->id, Qt::green);
+        history.append(QVariant::fromValue(step));
+    } else {
+        history.append(QVariant::fromValue(createSnapshot("Value " + QString::number(value) + " not found. " + summary)));
+    }
+    return history;
+}
+
+// --- Batched Operations ---
+
+QList<QVariant> BST::bulkLoad(const QVector<int>& sortedValues)
+{
+    clear();
+
+    // Drop duplicates in a single pass (input is already sorted)
+    QVector<int> keys;
+    keys.reserve(sortedValues.size());
+    for (int v : sortedValues) {
+        if (keys.isEmpty() || keys.last() != v) keys.append(v);
+    }
+
+    m_root = buildBalanced(keys, 0, keys.size() - 1);
+    updatePositions();
+
+    QList<QVariant> history;
+    GraphStep step = createSnapshot("Bulk loaded " + QString::number(keys.size()) + " keys from sorted input");
+    highlightNewNodes(step, 0, Qt::green);
+    history.append(QVariant::fromValue(step));
+    return history;
+}
+
+QList<QVariant> BST::insertBatch(const QVector<int>& values)
+{
+    int firstNewId = m_nextNodeId;
+    int inserted = 0;
+    for (int v : values) {
+        if (insertSilent(v)) inserted++;
+    }
+    updatePositions();
+
+    QList<QVariant> history;
+    GraphStep step = createSnapshot("Batch inserted " + QString::number(inserted) + " keys ("
+                                    + QString::number(values.size() - inserted) + " duplicates skipped)");
+    highlightNewNodes(step, firstNewId, Qt::green);
+    history.append(QVariant::fromValue(step));
+    return history;
+}
+
+QList<QVariant> BST::removeBatch(const QVector<int>& values)
+{
+    int removed = 0;
+    for (int v : values) {
+        if (removeSilent(v)) removed++;
+    }
+    updatePositions();
+
+    QList<QVariant> history;
+    history.append(QVariant::fromValue(createSnapshot("Batch removed " + QString::number(removed) + " keys ("
+                                                      + QString::number(values.size() - removed) + " not found)")));
+    return history;
+}
+
 // --- Recursive Algorithm Helpers ---
 
 BST::TreeNode* BST::insertRecursive(TreeNode* node, int value, int level, QPointF pos, TreeNode* parent, QList<QVariant>& history)
@@ -201,6 +283,57 @@ BST::TreeNode* BST::findMin(TreeNode* node)
 }
 
 
+// --- Silent Helpers ---
+
+BST::TreeNode* BST::buildBalanced(const QVector<int>& values, int lo, int hi)
+{
+    if (lo > hi) return nullptr;
+
+    // The middle key becomes the subtree root, so depth stays at log2(n)
+    int mid = lo + (hi - lo) / 2;
+    TreeNode* node = new TreeNode(values[mid], m_nextNodeId++, 0, QPointF());
+    node->left = buildBalanced(values, lo, mid - 1);
+    node->right = buildBalanced(values, mid + 1, hi);
+    return node;
+}
+
+bool BST::insertSilent(int value)
+{
+    // Iterative so that degenerate (sorted) batches cannot overflow the stack
+    TreeNode** link = &m_root;
+    while (*link) {
+        if (value < (*link)->value) link = &(*link)->left;
+        else if (value > (*link)->value) link = &(*link)->right;
+        else return false;
+    }
+    *link = new TreeNode(value, m_nextNodeId++, 0, QPointF());
+    return true;
+}
+
+bool BST::removeSilent(int value)
+{
+    TreeNode** link = &m_root;
+    while (*link && (*link)->value != value) {
+        link = (value < (*link)->value) ? &(*link)->left : &(*link)->right;
+    }
+    if (!*link) return false;
+
+    TreeNode* node = *link;
+    if (node->left && node->right) {
+        // Splice out the inorder successor and move its value up
+        TreeNode** succLink = &node->right;
+        while ((*succLink)->left) succLink = &(*succLink)->left;
+        TreeNode* succ = *succLink;
+        node->value = succ->value;
+        *succLink = succ->right;
+        delete succ;
+    } else {
+        *link = node->left ? node->left : node->right;
+        delete node;
+    }
+    return true;
+}
+
 // --- Visualization & Layout Helpers ---
 
 void BST::updatePositions()
@@ -272,3 +405,12 @@ void BST::highlightNode(GraphStep& step, int nodeId, QColor color)
         }
     }
 }
+
+void BST::highlightNewNodes(GraphStep& step, int firstNewId, QColor color)
+{
+    for (NodeState& ns : step.nodes) {
+        if (ns.id >= firstNewId) {
+            ns.color = color;
+        }
+    }
+}
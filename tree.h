@@ -12,8 +12,14 @@ public:
 
     QList<QVariant> insert(int value);
     QList<QVariant> remove(int value);
+    QList<QVariant> find(int value);
     void clear();
 
+    // Batched operations: apply many keys at once and record a single summary step
+    QList<QVariant> bulkLoad(const QVector<int>& sortedValues); // O(n) build from sorted input
+    QList<QVariant> insertBatch(const QVector<int>& values);
+    QList<QVariant> removeBatch(const QVector<int>& values);
+
 private:
     // --- Core Tree Structure ---
     struct TreeNode {
@@ -38,6 +44,11 @@ private:
     TreeNode* removeRecursive(TreeNode* node, int value, QList<QVariant>& history);
     TreeNode* findMin(TreeNode* node);
 
+    // --- Silent Helpers (no history, used by the batched operations) ---
+    TreeNode* buildBalanced(const QVector<int>& values, int lo, int hi);
+    bool insertSilent(int value);
+    bool removeSilent(int value);
+
     GraphStep createSnapshot(const QString& message);
     void populateSnapshot(TreeNode* node, GraphStep& step);
 
@@ -47,6 +58,9 @@ private:
     // Highlights a single node in a snapshot
     void highlightNode(GraphStep& step, int nodeId, QColor color);
 
+    // Highlights every node created since firstNewId in a single pass
+    void highlightNewNodes(GraphStep& step, int firstNewId, QColor color);
+
     // Highlights a node and its connection to its parent
     void highlightEdge(GraphStep& step, TreeNode* node, TreeNode* parent, QColor color);
 };
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "datastructures.h"
+#include <QQueue>
+
+// Per-operation counters reported by the balanced trees
+struct TreeStats {
+    long long rotations = 0;
+    long long recolors = 0;
+    long long comparisons = 0;
+    long long pathLength = 0; // Nodes visited by find()
+};
+
+// Layout, snapshot and highlight helpers shared by the pointer-based trees.
+// Node types need value, left, right, id, pos and level members.
+namespace TreeView
+{
+const int LEVEL_HEIGHT = 80;
+const int CANVAS_WIDTH = 1200;
+
+template <typename Node>
+void updatePositionsRecursive(Node* node, int level, double x, double xOffset)
+{
+    if (node == nullptr) {
+        return;
+    }
+    // Set the node's position based on its level and x-offset
+    node->pos = QPointF(x, 50 + level * LEVEL_HEIGHT);
+    node->level = level;
+
+    // Recurse for children, halving the x-offset each time
+    updatePositionsRecursive(node->left, level + 1, x - xOffset, xOffset / 2.0);
+    updatePositionsRecursive(node->right, level + 1, x + xOffset, xOffset / 2.0);
+}
+
+template <typename Node>
+void updatePositions(Node* root)
+{
+    if (!root) return;
+    updatePositionsRecursive(root, 0, CANVAS_WIDTH / 2.0, CANVAS_WIDTH / 4.0);
+}
+
+// 'style' receives each node and its NodeState, so trees can color nodes by
+// their own balancing state (e.g. red-black colors) before highlights apply.
+template <typename Node, typename StyleFn>
+void populateSnapshot(const Node* node, GraphStep& step, StyleFn style)
+{
+    if (node == nullptr) {
+        return;
+    }
+
+    // 1. Add this node
+    NodeState ns;
+    ns.id = node->id;
+    ns.label = QString::number(node->value);
+    ns.position = node->pos; // Use the pre-calculated position
+    style(node, ns);
+    step.nodes.append(ns);
+
+    // 2. Add edges to the children
+    for (const Node* child : {node->left, node->right}) {
+        if (child) {
+            EdgeState es;
+            es.fromId = node->id;
+            es.toId = child->id;
+            step.edges.append(es);
+            populateSnapshot(child, step, style); // Recurse
+        }
+    }
+}
+
+template <typename Node>
+void populateSnapshot(const Node* node, GraphStep& step)
+{
+    populateSnapshot(node, step, [](const Node*, NodeState&) {});
+}
+
+inline void highlightNode(GraphStep& step, int nodeId, QColor color, QColor textColor = Qt::black)
+{
+    for (NodeState& ns : step.nodes) {
+        if (ns.id == nodeId) {
+            ns.color = color;
+            ns.textColor = textColor;
+            return;
+        }
+    }
+}
+
+// Plain BST descent for find(), counting comparisons and visited nodes
+template <typename Node>
+Node* search(Node* root, int value, TreeStats& stats)
+{
+    Node* node = root;
+    while (node) {
+        stats.comparisons++;
+        stats.pathLength++;
+        if (value < node->value) node = node->left;
+        else if (value > node->value) node = node->right;
+        else break;
+    }
+    return node;
+}
+
+// Non-recursive delete of a whole tree
+template <typename Node>
+void destroy(Node* root)
+{
+    if (!root) return;
+    QQueue<Node*> queue;
+    queue.enqueue(root);
+    while (!queue.isEmpty()) {
+        Node* node = queue.dequeue();
+        if (node->left) queue.enqueue(node->left);
+        if (node->right) queue.enqueue(node->right);
+        delete node;
+    }
+}
+
+inline QString statsText(const TreeStats& stats)
+{
+    return "Rotations: " + QString::number(stats.rotations)
+           + ", Recolors: " + QString::number(stats.recolors)
+           + ", Comparisons: " + QString::number(stats.comparisons);
+}
+}
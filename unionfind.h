@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QVector>
+#include <utility>
+
+// Disjoint sets over items 0..count-1 with union by rank and path halving,
+// so any sequence of operations runs in near-constant amortized time each.
+class UnionFind
+{
+public:
+    explicit UnionFind(int count = 0) { reset(count); }
+
+    void reset(int count)
+    {
+        m_parent.resize(count);
+        for (int i = 0; i < count; ++i) m_parent[i] = i;
+        m_rank.fill(0, count);
+        m_sets = count;
+    }
+
+    int find(int item)
+    {
+        while (m_parent[item] != item) {
+            m_parent[item] = m_parent[m_parent[item]]; // Halve the path on the way up
+            item = m_parent[item];
+        }
+        return item;
+    }
+
+    // Root of 'item' without shortening any path, safe to call from several threads at once
+    int findRoot(int item) const
+    {
+        while (m_parent[item] != item) item = m_parent[item];
+        return item;
+    }
+
+    // Joins the sets of a and b; false if they were already one set
+    bool unite(int a, int b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (m_rank[a] < m_rank[b]) std::swap(a, b);
+        m_parent[b] = a;
+        if (m_rank[a] == m_rank[b]) m_rank[a]++;
+        m_sets--;
+        return true;
+    }
+
+    int setCount() const { return m_sets; }
+
+private:
+    QVector<int> m_parent;
+    QVector<char> m_rank; // Rank never exceeds log2(count)
+    int m_sets = 0;
+};
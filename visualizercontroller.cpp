@@ -1,25 +1,91 @@
 #include "visualizercontroller.h"
 #include "sorting.h"
+#include "search.h"
 #include "tree.h"
 #include "avl.h"
+#include "btree.h"
+#include "rbtree.h"
+#include "treap.h"
+#include "splay.h"
+#include "workload.h"
 #include "graph.h"
+#include "benchmark.h"
 #include <QRandomGenerator>
 #include <algorithm>
 #include <QStringList>
+#include <QElapsedTimer>
+#include <QtConcurrent>
 #include <random>
 
+// Per-key animations record a full history for every value, so they stay small.
+// The bulk and batch modes record one step per operation and can use far more keys.
+const int ANIMATED_TREE_SIZE = 15;
+const int LARGE_TREE_SIZE = 1000000;
+const int BTREE_ORDER = 4; // Small fan-out so splits and merges happen often on screen
+const int FIND_ACCESS_COUNT = 8; // Skewed lookups animated by the "Find" entries
+const int LAYOUT_FRAME_MS = 30;  // Force layout time per timer tick, so large graphs stay responsive
+const int ELLER_ROWS_PER_TICK = 1; // Rows of cells an Eller maze grows by per timer tick
+
+namespace
+{
+// Runs on a worker thread: benchmarks build everything they time themselves
+// and share nothing with the controller
+QStringList runBenchmark(const QString& algName)
+{
+    QStringList report;
+    if (algName == "Benchmark: B-Tree vs AVL") report = Benchmark::treeLookups();
+    else if (algName == "Benchmark: Balancing Schemes") report = Benchmark::balancingSchemes();
+    else if (algName == "Benchmark: Access Patterns") report = Benchmark::accessPatterns();
+    else if (algName == "Benchmark: Search Layouts") report = Benchmark::searchLayouts();
+    else if (algName == "Benchmark: CSR Graph") report = Benchmark::csrGraph();
+    else if (algName == "Benchmark: Graph Generators") report = Benchmark::graphGenerators();
+    else if (algName == "Benchmark: Graph Loader") report = Benchmark::graphLoader();
+    else if (algName == "Benchmark: Shortest Paths") report = Benchmark::shortestPaths();
+    else if (algName == "Benchmark: Parallel BFS") report = Benchmark::parallelBfs();
+    else if (algName == "Benchmark: Delta-Stepping") report = Benchmark::deltaStepping();
+    else if (algName == "Benchmark: Spanning Trees") report = Benchmark::spanningTrees();
+    else if (algName == "Benchmark: Components") report = Benchmark::components();
+    else if (algName == "Benchmark: Floyd-Warshall") report = Benchmark::floydWarshall();
+    else if (algName == "Benchmark: Contraction Hierarchy") report = Benchmark::contractionHierarchy();
+    else if (algName == "Benchmark: Dynamic Updates") report = Benchmark::dynamicUpdates();
+    else if (algName == "Benchmark: Batch Queries") report = Benchmark::batchQueries();
+    else if (algName == "Benchmark: Max Flow") report = Benchmark::maxFlow();
+    else if (algName == "Benchmark: PageRank") report = Benchmark::pageRank();
+    else if (algName == "Benchmark: Force Layout") report = Benchmark::forceLayout();
+    else if (algName == "Benchmark: Maze History") report = Benchmark::mazeHistory();
+    else if (algName == "Benchmark: Eller Maze") report = Benchmark::ellerMaze();
+
+    return report;
+}
+} // namespace
+
 VisualizerController::VisualizerController(QObject *parent)
     : QObject(parent),
     m_currentStep(0),
     m_timerInterval(200),
-    m_graphGenerated(false)
+    m_mazeWidth(41),
+    m_mazeHeight(25),
+    m_graphGenerated(false),
+    m_layoutRunning(false),
+    m_mazeStreaming(false)
 {
     m_timer = new QTimer(this);
     m_timer->setInterval(m_timerInterval);
     connect(m_timer, &QTimer::timeout, this, &VisualizerController::onTimerTick);
+
+    m_benchmarkWatcher = new QFutureWatcher<QStringList>(this);
+    connect(m_benchmarkWatcher, &QFutureWatcher<QStringList>::finished, this, &VisualizerController::onBenchmarkFinished);
     generateRandomData();
 }
 
+void VisualizerController::onBenchmarkFinished()
+{
+    emit logMessage("--------------------------------");
+    for (const QString& line : m_benchmarkWatcher->result()) emit logMessage(line);
+    emit logMessage("--------------------------------");
+    emit benchmarkRunning(false);
+}
+
 void VisualizerController::generateRandomData()
 {
     m_randomData.clear();
@@ -28,11 +94,21 @@ void VisualizerController::generateRandomData()
     }
 }
 
+// Zipfian picks from 'keys', so a few hot keys repeat across the animated finds
+QVector<int> VisualizerController::skewedLookups(const QVector<int>& keys, unsigned seed) const
+{
+    QVector<int> lookups;
+    for (int index : Workload::zipfian(FIND_ACCESS_COUNT, keys.size(), 1.0, seed)) lookups.append(keys[index]);
+    return lookups;
+}
+
 void VisualizerController::onShuffle()
 {
     m_timer->stop();
     generateRandomData();
     m_graphGenerated = false;
+    m_layoutRunning = false;
+    m_mazeStreaming = false;
 }
 
 void VisualizerController::onStart() { if (!m_stepHistory.isEmpty()) m_timer->start(); }
@@ -44,6 +120,14 @@ void VisualizerController::onStop() {
 }
 void VisualizerController::onNext() {
     m_timer->stop();
+    if (m_layoutRunning) {
+        advanceLayout();
+        return;
+    }
+    if (m_mazeStreaming) {
+        advanceMazeStream();
+        return;
+    }
     if (m_currentStep < m_stepHistory.size() - 1) {
         m_currentStep++;
         emit requestRedraw(m_stepHistory[m_currentStep]);
@@ -62,9 +146,35 @@ void VisualizerController::onAlgorithmSelected(const QString& algName)
     m_timer->stop();
     m_stepHistory.clear();
     m_currentStep = 0;
+    m_layoutRunning = false;
+    m_mazeStreaming = false;
+
+    // --- BENCHMARKS (native mode, on a worker thread; results go to the log) ---
+    if (algName.startsWith("Benchmark"))
+    {
+        if (m_benchmarkWatcher->isRunning()) {
+            emit logMessage("A benchmark is already running.");
+            return;
+        }
+        emit logMessage("Running " + algName.mid(11) + "...");
+        emit benchmarkRunning(true);
+        m_benchmarkWatcher->setFuture(QtConcurrent::run([algName]() { return runBenchmark(algName); }));
+    }
+    // --- SEARCHING (on the sorted shared data) ---
+    else if (algName.endsWith("Search"))
+    {
+        QVector<int> sorted = m_randomData;
+        std::sort(sorted.begin(), sorted.end());
+        int target = m_randomData[QRandomGenerator::global()->bounded(m_randomData.size())];
 
+        if (algName == "Binary Search") m_stepHistory = Searching::binarySearch(sorted, target);
+        else if (algName == "Branchless Binary Search") m_stepHistory = Searching::branchlessBinarySearch(sorted, target);
+        else if (algName == "Interpolation Search") m_stepHistory = Searching::interpolationSearch(sorted, target);
+        else if (algName == "Eytzinger Search") m_stepHistory = Searching::eytzingerSearch(sorted, target);
+        else if (algName == "van Emde Boas Search") m_stepHistory = Searching::vebSearch(sorted, target);
+    }
     // --- SORTING ---
-    if (algName.contains("Sort"))
+    else if (algName.contains("Sort"))
     {
         QVector<int> dataCopy = m_randomData;
         if (algName == "Bubble Sort") m_stepHistory = Sorting::bubbleSort(dataCopy);
@@ -73,10 +183,94 @@ void VisualizerController::onAlgorithmSelected(const QString& algName)
         else if (algName == "Quick Sort") m_stepHistory = Sorting::quickSort(dataCopy);
         else if (algName == "Merge Sort") m_stepHistory = Sorting::mergeSort(dataCopy);
     }
+    // --- BALANCING SCHEMES (red-black, treap and splay trees) ---
+    else if (algName.startsWith("Red-Black") || algName.startsWith("Treap") || algName.startsWith("Splay")
+             || algName.startsWith("Compare"))
+    {
+        int treeSize = qMin(ANIMATED_TREE_SIZE, m_randomData.size());
+        QVector<int> treeData = m_randomData.mid(0, treeSize);
+        QVector<int> removalOrder = treeData;
+        std::random_device rd;
+        std::mt19937 g(rd());
+        std::shuffle(removalOrder.begin(), removalOrder.end(), g);
+        QVector<int> findKeys = skewedLookups(treeData, rd());
+
+        if (algName == "Red-Black Insert") {
+            m_rbTree.clear();
+            for (int v : treeData) m_stepHistory.append(m_rbTree.insert(v));
+        }
+        else if (algName == "Red-Black Remove") {
+            m_rbTree.clear();
+            for (int v : treeData) m_rbTree.insertSilent(v);
+            for (int v : removalOrder) m_stepHistory.append(m_rbTree.remove(v));
+        }
+        else if (algName == "Treap Insert") {
+            m_treap.clear();
+            for (int v : treeData) m_stepHistory.append(m_treap.insert(v));
+        }
+        else if (algName == "Treap Remove") {
+            m_treap.clear();
+            for (int v : treeData) m_treap.insertSilent(v);
+            for (int v : removalOrder) m_stepHistory.append(m_treap.remove(v));
+        }
+        else if (algName == "Red-Black Find") {
+            m_rbTree.clear();
+            for (int v : treeData) m_rbTree.insertSilent(v);
+            for (int v : findKeys) m_stepHistory.append(m_rbTree.find(v));
+        }
+        else if (algName == "Treap Find") {
+            m_treap.clear();
+            for (int v : treeData) m_treap.insertSilent(v);
+            for (int v : findKeys) m_stepHistory.append(m_treap.find(v));
+        }
+        else if (algName == "Splay Insert") {
+            m_splay.clear();
+            for (int v : treeData) m_stepHistory.append(m_splay.insert(v));
+        }
+        else if (algName == "Splay Remove") {
+            m_splay.clear();
+            for (int v : treeData) m_splay.insertSilent(v);
+            for (int v : removalOrder) m_stepHistory.append(m_splay.remove(v));
+        }
+        else if (algName == "Splay Find") {
+            // Repeated hot keys end up near the root, so later finds get shorter
+            m_splay.clear();
+            for (int v : treeData) m_splay.insertSilent(v);
+            for (int v : findKeys) m_stepHistory.append(m_splay.find(v));
+        }
+        else if (algName == "Compare: AVL vs Red-Black vs Treap") {
+            // Same key stream through all three trees; only the totals are shown
+            m_avl.clear();
+            m_rbTree.clear();
+            m_treap.clear();
+            m_avl.resetStats();
+            m_rbTree.resetStats();
+            m_treap.resetStats();
+            for (int v : m_randomData) {
+                m_avl.insertSilent(v);
+                m_rbTree.insertSilent(v);
+                m_treap.insertSilent(v);
+            }
+            for (int v : removalOrder) {
+                m_avl.removeSilent(v);
+                m_rbTree.removeSilent(v);
+                m_treap.removeSilent(v);
+            }
+
+            emit logMessage("--------------------------------");
+            emit logMessage("Inserted " + QString::number(m_randomData.size()) + " keys, removed "
+                            + QString::number(removalOrder.size()));
+            emit logMessage("AVL: " + TreeView::statsText(m_avl.stats()));
+            emit logMessage("Red-Black: " + TreeView::statsText(m_rbTree.stats()));
+            emit logMessage("Treap: " + TreeView::statsText(m_treap.stats()));
+            emit logMessage("--------------------------------");
+        }
+    }
+
     // --- TREES ---
     else if (algName.contains("BST") || algName.contains("AVL"))
     {
-        int treeSize = qMin(15, m_randomData.size());
+        int treeSize = qMin(ANIMATED_TREE_SIZE, m_randomData.size());
         QVector<int> treeData = m_randomData.mid(0, treeSize);
 
         // Prepare a random engine for shuffling
@@ -109,6 +303,90 @@ void VisualizerController::onAlgorithmSelected(const QString& algName)
 
             for (int v : removalOrder) m_stepHistory.append(m_avl.remove(v));
         }
+        else if (algName == "BST Find") {
+            m_bst.clear();
+            for (int v : treeData) m_bst.insert(v);
+            for (int v : skewedLookups(treeData, rd())) m_stepHistory.append(m_bst.find(v));
+        }
+        else if (algName == "AVL Find") {
+            m_avl.clear();
+            for (int v : treeData) m_avl.insertSilent(v);
+            for (int v : skewedLookups(treeData, rd())) m_stepHistory.append(m_avl.find(v));
+        }
+        else if (algName == "BST Bulk Load" || algName == "AVL Bulk Load") {
+            QVector<int> sorted = m_randomData;
+            std::sort(sorted.begin(), sorted.end());
+
+            if (algName == "BST Bulk Load") m_stepHistory = m_bst.bulkLoad(sorted);
+            else m_stepHistory = m_avl.bulkLoad(sorted);
+        }
+        else if (algName == "AVL Bulk Load (1M keys)") {
+            QVector<int> sorted(LARGE_TREE_SIZE);
+            for (int i = 0; i < LARGE_TREE_SIZE; ++i) sorted[i] = i;
+
+            QElapsedTimer timer;
+            timer.start();
+            m_stepHistory = m_avl.bulkLoad(sorted);
+
+            emit logMessage("--------------------------------");
+            emit logMessage("Bulk loaded " + QString::number(LARGE_TREE_SIZE) + " keys in "
+                            + QString::number(timer.elapsed()) + " ms (including snapshot)");
+            emit logMessage("--------------------------------");
+        }
+        else if (algName == "BST Batch" || algName == "AVL Batch") {
+            // One summarized step for the insert batch, one for removing a random half
+            QVector<int> removalBatch = m_randomData;
+            std::shuffle(removalBatch.begin(), removalBatch.end(), g);
+            removalBatch.resize(removalBatch.size() / 2);
+
+            if (algName == "BST Batch") {
+                m_bst.clear();
+                m_stepHistory.append(m_bst.insertBatch(m_randomData));
+                m_stepHistory.append(m_bst.removeBatch(removalBatch));
+            } else {
+                m_avl.clear();
+                m_stepHistory.append(m_avl.insertBatch(m_randomData));
+                m_stepHistory.append(m_avl.removeBatch(removalBatch));
+            }
+        }
+    }
+
+    // --- B-TREE ---
+    else if (algName.startsWith("B-Tree"))
+    {
+        int treeSize = qMin(ANIMATED_TREE_SIZE, m_randomData.size());
+        QVector<int> treeData = m_randomData.mid(0, treeSize);
+
+        if (algName == "B-Tree Insert") {
+            m_btree.setOrder(BTREE_ORDER);
+            for (int v : treeData) m_stepHistory.append(m_btree.insert(v));
+        }
+        else if (algName == "B-Tree Remove") {
+            m_btree.setOrder(BTREE_ORDER);
+            for (int v : treeData) m_btree.insertSilent(v);
+            QVector<int> removalOrder = treeData;
+
+            std::random_device rd;
+            std::mt19937 g(rd());
+            std::shuffle(removalOrder.begin(), removalOrder.end(), g);
+
+            for (int v : removalOrder) m_stepHistory.append(m_btree.remove(v));
+        }
+        else if (algName == "B-Tree Find") {
+            m_btree.setOrder(BTREE_ORDER);
+            for (int v : treeData) m_btree.insertSilent(v);
+            std::random_device rd;
+            for (int v : skewedLookups(treeData, rd())) m_stepHistory.append(m_btree.find(v));
+        }
+        else if (algName == "B-Tree Range Scan") {
+            QVector<int> sorted = m_randomData;
+            std::sort(sorted.begin(), sorted.end());
+            m_btree.setOrder(BTREE_ORDER);
+            m_stepHistory = m_btree.bulkLoad(sorted);
+
+            int low = QRandomGenerator::global()->bounded(1, 50);
+            m_stepHistory.append(m_btree.rangeScan(low, low + 30));
+        }
     }
 
     // --- GRAPHS ---
@@ -117,36 +395,62 @@ void VisualizerController::onAlgorithmSelected(const QString& algName)
         int nodeCount = 50;
 
         if (algName == "Graph Generate") {
-            m_stepHistory = m_graph.generateRandomGraph(nodeCount);
+            unsigned seed = QRandomGenerator::global()->generate();
+            emit logMessage("Graph seed: " + QString::number(seed));
+            m_stepHistory = m_graph.generateRandomGraph(nodeCount, seed);
             m_graphGenerated = true;
         }
         else {
             if (!m_graphGenerated) {
-                m_graph.generateRandomGraph(nodeCount);
+                unsigned seed = QRandomGenerator::global()->generate();
+                emit logMessage("Graph seed: " + QString::number(seed));
+                m_graph.generateRandomGraph(nodeCount, seed);
                 m_graphGenerated = true;
             }
 
-            int startNode = QRandomGenerator::global()->bounded(0, nodeCount);
+            int graphSize = m_graph.csr().nodeCount; // A loaded graph may differ from nodeCount
+            int startNode = QRandomGenerator::global()->bounded(0, graphSize);
 
             if (algName == "Graph BFS") {
                 m_stepHistory = m_graph.bfs(startNode);
             }
+            else if (algName == "Graph Parallel BFS") {
+                m_stepHistory = m_graph.parallelBfs(startNode);
+            }
             else if (algName == "Graph DFS") {
                 m_stepHistory = m_graph.dfs(startNode);
             }
-            else if (algName == "Graph Dijkstra") {
+            else if (algName == "Graph Strongly Connected Components") {
+                m_stepHistory = m_graph.stronglyConnectedComponents();
+            }
+            else if (algName == "Graph Connected Components") {
+                m_stepHistory = m_graph.connectedComponents();
+            }
+            else if (algName == "Graph Dijkstra" || algName == "Graph A*" || algName == "Graph Bidirectional Dijkstra"
+                     || algName == "Graph Contraction Hierarchy") {
                 int endNode = startNode;
-                while(endNode == startNode) {
-                    endNode = QRandomGenerator::global()->bounded(0, nodeCount);
+                while(endNode == startNode && graphSize > 1) {
+                    endNode = QRandomGenerator::global()->bounded(0, graphSize);
                 }
 
                 emit logMessage("--------------------------------");
-                emit logMessage("Goal: Dijkstra's Pathfinding");
+                emit logMessage("Goal: " + algName.mid(6) + " Pathfinding");
                 emit logMessage("Start Node: " + QString::number(startNode));
                 emit logMessage("Target Node: " + QString::number(endNode));
                 emit logMessage("--------------------------------");
 
-                m_stepHistory = m_graph.dijkstra(startNode, endNode);
+                if (algName == "Graph Dijkstra") m_stepHistory = m_graph.dijkstra(startNode, endNode);
+                else if (algName == "Graph A*") m_stepHistory = m_graph.aStar(startNode, endNode);
+                else if (algName == "Graph Bidirectional Dijkstra") m_stepHistory = m_graph.bidirectionalDijkstra(startNode, endNode);
+                else m_stepHistory = m_graph.contractionHierarchy(startNode, endNode);
+            }
+            else if (algName == "Graph Delta-Stepping") {
+                emit logMessage("--------------------------------");
+                emit logMessage("Goal: Delta-Stepping Shortest Path Tree");
+                emit logMessage("Start Node: " + QString::number(startNode));
+                emit logMessage("--------------------------------");
+
+                m_stepHistory = m_graph.deltaStepping(startNode);
             }
             else if (algName == "Graph Prim's MST") {
                 emit logMessage("--------------------------------");
@@ -156,16 +460,113 @@ void VisualizerController::onAlgorithmSelected(const QString& algName)
 
                 m_stepHistory = m_graph.primMST(startNode);
             }
+            else if (algName == "Graph Floyd-Warshall") {
+                m_stepHistory = m_graph.floydWarshall();
+            }
+            else if (algName == "Graph Distance Table") {
+                m_stepHistory = m_graph.distanceTable();
+            }
+            else if (algName == "Graph PageRank") {
+                m_stepHistory = m_graph.pageRank();
+            }
+            else if (algName == "Graph Personalized PageRank") {
+                emit logMessage("--------------------------------");
+                emit logMessage("Goal: Personalized PageRank");
+                emit logMessage("Seed Node: " + QString::number(startNode));
+                emit logMessage("--------------------------------");
+
+                m_stepHistory = m_graph.personalizedPageRank(startNode);
+            }
+            else if (algName == "Graph Label Propagation") {
+                m_stepHistory = m_graph.labelPropagation();
+            }
+            else if (algName == "Graph Max Flow (Dinic)" || algName == "Graph Max Flow (Push-Relabel)") {
+                int sink = startNode;
+                while (sink == startNode && graphSize > 1) {
+                    sink = QRandomGenerator::global()->bounded(0, graphSize);
+                }
+
+                emit logMessage("--------------------------------");
+                emit logMessage("Goal: " + algName.mid(6));
+                emit logMessage("Source Node: " + QString::number(startNode));
+                emit logMessage("Sink Node: " + QString::number(sink));
+                emit logMessage("--------------------------------");
+
+                if (algName == "Graph Max Flow (Dinic)") m_stepHistory = m_graph.dinicMaxFlow(startNode, sink);
+                else m_stepHistory = m_graph.pushRelabelMaxFlow(startNode, sink);
+            }
+            else if (algName == "Graph Force Layout") {
+                emit logMessage("--------------------------------");
+                emit logMessage("Goal: Barnes-Hut Force-Directed Layout");
+                emit logMessage("Nodes: " + QString::number(graphSize));
+                emit logMessage("--------------------------------");
+
+                // Frames are computed as the timer asks for them; the history
+                // only ever holds the latest one
+                bool done = false;
+                m_graph.startForceLayout();
+                m_stepHistory.append(m_graph.forceLayoutFrame(0, &done));
+                m_layoutRunning = !done;
+            }
+            else if (algName == "Graph Insert Edge" || algName == "Graph Delete Edge" || algName == "Graph Reweight Edge") {
+                // Repairs the last Dijkstra and Prim results instead of rerunning them
+                int edgeCount = m_graph.csr().edgeCount;
+                int weight = QRandomGenerator::global()->bounded(1, 10);
+                if (algName == "Graph Insert Edge") {
+                    int endNode = startNode;
+                    while (endNode == startNode && graphSize > 1) {
+                        endNode = QRandomGenerator::global()->bounded(0, graphSize);
+                    }
+                    m_stepHistory = m_graph.insertEdge(startNode, endNode, weight);
+                }
+                else if (edgeCount == 0) {
+                    emit logMessage("The graph has no edges to change.");
+                }
+                else if (algName == "Graph Delete Edge") {
+                    m_stepHistory = m_graph.deleteEdge(QRandomGenerator::global()->bounded(0, edgeCount));
+                }
+                else {
+                    m_stepHistory = m_graph.reweightEdge(QRandomGenerator::global()->bounded(0, edgeCount), weight);
+                }
+            }
+            else if (algName == "Graph Kruskal's MST" || algName == "Graph Boruvka's MST") {
+                emit logMessage("--------------------------------");
+                emit logMessage("Goal: " + algName.mid(6));
+                emit logMessage("--------------------------------");
+
+                if (algName == "Graph Kruskal's MST") m_stepHistory = m_graph.kruskalMST();
+                else m_stepHistory = m_graph.boruvkaMST();
+            }
         }
     }
     // --- MAZE ---
     else if (algName == "Maze Generate") {
         emit logMessage("--------------------------------");
         emit logMessage("Goal: Recursive Backtracker Maze");
-        emit logMessage("Size: 41 x 25");
+        emit logMessage("Size: " + QString::number(m_mazeWidth) + " x " + QString::number(m_mazeHeight));
+        emit logMessage("--------------------------------");
+
+        unsigned seed = QRandomGenerator::global()->generate();
+        emit logMessage("Maze seed: " + QString::number(seed));
+        QElapsedTimer timer;
+        timer.start();
+        m_stepHistory = m_maze.generateRecursiveBacktracker(m_mazeWidth, m_mazeHeight, seed);
+        emit logMessage("Generated in " + QString::number(timer.elapsed()) + " ms, "
+                        + QString::number(m_stepHistory.size()) + " steps");
+    }
+    else if (algName == "Maze Eller (Streaming)") {
+        emit logMessage("--------------------------------");
+        emit logMessage("Goal: Eller's Algorithm Maze, one row at a time");
+        emit logMessage("Width: " + QString::number(m_mazeWidth) + ", showing the last "
+                        + QString::number(m_mazeHeight) + " rows");
         emit logMessage("--------------------------------");
 
-        m_stepHistory = m_maze.generateRecursiveBacktracker(41, 25);
+        unsigned seed = QRandomGenerator::global()->generate();
+        emit logMessage("Maze seed: " + QString::number(seed));
+        // Fill the view, then Start keeps adding rows until stopped
+        m_maze.startEller(m_mazeWidth, m_mazeHeight, seed);
+        m_stepHistory = {m_maze.ellerFrame(m_mazeHeight / 2)};
+        m_mazeStreaming = true;
     }
 
     if (!m_stepHistory.isEmpty()) {
@@ -173,11 +574,63 @@ void VisualizerController::onAlgorithmSelected(const QString& algName)
     }
 }
 
+void VisualizerController::onGraphFileSelected(const QString& path)
+{
+    m_timer->stop();
+    m_currentStep = 0;
+
+    QString error;
+    QElapsedTimer timer;
+    timer.start();
+    QList<QVariant> history = m_graph.loadFromFile(path, &error);
+    if (history.isEmpty()) {
+        emit logMessage("Failed to load graph: " + error);
+        return;
+    }
+    m_layoutRunning = false;
+    m_mazeStreaming = false;
+
+    emit logMessage("Parsed in " + QString::number(timer.elapsed()) + " ms");
+    m_stepHistory = history;
+    m_graphGenerated = true; // Graph algorithms now run on the loaded graph
+    emit requestRedraw(m_stepHistory[0]);
+}
+
 void VisualizerController::onSpeedChanged(int value) {
     m_timerInterval = 1005 - (value * 10);
     m_timer->setInterval(m_timerInterval);
 }
+
+void VisualizerController::onMazeSizeChanged(int width, int height)
+{
+    m_mazeWidth = width;
+    m_mazeHeight = height;
+}
+
+void VisualizerController::onMazeSaveRequested(const QString& path)
+{
+    unsigned seed = QRandomGenerator::global()->generate();
+    QString error;
+    QElapsedTimer timer;
+    timer.start();
+    if (!EllerMaze::saveAsPbm(path, m_mazeWidth, m_mazeHeight, seed, &error)) {
+        emit logMessage("Failed to save maze: " + error);
+        return;
+    }
+    emit logMessage("Saved a " + QString::number(m_mazeWidth) + " x " + QString::number(m_mazeHeight | 1)
+                    + " Eller maze (seed " + QString::number(seed) + ") to " + path + " in "
+                    + QString::number(timer.elapsed()) + " ms");
+}
+
 void VisualizerController::onTimerTick() {
+    if (m_layoutRunning) {
+        advanceLayout();
+        return;
+    }
+    if (m_mazeStreaming) {
+        advanceMazeStream();
+        return;
+    }
     if (m_currentStep < m_stepHistory.size() - 1) {
         m_currentStep++;
         emit requestRedraw(m_stepHistory[m_currentStep]);
@@ -185,3 +638,25 @@ void VisualizerController::onTimerTick() {
         m_timer->stop();
     }
 }
+
+// Runs the force layout for about one frame and shows where the nodes are now
+void VisualizerController::advanceLayout()
+{
+    bool done = false;
+    m_stepHistory = {m_graph.forceLayoutFrame(LAYOUT_FRAME_MS, &done)};
+    m_currentStep = 0;
+    emit requestRedraw(m_stepHistory[0]);
+    if (done) {
+        m_layoutRunning = false;
+        m_timer->stop();
+        emit logMessage(m_stepHistory[0].value<GraphStep>().statusMessage);
+    }
+}
+
+// Grows the Eller maze by a few rows and shows the view scrolled down to them
+void VisualizerController::advanceMazeStream()
+{
+    m_stepHistory = {m_maze.ellerFrame(ELLER_ROWS_PER_TICK)};
+    m_currentStep = 0;
+    emit requestRedraw(m_stepHistory[0]);
+}
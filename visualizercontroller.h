@@ -2,11 +2,16 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QFutureWatcher>
 #include <QList>
 #include <QVariant>
 #include <QVector>
 #include "tree.h"
 #include "avl.h"
+#include "btree.h"
+#include "rbtree.h"
+#include "treap.h"
+#include "splay.h"
 #include "graph.h"
 #include "maze.h"
 
@@ -20,6 +25,7 @@ public:
 signals:
     void requestRedraw(const QVariant& step);
     void logMessage(const QString& message);
+    void benchmarkRunning(bool running); // While true, no other benchmark can start
 
 public slots:
     void onStart();
@@ -31,25 +37,42 @@ public slots:
     void onShuffle();
 
     void onAlgorithmSelected(const QString& algName);
+    void onGraphFileSelected(const QString& path);
     void onSpeedChanged(int value);
+    void onMazeSizeChanged(int width, int height); // Used by the next maze entry or save
+    void onMazeSaveRequested(const QString& path);  // Streams an Eller maze of that size to a PBM file
 
 private slots:
     void onTimerTick();
+    void onBenchmarkFinished();
 
 private:
     QTimer* m_timer;
     QList<QVariant> m_stepHistory;
     int m_currentStep;
     int m_timerInterval;
+    QFutureWatcher<QStringList>* m_benchmarkWatcher; // The benchmark running in the background, if any
 
     QVector<int> m_randomData; // Shared by Sorting and Trees
 
     BST m_bst;
     AVL m_avl;
+    BTree m_btree;
+    RedBlackTree m_rbTree;
+    Treap m_treap;
+    SplayTree m_splay;
     Graph m_graph;
     Maze m_maze;
 
+    int m_mazeWidth;
+    int m_mazeHeight;
+
     bool m_graphGenerated;
+    bool m_layoutRunning; // Timer ticks stream force layout frames instead of replaying m_stepHistory
+    bool m_mazeStreaming; // Timer ticks add rows to an Eller maze, likewise
 
     void generateRandomData();
+    void advanceLayout();
+    void advanceMazeStream();
+    QVector<int> skewedLookups(const QVector<int>& keys, unsigned seed) const;
 };
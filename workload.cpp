@@ -0,0 +1,65 @@
+#include "workload.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+QVector<int> Workload::uniform(int count, int keyCount, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> keyDist(0, keyCount - 1);
+
+    QVector<int> keys(count);
+    for (int& key : keys) key = keyDist(rng);
+    return keys;
+}
+
+QVector<int> Workload::zipfian(int count, int keyCount, double skew, unsigned seed)
+{
+    std::mt19937 rng(seed);
+
+    // 1. Cumulative weights of the ranks, sampled by binary search
+    QVector<double> cumulative(keyCount);
+    double total = 0.0;
+    for (int rank = 0; rank < keyCount; ++rank) {
+        total += 1.0 / std::pow(rank + 1.0, skew);
+        cumulative[rank] = total;
+    }
+
+    // 2. Random rank -> key mapping
+    QVector<int> keyOfRank(keyCount);
+    std::iota(keyOfRank.begin(), keyOfRank.end(), 0);
+    std::shuffle(keyOfRank.begin(), keyOfRank.end(), rng);
+
+    std::uniform_real_distribution<double> pick(0.0, total);
+    QVector<int> keys(count);
+    for (int& key : keys) {
+        int rank = std::upper_bound(cumulative.begin(), cumulative.end(), pick(rng)) - cumulative.begin();
+        key = keyOfRank[qMin(rank, keyCount - 1)];
+    }
+    return keys;
+}
+
+QVector<int> Workload::sequential(int count, int keyCount)
+{
+    QVector<int> keys(count);
+    for (int i = 0; i < count; ++i) keys[i] = i % keyCount;
+    return keys;
+}
+
+QVector<int> Workload::workingSet(int count, int keyCount, int setSize, int phaseLength, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> keyDist(0, keyCount - 1);
+    std::uniform_int_distribution<int> slotDist(0, setSize - 1);
+
+    QVector<int> workingKeys(setSize);
+    QVector<int> keys(count);
+    for (int i = 0; i < count; ++i) {
+        if (i % phaseLength == 0) {
+            for (int& key : workingKeys) key = keyDist(rng);
+        }
+        keys[i] = workingKeys[slotDist(rng)];
+    }
+    return keys;
+}
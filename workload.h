@@ -0,0 +1,23 @@
+#pragma once
+
+#include <QVector>
+
+// Access-pattern generators for lookup benchmarks. Every generator returns
+// 'count' keys drawn from [0, keyCount), so the tree under test should hold
+// exactly those keys. Seeded generators are reproducible.
+namespace Workload
+{
+// Every key equally likely
+QVector<int> uniform(int count, int keyCount, unsigned seed);
+
+// Key of popularity rank r is drawn with probability proportional to 1 / (r + 1)^skew.
+// Ranks are shuffled onto keys, so the hot keys are scattered across the tree.
+QVector<int> zipfian(int count, int keyCount, double skew, unsigned seed);
+
+// 0, 1, 2, ... wrapping around at keyCount
+QVector<int> sequential(int count, int keyCount);
+
+// Uniform accesses inside a small random set of keys that is replaced
+// every 'phaseLength' accesses
+QVector<int> workingSet(int count, int keyCount, int setSize, int phaseLength, unsigned seed);
+}